@@ -14,6 +14,7 @@
 %ignore vrv::Toolkit::GetShowBoundingBoxes( );
 %ignore vrv::Toolkit::GetCString( );
 %ignore vrv::Toolkit::GetLogString( );
+%ignore vrv::Toolkit::LoadData( std::string && );
 %ignore vrv::Toolkit::ParseOptions( const std::string & );
 %ignore vrv::Toolkit::ResetLogBuffer( );
 %ignore vrv::Toolkit::SetShowBoundingBoxes( bool );
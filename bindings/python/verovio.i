@@ -14,12 +14,15 @@
 %ignore vrv::Toolkit::GetShowBoundingBoxes( );
 %ignore vrv::Toolkit::GetCString( );
 %ignore vrv::Toolkit::GetLogString( );
+%ignore vrv::Toolkit::LoadData( std::string && );
 %ignore vrv::Toolkit::ResetLogBuffer( );
 %ignore vrv::Toolkit::SetShowBoundingBoxes( bool );
 %ignore vrv::Toolkit::SetCString( const std::string & );
 
 %module(package="verovio") verovio
 %include "std_string.i"
+%include "std_vector.i"
+%template(StringVector) std::vector<std::string>;
 %include "../../include/vrv/toolkit.h"
 
 %{
@@ -0,0 +1,64 @@
+# This script it expected to be run from ./bindings/python
+import argparse
+import json
+import sys
+import time
+
+# Add path for toolkit built in-place
+sys.path.append('.')
+
+benchmarkOptions = {
+    'breaks': 'none',
+    'footer': 'none',
+    'header': 'none'
+}
+
+
+def generate_measure(count, staves):
+    """Generate an MEI file with a single unmeasured measure with staves of count eighth notes on the same grid"""
+    staffDefs = ''.join(f'<staffDef n="{n}" lines="5" clef.shape="G" clef.line="2" />' for n in range(1, staves + 1))
+    elements = []
+    for n in range(1, staves + 1):
+        notes = ''.join(f'<note dur="8" pname="{"cdefgab"[(i + n) % 7]}" oct="4" />' for i in range(count))
+        elements.append(f'<staff n="{n}"><layer n="1">{notes}</layer></staff>')
+
+    return ('<?xml version="1.0" encoding="UTF-8"?>'
+            '<mei xmlns="http://www.music-encoding.org/ns/mei" meiversion="4.0.1"><music><body><mdiv><score>'
+            f'<scoreDef><staffGrp>{staffDefs}</staffGrp></scoreDef>'
+            '<section><measure n="1" metcon="false">'
+            + ''.join(elements) +
+            '</measure></section></score></mdiv></body></music></mei>')
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Load and render a measure with many alignments shared by several staves and report the time '
+        'for each step')
+    parser.add_argument('--count', type=int, default=2000, help='the number of notes in each staff')
+    parser.add_argument('--staves', type=int, default=2, help='the number of staves on the same time grid')
+    parser.add_argument('--save', default='', help='only save the generated MEI file to the path given')
+    args = parser.parse_args()
+
+    data = generate_measure(args.count, args.staves)
+    if len(args.save) > 0:
+        with open(args.save, 'w') as f:
+            f.write(data)
+        sys.exit()
+
+    import verovio
+
+    tk = verovio.toolkit(False)
+    print(f'Verovio {tk.getVersion()}')
+
+    tk.setResourcePath('../../data')
+    tk.setOptions(json.dumps(benchmarkOptions))
+    verovio.enableLog(False)
+
+    start = time.perf_counter()
+    tk.loadData(data)
+    loaded = time.perf_counter()
+    tk.renderToSVG(1)
+    rendered = time.perf_counter()
+
+    print(f'{args.staves} x {args.count} notes loaded in {loaded - start:.2f}s '
+          f'and rendered in {rendered - loaded:.2f}s')
@@ -0,0 +1,67 @@
+# This script it expected to be run from ./bindings/python
+import argparse
+import json
+import random
+import sys
+import time
+
+# Add path for toolkit built in-place
+sys.path.append('.')
+
+benchmarkOptions = {
+    'breaks': 'auto',
+    'footer': 'none',
+    'header': 'none'
+}
+
+
+def generate_score(count):
+    """Generate an MEI file with two staves and count measures of quarter notes"""
+    random.seed(1)
+    measures = []
+    for n in range(1, count + 1):
+        staves = []
+        for staff, oct in [(1, 4), (2, 3)]:
+            notes = ''.join(f'<note dur="4" pname="{random.choice("cdefgab")}" oct="{oct}" />' for _ in range(4))
+            staves.append(f'<staff n="{staff}"><layer n="1">{notes}</layer></staff>')
+        measures.append(f'<measure n="{n}">{"".join(staves)}</measure>')
+
+    return ('<?xml version="1.0" encoding="UTF-8"?>'
+            '<mei xmlns="http://www.music-encoding.org/ns/mei" meiversion="4.0.1"><music><body><mdiv><score>'
+            '<scoreDef meter.count="4" meter.unit="4"><staffGrp>'
+            '<staffDef n="1" lines="5" clef.shape="G" clef.line="2" />'
+            '<staffDef n="2" lines="5" clef.shape="F" clef.line="4" />'
+            '</staffGrp></scoreDef><section>'
+            + ''.join(measures) +
+            '</section></score></mdiv></body></music></mei>')
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Load and cast off scores with an increasing number of measures and report the time for each')
+    parser.add_argument('counts', nargs='*', type=int, default=[100, 300, 1000, 3000, 10000],
+                        help='the numbers of measures (default: 100 300 1000 3000 10000)')
+    parser.add_argument('--save', default='', help='only save the generated MEI files with the prefix given')
+    args = parser.parse_args()
+
+    if len(args.save) > 0:
+        for count in args.counts:
+            with open(f'{args.save}{count}.mei', 'w') as f:
+                f.write(generate_score(count))
+        sys.exit()
+
+    import verovio
+
+    tk = verovio.toolkit(False)
+    print(f'Verovio {tk.getVersion()}')
+
+    tk.setResourcePath('../../data')
+    tk.setOptions(json.dumps(benchmarkOptions))
+    verovio.enableLog(False)
+
+    for count in args.counts:
+        data = generate_score(count)
+        start = time.perf_counter()
+        tk.loadData(data)
+        elapsed = time.perf_counter() - start
+        print(f'{count} measures loaded and cast off in {elapsed:.2f}s ({tk.getPageCount()} pages)')
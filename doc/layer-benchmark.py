@@ -0,0 +1,78 @@
+# This script it expected to be run from ./bindings/python
+import argparse
+import json
+import random
+import sys
+import time
+
+# Add path for toolkit built in-place
+sys.path.append('.')
+
+benchmarkOptions = {
+    'breaks': 'none',
+    'footer': 'none',
+    'header': 'none'
+}
+
+
+def generate_layer(count):
+    """Generate an MEI file with a single unmeasured layer (e.g., a cadenza) with count elements"""
+    random.seed(1)
+    elements = []
+    i = 0
+    while i < count:
+        pname = random.choice('cdefgab')
+        oct = random.choice([4, 5])
+        r = random.random()
+        if r < 0.25 and i + 4 <= count:
+            notes = ''.join(f'<note dur="8" pname="{random.choice("cdefgab")}" oct="{oct}" />' for _ in range(4))
+            elements.append(f'<beam>{notes}</beam>')
+            i += 4
+            continue
+        if r < 0.35:
+            elements.append('<rest dur="8" />')
+        elif r < 0.45:
+            elements.append(f'<chord dur="4"><note pname="{pname}" oct="4" /><note pname="{pname}" oct="5" /></chord>')
+        elif r < 0.55:
+            elements.append(f'<note dur="16" pname="{pname}" oct="{oct}" accid="s" />')
+        else:
+            elements.append(f'<note dur="8" pname="{pname}" oct="{oct}" />')
+        i += 1
+
+    return ('<?xml version="1.0" encoding="UTF-8"?>'
+            '<mei xmlns="http://www.music-encoding.org/ns/mei" meiversion="4.0.1"><music><body><mdiv><score>'
+            '<scoreDef><staffGrp><staffDef n="1" lines="5" clef.shape="G" clef.line="2" /></staffGrp></scoreDef>'
+            '<section><measure n="1" metcon="false"><staff n="1"><layer n="1">'
+            + ''.join(elements) +
+            '</layer></staff></measure></section></score></mdiv></body></music></mei>')
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Load and render a single layer with many elements and report the time for each step')
+    parser.add_argument('--count', type=int, default=10000, help='the number of elements in the layer')
+    parser.add_argument('--save', default='', help='only save the generated MEI file to the path given')
+    args = parser.parse_args()
+
+    data = generate_layer(args.count)
+    if len(args.save) > 0:
+        with open(args.save, 'w') as f:
+            f.write(data)
+        sys.exit()
+
+    import verovio
+
+    tk = verovio.toolkit(False)
+    print(f'Verovio {tk.getVersion()}')
+
+    tk.setResourcePath('../../data')
+    tk.setOptions(json.dumps(benchmarkOptions))
+    verovio.enableLog(False)
+
+    start = time.perf_counter()
+    tk.loadData(data)
+    loaded = time.perf_counter()
+    tk.renderToSVG(1)
+    rendered = time.perf_counter()
+
+    print(f'{args.count} elements loaded in {loaded - start:.2f}s and rendered in {rendered - loaded:.2f}s')
@@ -0,0 +1,71 @@
+# This script it expected to be run from ./bindings/python
+import argparse
+import json
+import random
+import sys
+import time
+
+# Add path for toolkit built in-place
+sys.path.append('.')
+
+benchmarkOptions = {
+    'breaks': 'none',
+    'footer': 'none',
+    'header': 'none'
+}
+
+
+def generate_score(count):
+    """Generate an MEI file with two staves and count measures of notes with several attributes each"""
+    random.seed(1)
+    measures = []
+    for n in range(1, count + 1):
+        staves = []
+        for staff, oct in [(1, 4), (2, 3)]:
+            notes = []
+            for i in range(4):
+                pname = random.choice('cdefgab')
+                accid = random.choice(['', ' accid.ges="s"', ' accid.ges="f"'])
+                notes.append(f'<note xml:id="n{n}s{staff}n{i}" dur="4" pname="{pname}" oct="{oct}" '
+                             f'stem.dir="{random.choice(["up", "down"])}"{accid} />')
+            staves.append(f'<staff n="{staff}"><layer n="1">{"".join(notes)}</layer></staff>')
+        measures.append(f'<measure xml:id="m{n}" n="{n}" right="single">{"".join(staves)}</measure>')
+
+    return ('<?xml version="1.0" encoding="UTF-8"?>'
+            '<mei xmlns="http://www.music-encoding.org/ns/mei" meiversion="4.0.1"><music><body><mdiv><score>'
+            '<scoreDef meter.count="4" meter.unit="4"><staffGrp>'
+            '<staffDef n="1" lines="5" clef.shape="G" clef.line="2" />'
+            '<staffDef n="2" lines="5" clef.shape="F" clef.line="4" />'
+            '</staffGrp></scoreDef><section>'
+            + ''.join(measures) +
+            '</section></score></mdiv></body></music></mei>')
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Load MEI scores with an increasing number of measures without casting them off and report the '
+                    'throughput for each')
+    parser.add_argument('counts', nargs='*', type=int, default=[1000, 3000, 10000],
+                        help='the numbers of measures (default: 1000 3000 10000)')
+    parser.add_argument('--repeat', type=int, default=3, help='the number of loads of each score (default: 3)')
+    args = parser.parse_args()
+
+    import verovio
+
+    tk = verovio.toolkit(False)
+    print(f'Verovio {tk.getVersion()}')
+
+    tk.setResourcePath('../../data')
+    tk.setOptions(json.dumps(benchmarkOptions))
+    verovio.enableLog(False)
+
+    for count in args.counts:
+        data = generate_score(count)
+        size = len(data.encode('utf-8')) / (1024 * 1024)
+        best = None
+        for _ in range(args.repeat):
+            start = time.perf_counter()
+            tk.loadData(data)
+            elapsed = time.perf_counter() - start
+            best = elapsed if best is None else min(best, elapsed)
+        print(f'{count} measures ({size:.1f} MB) loaded in {best:.2f}s ({size / best:.1f} MB/s)')
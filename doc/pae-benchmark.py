@@ -0,0 +1,62 @@
+# This script it expected to be run from ./bindings/python
+import argparse
+import glob
+import json
+import os
+import sys
+import time
+
+# Add path for toolkit built in-place
+sys.path.append('.')
+import verovio
+
+benchmarkOptions = {
+    'adjustPageHeight': True,
+    'breaks': 'auto',
+    'footer': 'none',
+    'header': 'none',
+    'inputFrom': 'pae',
+    'pageWidth': 2100,
+    'scale': 40
+}
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description='Import and render Plaine & Easie incipits and report the number of incipits per second')
+    parser.add_argument('incipits', nargs='?', default='',
+                        help='a file with one incipit per line (default: the .pae files in ../../doc/tests/pae)')
+    parser.add_argument('--count', type=int, default=100000, help='the number of incipits to render')
+    parser.add_argument('--threads', type=int, default=0,
+                        help='render the incipits as a batch of records on the number of threads given')
+    args = parser.parse_args()
+
+    tk = verovio.toolkit(False)
+    print(f'Verovio {tk.getVersion()}')
+
+    tk.setResourcePath('../../data')
+    tk.setOptions(json.dumps(benchmarkOptions))
+    verovio.enableLog(False)
+
+    incipits = []
+    if len(args.incipits) > 0:
+        with open(args.incipits) as f:
+            incipits = [line.strip('\n') for line in f if line.strip()]
+    else:
+        for filename in sorted(glob.glob(os.path.join('../../doc/tests/pae', '*', '*.pae'))):
+            with open(filename) as f:
+                incipits.append(f.read())
+
+    if not incipits:
+        sys.exit('No incipit to render')
+
+    start = time.perf_counter()
+    if args.threads > 0:
+        tk.setOptions(json.dumps({'renderThreads': args.threads}))
+        tk.renderRecordsToSVG([incipits[i % len(incipits)] for i in range(args.count)])
+    else:
+        for i in range(args.count):
+            tk.loadData(incipits[i % len(incipits)])
+            tk.renderToSVG(1)
+    elapsed = time.perf_counter() - start
+
+    print(f'{args.count} incipits in {elapsed:.2f}s ({args.count / elapsed:.0f} incipits/s)')
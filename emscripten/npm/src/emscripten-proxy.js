@@ -36,6 +36,9 @@ function getToolkitFunction(VerovioModule, method) {
     // char *getElementsAtTime(Toolkit *ic, int time)
     mapping.getElementsAtTime = VerovioModule.cwrap('vrvToolkit_getElementsAtTime', 'string', ['number', 'number']);
 
+    // char *getTimeEventsBetween(Toolkit *ic, int fromTime, int toTime)
+    mapping.getTimeEventsBetween = VerovioModule.cwrap('vrvToolkit_getTimeEventsBetween', 'string', ['number', 'number', 'number']);
+
     // char *vrvToolkit_getExpansionIdsForElement(Toolkit *tk, const char *xmlId);
     mapping.getExpansionIdsForElement = VerovioModule.cwrap('vrvToolkit_getExpansionIdsForElement', 'string', ['number', 'string']);
 
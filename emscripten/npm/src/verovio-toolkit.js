@@ -44,6 +44,10 @@ export class VerovioToolkit {
         return JSON.parse(this.proxy.getElementsAtTime(this.ptr, millisec));
     }
 
+    getTimeEventsBetween(fromMillisec, toMillisec) {
+        return JSON.parse(this.proxy.getTimeEventsBetween(this.ptr, fromMillisec, toMillisec));
+    }
+
     getExpansionIdsForElement(xmlId) {
         return JSON.parse(this.proxy.getExpansionIdsForElement(this.ptr, xmlId));
     }
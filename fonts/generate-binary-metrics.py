@@ -0,0 +1,99 @@
+#! /usr/bin/env python3
+
+"""
+Generate the binary font metrics files loaded by Verovio in place of the XML bounding box files.
+For each XML file given as argument, a .bin file with the same basename is written next to it.
+
+The layout of the binary file is (little-endian, 4-byte aligned):
+  * header: magic "VRVM", uint32 version, int32 units-per-em, uint32 glyph count,
+    uint32 anchor count, uint32 size of the string table, uint32 size of the XML file,
+    uint32 FNV-1a hash of the XML file
+  * glyphs: uint32 code, uint32 code string offset, uint32 name offset (0xFFFFFFFF if none),
+    float x, y, w, h, h-a-x, uint32 first anchor index, uint32 anchor count
+  * anchors: uint32 name offset, float x, y
+  * string table: NUL-terminated UTF-8 strings
+
+It must be kept in sync with Resources::ParseBinaryFont. The size and hash of the XML file
+let Verovio ignore a binary file that is out of date and load the XML file instead.
+"""
+
+import os
+import struct
+import sys
+import xml.etree.ElementTree as ET
+
+MAGIC = b"VRVM"
+VERSION = 2
+NO_STRING = 0xFFFFFFFF
+
+
+class StringTable:
+    def __init__(self):
+        self.data = bytearray()
+        self.offsets = {}
+
+    def add(self, value: str) -> int:
+        if value is None:
+            return NO_STRING
+        if value not in self.offsets:
+            self.offsets[value] = len(self.data)
+            self.data += value.encode("utf-8") + b"\0"
+        return self.offsets[value]
+
+
+def fnv1a(data: bytes) -> int:
+    value = 2166136261
+    for byte in data:
+        value = ((value ^ byte) * 16777619) & 0xFFFFFFFF
+    return value
+
+
+def get_float(element: ET.Element, name: str) -> float:
+    return float(element.get(name, "0"))
+
+
+def convert(xml_file: str, bin_file: str):
+    """Convert the XML bounding box file to its binary version."""
+    with open(xml_file, "rb") as file:
+        xml_data = file.read()
+    root = ET.fromstring(xml_data)
+    if root.tag != "bounding-boxes":
+        print(f"Skipping {xml_file} (not a bounding box file)")
+        return
+    units_per_em = int(root.get("units-per-em", "0"))
+
+    strings = StringTable()
+    glyph_records = bytearray()
+    anchor_records = bytearray()
+    glyph_count = 0
+    anchor_count = 0
+
+    for glyph in root.findall("g"):
+        code_str = glyph.get("c")
+        if code_str is None:
+            continue
+        anchors = [anchor for anchor in glyph.findall("a") if anchor.get("n") is not None]
+        glyph_records += struct.pack("<III5fII", int(code_str, 16), strings.add(code_str),
+                                     strings.add(glyph.get("n")), get_float(glyph, "x"), get_float(glyph, "y"),
+                                     get_float(glyph, "w"), get_float(glyph, "h"), get_float(glyph, "h-a-x"),
+                                     anchor_count, len(anchors))
+        for anchor in anchors:
+            anchor_records += struct.pack("<I2f", strings.add(anchor.get("n")),
+                                          get_float(anchor, "x"), get_float(anchor, "y"))
+        glyph_count += 1
+        anchor_count += len(anchors)
+
+    header = MAGIC + struct.pack("<IiIIIII", VERSION, units_per_em, glyph_count, anchor_count, len(strings.data),
+                                 len(xml_data), fnv1a(xml_data))
+    print(f"Writing {bin_file}")
+    with open(bin_file, "wb") as file:
+        file.write(header + glyph_records + anchor_records + strings.data)
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print("Usage: generate-binary-metrics.py file.xml [file.xml ...]")
+        sys.exit(1)
+
+    for xml_file in sys.argv[1:]:
+        convert(xml_file, os.path.splitext(xml_file)[0] + ".bin")
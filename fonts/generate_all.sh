@@ -21,4 +21,7 @@ python3 extract-bounding-boxes.py Petaluma.svg json/petaluma_metadata.json ../da
 echo "Generating Leland files ..."
 python3 extract-bounding-boxes.py Leland.svg json/leland_metadata.json ../data/Leland.xml
 
+echo "Generating binary metrics files ..."
+python3 generate-binary-metrics.py ../data/*.xml ../data/text/*.xml
+
 echo "Done!"
@@ -380,7 +380,7 @@ protected:
      * Filter the flat list and keep only Note and Chords elements.
      * This also initializes the m_beamElementCoords vector
      */
-    void FilterList(ListOfConstObjects &childList) const override;
+    void FilterList(ArrayOfConstObjects &childList) const override;
 
     /**
      * See LayerElement::SetElementShortening
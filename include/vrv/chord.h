@@ -281,7 +281,7 @@ protected:
     /**
      * Filter the flat list and keep only Note elements.
      */
-    void FilterList(ListOfConstObjects &childList) const override;
+    void FilterList(ArrayOfConstObjects &childList) const override;
 
 public:
     //
@@ -14,6 +14,7 @@
 #include "options.h"
 #include "resources.h"
 #include "scoredef.h"
+#include "timemap.h"
 
 namespace smf {
 class MidiFile;
@@ -25,6 +26,7 @@ class CastOffPagesParams;
 class DocSelection;
 class FontInfo;
 class Glyph;
+class InstrDef;
 class Pages;
 class Page;
 class Score;
@@ -181,14 +183,15 @@ public:
     /**
      * @name Get the height or width for a text glyph taking into account the grace size.
      * The staff size must already be taken into account in the FontInfo
+     * The resources of the document are used if none are given, with the text font style selected in them.
      */
     ///@{
-    int GetTextGlyphHeight(wchar_t code, FontInfo *font, bool graceSize) const;
-    int GetTextGlyphWidth(wchar_t code, FontInfo *font, bool graceSize) const;
-    int GetTextGlyphAdvX(wchar_t code, FontInfo *font, bool graceSize) const;
-    int GetTextGlyphDescender(wchar_t code, FontInfo *font, bool graceSize) const;
-    int GetTextLineHeight(FontInfo *font, bool graceSize) const;
-    int GetTextXHeight(FontInfo *font, bool graceSize) const;
+    int GetTextGlyphHeight(wchar_t code, FontInfo *font, bool graceSize, const Resources *resources = NULL) const;
+    int GetTextGlyphWidth(wchar_t code, FontInfo *font, bool graceSize, const Resources *resources = NULL) const;
+    int GetTextGlyphAdvX(wchar_t code, FontInfo *font, bool graceSize, const Resources *resources = NULL) const;
+    int GetTextGlyphDescender(wchar_t code, FontInfo *font, bool graceSize, const Resources *resources = NULL) const;
+    int GetTextLineHeight(FontInfo *font, bool graceSize, const Resources *resources = NULL) const;
+    int GetTextXHeight(FontInfo *font, bool graceSize, const Resources *resources = NULL) const;
     ///@}
 
     /**
@@ -201,6 +204,16 @@ public:
     FontInfo *GetFingeringFont(int staffSize);
     ///@}
 
+    /**
+     * @name Set the size of a font given by the caller and return it.
+     * Used by views drawing with fonts of their own, so pages can be drawn concurrently.
+     */
+    ///@{
+    FontInfo *GetDrawingSmuflFont(FontInfo *font, int staffSize, bool graceSize) const;
+    FontInfo *GetDrawingLyricFont(FontInfo *font, int staffSize) const;
+    FontInfo *GetFingeringFont(FontInfo *font, int staffSize) const;
+    ///@}
+
     /**
      * @name Getters for the object margins (left and right).
      * The margins are given in x * MEI UNIT
@@ -234,9 +247,15 @@ public:
      */
     bool HasTimemap() const;
 
+    /**
+     * Return the time index built when calculating the timemap.
+     */
+    const TimeIndex &GetTimeIndex() const { return m_timeIndex; }
+
     /**
      * Export the document to a MIDI file.
      * Run trough all the layers and fill the midi file content.
+     * The tracks are generated on the number of threads given by the midiThreads option.
      */
     void ExportMIDI(smf::MidiFile *midiFile);
 
@@ -302,6 +321,26 @@ public:
      */
     void CastOffDocBase(bool useSb, bool usePb, bool smart = false);
 
+    /**
+     * Casts off the pages of the document again, keeping its systems.
+     * The systems are gathered back into a single page that is laid out vertically before being cast off.
+     * Can be called only if Doc::CanRedoPageCastOff returns true.
+     */
+    void RedoPageCastOffDoc();
+
+    /**
+     * Return true if the pages can be cast off again without casting off the systems.
+     * This is the case when the document was cast off by Doc::CastOffDocBase with no leftover system
+     * being merged into the previous one (and no selection).
+     */
+    bool CanRedoPageCastOff() const;
+
+    /**
+     * Casts off the pages from the single page with all the systems.
+     * Called from Doc::CastOffDocBase and Doc::RedoPageCastOffDoc
+     */
+    void CastOffPagesBase(Page *castOffSinglePage, System *leftoverSystem);
+
     /**
      * Casts off the running elements (headers and footer)
      * Called from Doc::CastOffDoc
@@ -384,14 +423,18 @@ public:
     /**
      * Return the width adjusted to the content of the current drawing page.
      * This includes the appropriate left and right margins.
+     * The page can also be given, in which case the drawing page parameters have to be valid for it.
      */
-    int GetAdjustedDrawingPageWidth() const;
+    int GetAdjustedDrawingPageWidth() const { return this->GetAdjustedDrawingPageWidth(m_drawingPage); }
+    int GetAdjustedDrawingPageWidth(const Page *page) const;
 
     /**
      * Return the height adjusted to the content of the current drawing page.
      * This includes the appropriate top and bottom margin (using top as bottom).
+     * The page can also be given, in which case the drawing page parameters have to be valid for it.
      */
-    int GetAdjustedDrawingPageHeight() const;
+    int GetAdjustedDrawingPageHeight() const { return this->GetAdjustedDrawingPageHeight(m_drawingPage); }
+    int GetAdjustedDrawingPageHeight(const Page *page) const;
 
     /**
      * Setter for markup flag. See corresponding enum in vrvdef.h
@@ -471,6 +514,16 @@ private:
      */
     int CalcMusicFontSize();
 
+    /**
+     * @name Helpers for the MIDI export
+     * Return the instrDef of a staffDef (or of its staffGrp) and add the instrument, name, key and meter signature
+     * events of a staffDef to the track.
+     */
+    ///@{
+    InstrDef *GetMIDIInstrDef(StaffDef *staffDef);
+    void GenerateMIDIStaffDef(smf::MidiFile *midiFile, StaffDef *staffDef, int midiTrack, int midiChannel);
+    ///@}
+
 public:
     Page *m_selectionPreceeding;
     Page *m_selectionFollowing;
@@ -541,6 +594,12 @@ private:
      */
     Resources m_resources;
 
+    /**
+     * The index of the objects by ID, maintained by the objects themselves.
+     * See Object::SetIDIndex
+     */
+    IDIndex m_objectsByID;
+
     /**
      * @name Holds a pointer to the current score/scoreDef.
      * Set by Doc::GetCurrentScoreDef or explicitly through Doc::SetCurrentScoreDef
@@ -554,6 +613,12 @@ private:
      */
     bool m_isCastOff;
 
+    /**
+     * A flag indicating if the pages can be cast off again without casting off the systems.
+     * Set by Doc::CastOffPagesBase.
+     */
+    bool m_isPageCastOffRedoable;
+
     /*
      * The following values are set in the Doc::SetDrawingPage.
      * They are all current values to be used when drawing a page in a View and
@@ -605,6 +670,12 @@ private:
      */
     double m_timemapTempo;
 
+    /**
+     * The index of the real time intervals of the measures, notes and rests.
+     * Built by CalculateTimemap
+     */
+    TimeIndex m_timeIndex;
+
     /**
      * A flag to indicate whereas the document contains analytical markup to be converted.
      * This is currently limited to @fermata and @tie. Other attribute markup (@accid and @artic)
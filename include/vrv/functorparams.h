@@ -101,13 +101,13 @@ public:
 //----------------------------------------------------------------------------
 
 /**
- * member 0: the ArrayOfObjects
+ * member 0: the ArrayOfConstObjects
  **/
 
 class AddLayerElementToFlatListParams : public FunctorParams {
 public:
-    AddLayerElementToFlatListParams(ListOfConstObjects *flatList) { m_flatList = flatList; }
-    ListOfConstObjects *m_flatList;
+    AddLayerElementToFlatListParams(ArrayOfConstObjects *flatList) { m_flatList = flatList; }
+    ArrayOfConstObjects *m_flatList;
 };
 
 //----------------------------------------------------------------------------
@@ -2340,13 +2340,15 @@ public:
 
 /**
  * member 0: ArrayOfInterfaceIDPairs holds the interface / id pairs to match
- * member 1: bool* fillList for indicating whether the pairs have to be stacked or not
+ * member 1: MapOfIDIndices holds the position of the tuples in member 0 by id
+ * member 2: bool* fillList for indicating whether the pairs have to be stacked or not
  **/
 
 class PreparePlistParams : public FunctorParams {
 public:
     PreparePlistParams() { m_fillList = true; }
     ArrayOfPlistInterfaceIDTuples m_interfaceIDTuples;
+    MapOfIDIndices m_interfaceIDIndices;
     bool m_fillList;
 };
 
@@ -2412,13 +2414,13 @@ public:
 //----------------------------------------------------------------------------
 
 /**
- * member 0: interface list that holds the current elements to match
+ * member 0: interface map that holds the current elements to match by @startid
  **/
 
 class PrepareTimePointingParams : public FunctorParams {
 public:
     PrepareTimePointingParams() {}
-    ListOfPointingInterClassIdPairs m_timePointingInterfaces;
+    MapOfPointingInterClassIdPairs m_timePointingInterfaces;
 };
 
 //----------------------------------------------------------------------------
@@ -2426,14 +2428,14 @@ public:
 //----------------------------------------------------------------------------
 
 /**
- * member 0: interface list that holds the current elements to match
+ * member 0: interface map that holds the current elements to match by @startid and @endid
  * member 1: bool fillList for indicating whether the elements have to be stacked or not
  **/
 
 class PrepareTimeSpanningParams : public FunctorParams {
 public:
     PrepareTimeSpanningParams() { m_fillList = true; }
-    ListOfSpanningInterOwnerPairs m_timeSpanningInterfaces;
+    MapOfSpanningInterOwnerPairs m_timeSpanningInterfaces;
     bool m_fillList;
 };
 
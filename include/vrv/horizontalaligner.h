@@ -424,6 +424,8 @@ protected:
     /**
      * Search if an alignment of the type is already there at the time.
      * If not, return in idx the position where it needs to be inserted (-1 if it is the end)
+     * The alignments are expected to be ordered by time and by type, which is the case when they are added
+     * with the index returned here.
      */
     ///@{
     Alignment *SearchAlignmentAtTime(double time, AlignmentType type, int &idx);
@@ -550,7 +552,12 @@ public:
     int JustifyX(FunctorParams *functorParams) override;
 
 private:
-    //
+    /**
+     * Return the index of the right barline alignment.
+     * It is looked for from the end since only the caution scoreDef and the measure end alignments follow it.
+     */
+    int GetRightBarLineIdx() const;
+
 public:
     //
 private:
@@ -72,6 +72,13 @@ public:
     // read
     virtual bool Import(std::string const &data) { return true; }
 
+    /**
+     * Import data that the input is allowed to modify, e.g., for parsing XML in place.
+     * The content of the string is undefined afterwards.
+     * By default the data is passed to Input::Import.
+     */
+    virtual bool ImportInPlace(std::string &data) { return this->Import(data); }
+
     /**
      * Getter for layoutInformation flag that is set to true during import
      * if layout information is found (and not to be ignored).
@@ -10,6 +10,9 @@
 
 #include <sstream>
 #include <stack>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 
 //----------------------------------------------------------------------------
 
@@ -187,8 +190,19 @@ public:
 
     /**
      * The main method for exporting the file to MEI.
+     * Without a stream, the output is written to the stringstream member (see MEIOutput::GetOutput)
+     * The elements are written to the stream as soon as they are complete (e.g., measure by measure)
      */
+    ///@{
     bool Export();
+    bool Export(std::ostream &stream);
+    ///@}
+
+    /**
+     * Check that the output can be exported with the options and the filter set.
+     * This is done by Export, and can be done beforehand for not opening an output that cannot be written.
+     */
+    bool CanExport() const;
 
     /**
      * The main method for writing objects.
@@ -292,6 +306,19 @@ private:
     void WriteStackedObjectsEnd();
     ///@}
 
+    /**
+     * @name Methods for streaming the xml nodes to the output stream
+     * StreamNode writes a complete node, preceded by the start tag of its ancestors if not written yet,
+     * and removes it from the xml document. StreamChildren writes and removes the children of a node, up to
+     * a given child (or all of them), and closes the ancestors that are complete
+     */
+    ///@{
+    bool IsStreamContainer(pugi::xml_node node) const;
+    void StreamNode(pugi::xml_node node);
+    void StreamStartTag(pugi::xml_node node);
+    void StreamChildren(pugi::xml_node node, pugi::xml_node until = pugi::xml_node());
+    ///@}
+
     /**
      * Scoredef manipulation
      */
@@ -539,6 +566,12 @@ public:
 private:
     std::ostringstream m_streamStringOutput;
     int m_indent;
+    /** The stream to which the export is written, with the indentation and the formatting flags */
+    std::ostream *m_stream;
+    std::string m_outputIndent;
+    unsigned int m_outputFlags;
+    /** The ancestors which start tag has been written to the stream, with their end tag */
+    std::vector<std::pair<pugi::xml_node, std::string>> m_streamedNodes;
     bool m_scoreBasedMEI;
     /** A flag indicating that we want to produce MEI basic */
     bool m_basic;
@@ -583,12 +616,19 @@ private:
  * Under development.
  */
 class MEIInput : public Input {
+private:
+    /**
+     * A pointer to a method reading a child element, used for dispatching the children by element name
+     */
+    typedef bool (MEIInput::*ChildReader)(Object *parent, pugi::xml_node element);
+
 public:
     // constructors and destructors
     MEIInput(Doc *doc);
     virtual ~MEIInput();
 
     bool Import(const std::string &mei) override;
+    bool ImportInPlace(std::string &mei) override;
 
 private:
     bool ReadDoc(pugi::xml_node root);
@@ -829,7 +869,7 @@ private:
     /**
      * Returns true if the element is name is an editorial element (e.g., "app", "supplied", etc.)
      */
-    bool IsEditorialElementName(std::string elementName);
+    bool IsEditorialElementName(std::string_view elementName);
 
     /**
      * Normalize attributes of xmlElement, removing white spaces if necessary
@@ -929,9 +969,18 @@ private:
     //----------------//
 
     /**
-     * A static array for storing the implemented editorial elements
+     * A static set for storing the implemented editorial elements
      */
-    static const std::vector<std::string> s_editorialElementNames;
+    static const std::unordered_set<std::string_view> s_editorialElementNames;
+
+    /**
+     * Static maps from element names to the method reading them, for the children of the <layer> and the <measure>
+     * Elements requiring a specific treatment (e.g., XML comments) are not in the maps
+     */
+    ///@{
+    static const std::unordered_map<std::string_view, ChildReader> s_layerChildReaders;
+    static const std::unordered_map<std::string_view, ChildReader> s_measureChildReaders;
+    ///@}
 };
 
 } // namespace vrv
@@ -181,6 +181,7 @@ public:
 
 #ifndef NO_MUSICXML_SUPPORT
     bool Import(const std::string &musicxml) override;
+    bool ImportInPlace(std::string &musicxml) override;
 
 private:
     /*
@@ -262,6 +263,11 @@ private:
      */
     void AddMeasure(Section *section, Measure *measure, int i);
 
+    /*
+     * Return the first measure added to the section with the given number, NULL if there is none.
+     */
+    Measure *GetSectionMeasure(const std::string &measureNum) const;
+
     /*
      * Add a Layer element to the layer or to the LayerElement at the top of m_elementStack.
      */
@@ -327,6 +333,14 @@ private:
     std::string GetContentOfChild(const pugi::xml_node node, const std::string &child) const;
     ///@}
 
+    /*
+     * @name Helper method returning the compiled query for an XPath expression.
+     * The expression is compiled the first time it is used and cached for the rest of the import.
+     */
+    ///@{
+    const pugi::xpath_query &GetXPathQuery(const std::string &expression) const;
+    ///@}
+
     /*
      * @name Methods for opening and closing ties and slurs.
      * Opened ties and slurs are stacked together with musicxml::OpenTie
@@ -509,6 +523,8 @@ private:
     std::vector<std::pair<Trill *, musicxml::OpenSpanner>> m_trillStack;
     /* The stack of endings to be inserted at the end of XML import */
     std::vector<std::pair<std::vector<Measure *>, musicxml::EndingInfo>> m_endingStack;
+    /* The numbers of the measures in m_endingStack */
+    std::set<std::string> m_endingMeasureNumbers;
     /* The stack of open dashes (direction-type) containing *ControlElement, OpenDashes */
     std::vector<std::pair<ControlElement *, musicxml::OpenDashes>> m_openDashesStack;
     /* The stacks for ControlElements */
@@ -532,6 +548,16 @@ private:
     std::map<Measure *, int> m_measureCounts;
     /* measure rests */
     std::map<int, int> m_multiRests;
+    /* the measures added to the section and the first one for each measure number */
+    int m_sectionMeasureCount = 0;
+    std::unordered_map<std::string, Measure *> m_sectionMeasures;
+    /* the ending starts for which a stop or a discontinue follows in the document */
+    std::set<pugi::xml_node> m_closedEndingStarts;
+    /* state of the part and measure being read */
+    bool m_isFirstPart = false;
+    bool m_hasKeyInMeasure = false;
+    /* compiled XPath queries by expression */
+    mutable std::unordered_map<std::string, pugi::xpath_query> m_xpathQueries;
 
 #endif // NO_MUSICXML_SUPPORT
 };
@@ -129,7 +129,7 @@ protected:
     /**
      * Filter the flat list and keep only StaffDef elements.
      */
-    void FilterList(ListOfConstObjects &childList) const override;
+    void FilterList(ArrayOfConstObjects &childList) const override;
 
 private:
     /**
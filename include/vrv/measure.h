@@ -269,6 +269,26 @@ public:
      */
     double GetRealTimeOffsetMilliseconds(int repeat) const;
 
+    /**
+     * Return the score time offset in quarter notes for the repeat (1-based).
+     */
+    double GetScoreTimeOffset(int repeat) const;
+
+    /**
+     * Return the tempo of the measure as used for the real time offsets.
+     */
+    double GetCurrentTempo() const { return m_currentTempo; }
+
+    /**
+     * Return the number of times the measure is played (i.e., the number of real time offsets).
+     */
+    int GetRealTimeRepeatCount() const { return (int)m_realTimeOffsetMilliseconds.size(); }
+
+    /**
+     * Return the real time duration in millisecond as used for checking if the measure encloses a time.
+     */
+    double GetRealTimeDurationMilliseconds() const;
+
     /**
      * Return vector with tie endpoints for ties that start and end in current measure
      */
@@ -545,11 +565,12 @@ protected:
     int m_cachedXRel;
 
     /**
-     * @name Cached values of overflow and width for caching the horizontal layout
+     * @name Cached values of overflow, width and justifiable width for caching the horizontal layout
      */
     ///@{
     int m_cachedOverflow;
     int m_cachedWidth;
+    int m_cachedJustifiableWidth;
     ///@}
 
 private:
@@ -8,10 +8,13 @@
 #ifndef __VRV_OBJECT_H__
 #define __VRV_OBJECT_H__
 
+#include <bitset>
 #include <cstdlib>
 #include <functional>
 #include <iterator>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <random>
 #include <string>
 
@@ -46,6 +49,33 @@ class Zone;
 #define UNLIMITED_DEPTH -10000
 #define FORWARD true
 #define BACKWARD false
+#define MAX_FUSED_FUNCTORS 32
+
+//----------------------------------------------------------------------------
+// ObjectIterator
+//----------------------------------------------------------------------------
+
+/**
+ * This class stores the state of the iteration over the children of an object with Object::GetFirst
+ */
+struct ObjectIterator {
+    ArrayOfObjects::const_iterator m_end;
+    ArrayOfObjects::const_iterator m_current;
+    ClassId m_elementType;
+};
+
+//----------------------------------------------------------------------------
+// IDIndex
+//----------------------------------------------------------------------------
+
+/**
+ * This class stores the objects of a document by ID, with the mutex guarding them since objects can be created or
+ * moved while laying out concurrently. Each document has its own, for documents not to wait on each other.
+ */
+struct IDIndex {
+    MapOfIDObjects m_objects;
+    std::mutex m_mutex;
+};
 
 //----------------------------------------------------------------------------
 // Object
@@ -111,16 +141,10 @@ public:
      * @name Methods for registering a MEI att class and for registering interfaces regrouping MEI att classes.
      */
     ///@{
-    void RegisterAttClass(AttClassId attClassId) { m_attClasses.push_back(attClassId); }
-    bool HasAttClass(AttClassId attClassId) const
-    {
-        return std::find(m_attClasses.begin(), m_attClasses.end(), attClassId) != m_attClasses.end();
-    }
+    void RegisterAttClass(AttClassId attClassId) { m_attClasses.set(attClassId); }
+    bool HasAttClass(AttClassId attClassId) const { return m_attClasses.test(attClassId); }
     void RegisterInterface(std::vector<AttClassId> *attClasses, InterfaceId interfaceId);
-    bool HasInterface(InterfaceId interfaceId) const
-    {
-        return std::find(m_interfaces.begin(), m_interfaces.end(), interfaceId) != m_interfaces.end();
-    }
+    bool HasInterface(InterfaceId interfaceId) const { return m_interfaces.test(interfaceId); }
     ///@}
 
     /**
@@ -236,19 +260,19 @@ public:
     virtual void CloneReset();
 
     const std::string &GetID() const { return m_id; }
-    void SetID(const std::string &id) { m_id = id; }
+    void SetID(const std::string &id);
     void SwapID(Object *other);
     void ResetID();
 
     /**
      * Methods for setting / getting comments
      */
-    std::string GetComment() const { return m_comment; }
-    void SetComment(std::string comment) { m_comment = comment; }
-    bool HasComment() { return !m_comment.empty(); }
-    std::string GetClosingComment() const { return m_closingComment; }
-    void SetClosingComment(std::string endComment) { m_closingComment = endComment; }
-    bool HasClosingComment() { return !m_closingComment.empty(); }
+    std::string GetComment() const { return (m_comments) ? m_comments->first : ""; }
+    void SetComment(std::string comment);
+    bool HasComment() { return (m_comments && !m_comments->first.empty()); }
+    std::string GetClosingComment() const { return (m_comments) ? m_comments->second : ""; }
+    void SetClosingComment(std::string endComment);
+    bool HasClosingComment() { return (m_comments && !m_comments->second.empty()); }
 
     /**
      * @name Children count, with or without a ClassId.
@@ -286,6 +310,12 @@ public:
      */
     ArrayOfObjects &GetChildrenForModification() { return m_children; }
 
+    /**
+     * Update the cached position of the children owned by the object, starting from the index given.
+     * This method has to be called after the children have been modified through GetChildrenForModification
+     */
+    void UpdateChildIndices(int startIdx = 0);
+
     /**
      * Fill an array of pairs with all attributes and their values.
      * Return the number of attributes found.
@@ -344,12 +374,26 @@ public:
      */
     void SetParent(Object *parent);
 
+    /**
+     * Set the parent of a temporary Object created for drawing.
+     * The Object is not registered in the ID index of the parent since it is not part of the tree.
+     */
+    void SetTemporaryParent(Object *parent);
+
     /**
      * Reset the parent of the Object.
      * The current parent is not expected to be NULL.
      */
     void ResetParent() { m_parent = NULL; }
 
+    /**
+     * Set the ID index in which the object and the children it owns are registered.
+     * The index is owned by the Doc which sets it on itself, and it is then set on objects when attached to it.
+     * Objects stay registered when detached or relinquished, for moving them within the document not to update the
+     * index, and are removed from it when deleted or set in the index of another document.
+     */
+    void SetIDIndex(IDIndex *idIndex);
+
     /**
      * Base method for checking if a child can be added.
      * The method has to be overridden.
@@ -413,7 +457,8 @@ public:
 
     /**
      * Look for a descendant with the specified id (returns NULL if not found)
-     * This method is a wrapper for the Object::FindByID functor.
+     * This method looks up the ID index of the document when available and is otherwise
+     * a wrapper for the Object::FindByID functor.
      */
     ///@{
     Object *FindDescendantByID(const std::string &id, int deepness = UNLIMITED_DEPTH, bool direction = FORWARD);
@@ -561,7 +606,7 @@ public:
      * Fill the list of all the children LayerElement.
      * This is used for navigating in a Layer (See Layer::GetPrevious and Layer::GetNext).
      */
-    void FillFlatList(ListOfConstObjects &list) const;
+    void FillFlatList(ArrayOfConstObjects &list) const;
 
     /**
      * Check if the content was modified or not
@@ -636,6 +681,16 @@ public:
         int deepness = UNLIMITED_DEPTH, bool direction = FORWARD, bool skipFirst = false) const;
     ///@}
 
+    /**
+     * Process several functors in a single traversal of the tree.
+     * Each tuple holds the functor, its parameters and the end functor (or NULL).
+     * On each object the functors are called in the order of the array, and each of them processes the children
+     * depending on its own return code. The result is the same as processing them one after the other only if none
+     * of them depends on the changes made by the others. At most MAX_FUSED_FUNCTORS can be processed together.
+     */
+    void Process(const ArrayOfFunctorTuples &functors, Filters *filters = NULL, int deepness = UNLIMITED_DEPTH,
+        bool direction = FORWARD);
+
     //----------------//
     // Static methods //
     //----------------//
@@ -644,6 +699,21 @@ public:
 
     static std::string GenerateRandID();
 
+    /**
+     * Generate a seed for the ID generator of another thread.
+     * The seed is never 0 since it would make SeedID seed the generator randomly.
+     */
+    static unsigned int GenerateRandSeed();
+
+    /**
+     * @name Get and set the state of the ID generator of the thread.
+     * Used for restoring it after seeding it temporarily.
+     */
+    ///@{
+    static std::mt19937 GetIDGenerator() { return s_randomGenerator; }
+    static void SetIDGenerator(const std::mt19937 &generator) { s_randomGenerator = generator; }
+    ///@}
+
     static bool sortByUlx(Object *a, Object *b);
 
     /**
@@ -1541,6 +1611,18 @@ private:
      */
     void GenerateID();
 
+    /**
+     * Remove the object from the ID index it is registered in.
+     * The caller must hold the mutex of the index.
+     */
+    void EraseFromIDIndex();
+
+    /**
+     * Check if an object from the ID index is a descendant reached by the functor.
+     * Detached or relinquished objects, objects with a temporary parent or hidden by the functor are not.
+     */
+    bool IsIndexedDescendant(const Object *object, Functor *functor) const;
+
     /**
      * Initialisation method taking the class id and a id prefix argument.
      */
@@ -1553,6 +1635,9 @@ private:
     void UpdateDocumentScore(bool direction);
     bool SkipChildren(Functor *functor) const;
     bool FiltersApply(const Filters *filters, Object *object) const;
+    /** The bits of the mask give the functors that still process the object */
+    void ProcessFused(const ArrayOfFunctorTuples &functors, unsigned int functorMask, Filters *filters, int deepness,
+        bool direction);
     ///@}
 
 public:
@@ -1576,6 +1661,17 @@ private:
      */
     Object *m_parent;
 
+    /**
+     * The position of the object in the children of its parent (-1 if none).
+     * It is kept up to date by the methods modifying the children.
+     */
+    int m_childIdx;
+
+    /**
+     * A pointer to the ID index of the document in which the object is registered (NULL if none)
+     */
+    IDIndex *m_idIndex;
+
     /**
      * The class id representing the actual (derived) class
      */
@@ -1586,7 +1682,7 @@ private:
      */
     ///@{
     std::string m_id;
-    std::string m_classIdStr;
+    char m_classIdChar;
     ///@}
 
     /**
@@ -1604,33 +1700,29 @@ private:
     mutable bool m_isModified;
 
     /**
-     * Members used for caching iterator values.
-     * See Object::IterGetFirst, Object::IterGetNext and Object::IterIsNotEnd
-     * Values are set when GetFirst is called (which is mandatory)
+     * Member used for caching iterator values.
+     * See Object::GetFirst and Object::GetNext
+     * Values are set when GetFirst is called (which is mandatory) and allocated only then
      */
-    ///@{
-    mutable ArrayOfObjects::const_iterator m_iteratorEnd, m_iteratorCurrent;
-    mutable ClassId m_iteratorElementType;
-    ///@}
+    mutable std::unique_ptr<ObjectIterator> m_iterator;
 
     /**
-     * A vector for storing the list of AttClassId (MEI att classes) implemented.
+     * A bitset for storing the AttClassId (MEI att classes) implemented.
      */
-    std::vector<AttClassId> m_attClasses;
+    std::bitset<ATT_CLASS_max> m_attClasses;
 
     /**
-     * A vector for storing the list of InterfaceId (group of MEI att classes) implemented.
+     * A bitset for storing the InterfaceId (group of MEI att classes) implemented.
      */
-    std::vector<InterfaceId> m_interfaces;
+    std::bitset<INTERFACE_max> m_interfaces;
 
     /**
-     * String for storing a comments attached to the object when printing an MEI element.
-     * m_comment is to be printed immediately before the element
-     * m_closingComment is to be printed before the closing tag of the element
+     * Strings for storing a comments attached to the object when printing an MEI element.
+     * The first is to be printed immediately before the element
+     * The second is to be printed before the closing tag of the element
+     * Allocated only when a comment is set since most objects have none
      */
-    std::string m_comment;
-    std::string m_closingComment;
-    ///@}
+    std::unique_ptr<std::pair<std::string, std::string>> m_comments;
 
     /**
      * A flag indicating if the Object represents an attribute in the original MEI.
@@ -1714,8 +1806,8 @@ public:
      * Because this is an interface, we need to pass the object - not the best design.
      */
     ///@{
-    const ListOfConstObjects &GetList(const Object *node) const;
-    ListOfObjects GetList(const Object *node);
+    const ArrayOfConstObjects &GetList(const Object *node) const;
+    ArrayOfObjects GetList(const Object *node);
     ///@}
 
     /**
@@ -1732,14 +1824,20 @@ public:
     ///@}
 
 private:
-    mutable ListOfConstObjects m_list;
+    mutable ArrayOfConstObjects m_list;
+
+    /**
+     * The index of each object in the list.
+     * It is rebuilt with the list and gives constant time index and neighbour lookups.
+     */
+    mutable std::unordered_map<const Object *, int> m_listIndices;
 
 protected:
     /**
      * Filter the list for a specific class.
      * For example, keep only notes in Beam
      */
-    virtual void FilterList(ListOfConstObjects &childList) const {};
+    virtual void FilterList(ArrayOfConstObjects &childList) const {};
 
 public:
     /**
@@ -1780,7 +1878,7 @@ protected:
      * Filter the list for a specific class.
      * For example, keep only notes in Beam
      */
-    void FilterList(ListOfConstObjects &childList) const override;
+    void FilterList(ArrayOfConstObjects &childList) const override;
 
 private:
     //
@@ -76,6 +76,12 @@ enum option_SYSTEMDIVIDER { SYSTEMDIVIDER_none = 0, SYSTEMDIVIDER_auto, SYSTEMDI
 
 enum class OptionsCategory { None, Base, General, Layout, Margins, Midi, Selectors, Full };
 
+/**
+ * The stages of the rendering pipeline, in processing order.
+ * Changing an option invalidates its stage and all the following ones.
+ */
+enum class OptionStage { DataPreparation, HorizontalLayout, SystemCastOff, VerticalLayout, PageCastOff, Output };
+
 /**
  * This class is a base class of each styling parameter
  */
@@ -86,6 +92,7 @@ public:
     {
         m_shortOption = 0;
         m_isCmdOnly = false;
+        m_stage = OptionStage::DataPreparation;
     }
     virtual ~Option() {}
     virtual void CopyTo(Option *option) = 0;
@@ -111,6 +118,9 @@ public:
     char GetShortOption() const { return m_shortOption; }
     bool IsCmdOnly() const { return m_isCmdOnly; }
 
+    void SetStage(OptionStage stage) { m_stage = stage; }
+    OptionStage GetStage() const { return m_stage; }
+
     /**
      * Return a JSON object for the option
      */
@@ -142,6 +152,8 @@ private:
     char m_shortOption;
     /* a flag indicating that the option is available only on the command line */
     bool m_isCmdOnly;
+    /* the first stage of the pipeline to redo when the option changes */
+    OptionStage m_stage;
 };
 
 //----------------------------------------------------------------------------
@@ -522,6 +534,12 @@ public:
     void SetCategory(OptionsCategory category) { m_category = category; }
     OptionsCategory GetCategory() const { return m_category; }
 
+    /**
+     * The default stage of the options registered in the group
+     */
+    void SetStage(OptionStage stage) { m_stage = stage; }
+    OptionStage GetStage() const { return m_stage; }
+
     void AddOption(Option *option) { m_options.push_back(option); }
 
     const std::vector<Option *> *GetOptions() const { return &m_options; }
@@ -533,6 +551,7 @@ protected:
     std::string m_label;
     std::vector<Option *> m_options;
     OptionsCategory m_category = OptionsCategory::None;
+    OptionStage m_stage = OptionStage::DataPreparation;
 };
 
 //----------------------------------------------------------------------------
@@ -562,6 +581,12 @@ public:
     // post processing of parameters
     void Sync();
 
+    /**
+     * Return the first stage invalidated by the options with a value different from the one in the other options.
+     * Return OptionStage::Output if all the values are the same.
+     */
+    OptionStage GetInvalidatedStage(const Options &options) const;
+
 private:
     void Register(Option *option, const std::string &key, OptionGrp *grp);
 
@@ -574,6 +599,7 @@ public:
     // These options are only given for documentation - except for m_scale
     // They are ordered by short option alphabetical order
     OptionBool m_standardOutput;
+    OptionString m_records;
     OptionBool m_help;
     OptionBool m_allPages;
     OptionString m_inputFrom;
@@ -605,6 +631,7 @@ public:
     OptionBool m_humType;
     OptionBool m_justifyVertically;
     OptionBool m_landscape;
+    OptionInt m_layoutThreads;
     OptionBool m_ligatureAsBracket;
     OptionBool m_mensuralToMeasure;
     OptionDbl m_minLastJustification;
@@ -625,6 +652,7 @@ public:
     OptionIntMap m_pedalStyle;
     OptionBool m_preserveAnalyticalMarkup;
     OptionBool m_removeIds;
+    OptionInt m_renderThreads;
     OptionBool m_showRuntime;
     OptionBool m_shrinkToFit;
     OptionBool m_staccatoCenter;
@@ -796,6 +824,7 @@ public:
 
     OptionBool m_midiNoCue;
     OptionDbl m_midiTempoAdjustment;
+    OptionInt m_midiThreads;
 
     /**
      * Deprecated options
@@ -93,6 +93,12 @@ public:
      */
     void LayOut(bool force = false);
 
+    /**
+     * Set the page as drawing page of the header and footer and restore their vertical positions for it.
+     * This is necessary because they can be shared between pages and are laid out with each of them.
+     */
+    void SetRunningElementsDrawingPage();
+
     /**
      * Do the layout for a transcription page (with layout information).
      * This only calculates positioning or layer element parts using provided layout of parents.
@@ -196,6 +202,18 @@ public:
     int CastOffPagesEnd(FunctorParams *functorParams) override;
 
 private:
+    /**
+     * Run a measure-local pass of the horizontal layout with the functor method (and the end one, if any).
+     * The params are created by createParams with the functors and the staff numbers of the current scoreDef.
+     * With one thread, the page is processed once. Otherwise, chunks of the measures in scoresAndMeasures are
+     * processed concurrently, each with its own functors and params, score by score and with the score set as
+     * current in the doc.
+     */
+    void ProcessMeasuresHorizontally(const ListOfObjects &scoresAndMeasures, int threadCount,
+        int (Object::*method)(FunctorParams *), int (Object::*endMethod)(FunctorParams *),
+        const std::function<std::unique_ptr<FunctorParams>(Functor *, Functor *, const std::vector<int> &)>
+            &createParams);
+
     /**
      * Adjust the horizontal postition of the syl processing verse by verse
      */
@@ -267,6 +285,15 @@ private:
      * the force parameter is set.
      */
     bool m_layoutDone;
+
+    /**
+     * @name The vertical positions of the header and of the footer for the page
+     * Set in Page::LayOut and restored in Page::SetRunningElementsDrawingPage
+     */
+    ///@{
+    std::vector<int> m_drawingHeaderYRels;
+    std::vector<int> m_drawingFooterYRels;
+    ///@}
 };
 
 } // namespace vrv
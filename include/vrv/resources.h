@@ -8,8 +8,19 @@
 #ifndef __VRV_RESOURCES_H__
 #define __VRV_RESOURCES_H__
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//----------------------------------------------------------------------------
+
 #include "glyph.h"
 
+//----------------------------------------------------------------------------
+
+#include "pugixml.hpp"
+
 namespace vrv {
 
 //----------------------------------------------------------------------------
@@ -26,7 +37,19 @@ public:
     using StyleAttributes = std::pair<data_FONTWEIGHT, data_FONTSTYLE>;
     using GlyphTable = std::unordered_map<wchar_t, Glyph>;
     using GlyphNameTable = std::unordered_map<std::string, wchar_t>;
-    using GlyphTextMap = std::map<StyleAttributes, GlyphTable>;
+
+    /**
+     * A font loaded from its XML file.
+     * Loaded fonts are kept in a process-wide registry and shared read-only by all instances.
+     */
+    struct LoadedFont {
+        GlyphTable m_glyphTable;
+        GlyphNameTable m_glyphNameTable;
+    };
+    using LoadedFontPtr = std::shared_ptr<const LoadedFont>;
+    /** A list of fonts where the last one has precedence */
+    using FontStack = std::vector<LoadedFontPtr>;
+    using GlyphTextMap = std::map<StyleAttributes, FontStack>;
 
     /**
      * @name Constructors, destructors, and other standard methods
@@ -81,21 +104,65 @@ public:
     const Glyph *GetTextGlyph(wchar_t code) const;
     ///@}
 
+    /**
+     * SVG definitions
+     * The XML files are parsed only once and kept in a process-wide cache shared by all instances.
+     * The returned documents must be considered as read-only.
+     */
+    ///@{
+    /** Returns the SVG definitions (<path> and <symbol>) for the glyph */
+    static pugi::xml_node GetGlyphSvgDefs(const Glyph *glyph);
+    /** Returns the woff VerovioText font definition */
+    pugi::xml_node GetWoffSvgDef() const;
+    ///@}
+
 private:
     bool LoadFont(const std::string &fontName);
 
+    /** Add the font on top of the stack, moving it there if already loaded */
+    static void PushFont(FontStack &fontStack, const LoadedFontPtr &font);
+
+    /** Look for a glyph in the font stack, starting with the font that has precedence */
+    static const Glyph *FindGlyph(const FontStack &fontStack, wchar_t code);
+
+    /**
+     * Return the font from the registry, loading it first if necessary.
+     * Return NULL if the file could not be loaded.
+     */
+    static LoadedFontPtr GetRegisteredFont(const std::string &path, const std::string &fontName, bool isTextFont);
+
+    /**
+     * Parse the XML files into a font.
+     */
+    ///@{
+    static bool ParseFont(const std::string &path, const std::string &fontName, LoadedFont &font);
+    static bool ParseTextFont(const std::string &path, const std::string &fontName, LoadedFont &font);
+    ///@}
+
+    /**
+     * Read the binary metrics file generated from the XML file (see fonts/generate-binary-metrics.py).
+     * The file is memory-mapped and read without parsing.
+     * Return false if the file is not available, not valid, or generated from another version of the XML file,
+     * in which case the XML file has to be used.
+     */
+    static bool ParseBinaryFont(const std::string &path, const std::string &fontName, bool isTextFont, LoadedFont &font);
+
+    /**
+     * Hash of the XML file stored in the binary metrics file.
+     */
+    static uint32_t HashMetrics(const char *data, size_t size);
+
+    /** Returns the cached parsed document for the file, loading it first if necessary */
+    static pugi::xml_node LoadSvgDefs(const std::string &filename);
+
 private:
     /** The path to the resources directory (e.g., for the svg/ subdirectory with fonts as XML */
     std::string m_path;
-    /** The loaded SMuFL font */
-    GlyphTable m_fontGlyphTable;
+    /** The loaded SMuFL fonts */
+    FontStack m_fonts;
     /** A text font used for bounding box calculations */
     GlyphTextMap m_textFont;
     mutable StyleAttributes m_currentStyle;
-    /**
-     * A map of glyph name / code
-     */
-    GlyphNameTable m_glyphNameTable;
 
     //----------------//
     // Static members //
@@ -106,6 +173,14 @@ private:
 
     /** The default font style */
     static const StyleAttributes k_defaultStyle;
+
+    /** The cache of parsed SVG definition files */
+    static std::map<std::string, std::unique_ptr<pugi::xml_document>> s_svgDefs;
+    static std::mutex s_svgDefsMutex;
+
+    /** The registry of loaded fonts, shared by all instances */
+    static std::map<std::string, LoadedFontPtr> s_fontRegistry;
+    static std::mutex s_fontRegistryMutex;
 };
 
 } // namespace vrv
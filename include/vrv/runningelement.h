@@ -114,6 +114,15 @@ public:
      */
     bool AdjustRunningElementYPos();
 
+    /**
+     * @name Get and set the vertical positions of the running element and of its content.
+     * Used for restoring them for a page since the running element can be shared between pages.
+     */
+    ///@{
+    std::vector<int> GetDrawingYRels() const;
+    void SetDrawingYRels(const std::vector<int> &drawingYRels);
+    ///@}
+
     /**
      * Set the current page number by looking for a <num label="page">#</num> element.
      */
@@ -158,7 +167,7 @@ protected:
      * Filter the list for a specific class.
      * Keep only the top <rend> and <fig>
      */
-    void FilterList(ListOfConstObjects &childList) const override;
+    void FilterList(ArrayOfConstObjects &childList) const override;
 
 private:
     /**
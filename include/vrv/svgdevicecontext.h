@@ -14,6 +14,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 //----------------------------------------------------------------------------
@@ -271,6 +272,12 @@ private:
 
     pugi::xml_node AppendChild(std::string name);
 
+    /**
+     * Register the <g> node (and its <g> descendants if deep) for retrieving it by id in ResumeGraphic.
+     * Ids are not unique in the SVG (e.g., with HTML5 data-id), so all the nodes for an id are kept.
+     */
+    void RegisterGraphicNode(pugi::xml_node node, bool deep = false);
+
     /**
      * Transform pen properties into stroke attributes
      */
@@ -290,11 +297,11 @@ private:
      */
     bool m_vrvTextFont;
 
-    // we use a std::stringstream because we want to prepend the <defs> which will know only when we reach the end of
+    // we use a buffer because we want to prepend the <defs> which will know only when we reach the end of
     // the page
     // some viewer seem to support to have the <defs> at the end, but some do not (pdf2svg, for example)
-    // for this reason, the full svg is finally written a string from the destructor or when Flush() is called
-    std::ostringstream m_outdata;
+    // for this reason, the full svg is finally written to the buffer when GetStringSVG() is called
+    std::string m_outdata;
 
     bool m_committed; // did we flushed the file?
     int m_originX, m_originY;
@@ -309,6 +316,8 @@ private:
     pugi::xml_node m_pageNode;
     pugi::xml_node m_currentNode;
     std::list<pugi::xml_node> m_svgNodeStack;
+    // the <g> nodes by id (data-id in HTML5) for resuming graphics without searching the document
+    std::unordered_map<std::string, std::vector<pugi::xml_node>> m_graphicNodes;
 
     // output as mm (for pdf generation with a 72 dpi)
     bool m_mmOutput;
@@ -19,6 +19,8 @@ namespace vrv {
 class SystemMilestoneEnd;
 class DeviceContext;
 class Ending;
+class FindSpannedLayerElementsParams;
+class LayerElement;
 class Measure;
 class ScoreDef;
 class Slur;
@@ -120,6 +122,18 @@ public:
     curvature_CURVEDIR GetPreferredCurveDirection(
         const LayerElement *start, const LayerElement *end, const Slur *slur) const;
 
+    /**
+     * @name Build, clear and query the index of the layer elements spanned by slurs.
+     * The index sorts the layer elements of each staff by their left position and is built by Page::LayOutVertically
+     * once the bounding boxes are set. Without index, the query runs the FindSpannedLayerElements functor on the
+     * measure (or on the whole system if NULL).
+     */
+    ///@{
+    void IndexSpannedLayerElements();
+    void ClearSpannedLayerElementIndex();
+    void FindSpannedLayerElements(FindSpannedLayerElementsParams *params, const Measure *measure = NULL) const;
+    ///@}
+
     /**
      * @name Setter and getter of the drawing visible flag
      */
@@ -387,11 +401,40 @@ protected:
     int m_drawingYRel;
 
 private:
+    /**
+     * An entry in the index of spanned layer elements with its content position.
+     * The order is the one of the element in the system, the measure its index in m_indexedMeasures.
+     */
+    struct IndexedLayerElement {
+        int m_left;
+        int m_right;
+        int m_order;
+        int m_measureIdx;
+        const LayerElement *m_element;
+    };
+
     /**
      * The drawing scoreDef at the beginning of the system.
      */
     ScoreDef *m_drawingScoreDef;
 
+    /**
+     * @name The index of spanned layer elements.
+     * The elements are sorted by their left position for each staff @\n, with the maximal width of an element of the
+     * staff for bounding the search. It is used only when m_hasSpannedLayerElementIndex is true.
+     */
+    ///@{
+    bool m_hasSpannedLayerElementIndex;
+    std::map<int, std::vector<IndexedLayerElement>> m_spannedLayerElementIndex;
+    std::map<int, int> m_spannedLayerElementMaxWidths;
+    std::vector<const Measure *> m_indexedMeasures;
+    ///@}
+
+    /**
+     * The classes of the layer elements in the index
+     */
+    static const std::vector<ClassId> s_spannedLayerElementClassIds;
+
     /**
      * A flag indicating if the system is optimized.
      * This does not mean that a staff is hidden, but only that it can be optimized.
@@ -174,6 +174,11 @@ public:
      */
     bool HasStartAndEnd() const { return (m_start && m_end); }
 
+    /**
+     * Return true if the start or the end still has to be matched with the element of the given @xml:id
+     */
+    bool IsWaitingFor(const std::string &id) const;
+
     /**
      * Return the end measure of the TimePointInterface
      */
@@ -15,10 +15,13 @@
 
 //----------------------------------------------------------------------------
 
+#include "vrvdef.h"
+
 namespace vrv {
 
 class Object;
 class GenerateTimemapParams;
+class Measure;
 
 //----------------------------------------------------------------------------
 // TimemapEntry
@@ -68,6 +71,13 @@ public:
      */
     void ToJson(std::string &output, bool includetRests, bool includetMeasures);
 
+    /**
+     * Write timemap entries to a JSON string, as in the timemap.
+     * The tempo is written for the first entry with one and then for the entries changing it.
+     */
+    static void EntriesToJson(
+        const std::map<double, TimemapEntry> &entries, std::string &output, bool includeRests, bool includeMeasures);
+
 private:
     //
 public:
@@ -78,6 +88,124 @@ private:
 
 }; // class Timemap
 
+//----------------------------------------------------------------------------
+// TimeIndexMeasure, TimeIndexElement and TimeIndexInterval
+//----------------------------------------------------------------------------
+
+/**
+ * Helper struct to store a measure in the time index with its real time offsets (one per repeat)
+ */
+struct TimeIndexMeasure {
+    std::string id;
+    std::vector<double> offsets;
+    std::vector<double> scoreOffsets;
+    double tempo;
+};
+
+/**
+ * Helper struct to store a note or rest in the time index with its real time onset / offset w.r.t. the measure
+ */
+struct TimeIndexElement {
+    std::string id;
+    std::string chordID;
+    bool isRest;
+    bool isGrace;
+    double onset;
+    double offset;
+    double scoreOnset;
+    double scoreOffset;
+    int measure;
+};
+
+/**
+ * Helper struct to store an interval in the time index.
+ * The max offset is the one of the interval subtree (see TimeIndex).
+ */
+struct TimeIndexInterval {
+    double onset;
+    double offset;
+    double maxOffset;
+    int index;
+    int repeat;
+};
+
+//----------------------------------------------------------------------------
+// TimeIndex
+//----------------------------------------------------------------------------
+
+/**
+ * This class holds an index of the real time intervals of the measures, notes and rests.
+ * It is built when the timemap is calculated, with one interval per repeat of a measure.
+ * The intervals are sorted by onset in flat arrays that are used as implicit binary trees in which each node
+ * also stores the max offset of its subtree. This makes it possible to find the intervals including a given time
+ * or overlapping a time range in O(log n + k).
+ */
+class TimeIndex {
+public:
+    /**
+     * @name Constructors, destructors, and other standard methods
+     */
+    ///@{
+    TimeIndex();
+    virtual ~TimeIndex();
+    ///@}
+
+    /** Resets the time index */
+    void Reset();
+
+    /**
+     * Add a measure with its notes and rests (in document order).
+     * The timemap is expected to be calculated.
+     */
+    void AddMeasure(const Measure *measure, const ListOfObjects &notesOrRests);
+
+    /**
+     * Sort the intervals and build the implicit trees.
+     * To be called once all the measures have been added.
+     */
+    void Build();
+
+    /**
+     * Look for the measure and the notes and rests being played at the given time.
+     * The measure is the first one in document order and the notes and rests are the ones played in it.
+     * Return false if no measure encloses the time.
+     */
+    bool FindElementsAtTime(
+        int millisec, std::string &measureID, std::vector<const TimeIndexElement *> &elements) const;
+
+    /**
+     * Look for the measure, note and rest onsets and offsets between two times (included).
+     * The entries are filled as in the timemap, with their score time and the tempo of the note and rest onsets.
+     */
+    void FindEventsBetween(int fromMillisec, int toMillisec, std::map<double, TimemapEntry> &events) const;
+
+private:
+    /**
+     * Calculate the max offset of the subtree for the interval in the middle of [begin, end)
+     */
+    double CalcMaxOffset(std::vector<TimeIndexInterval> &intervals, int begin, int end);
+
+    /**
+     * Look for the intervals overlapping [from, to] in [begin, end) and add their position to the list.
+     * Both the intervals and the searched range include their bounds, so an interval ending at from or starting at
+     * to is found, as a note ending at a given time is still listed in the timemap at that time.
+     */
+    void FindIntervals(const std::vector<TimeIndexInterval> &intervals, int begin, int end, double from, double to,
+        std::vector<int> &positions) const;
+
+public:
+    //
+private:
+    /** The measures and the elements */
+    std::vector<TimeIndexMeasure> m_measures;
+    std::vector<TimeIndexElement> m_elements;
+
+    /** The intervals of the measures and of the elements, sorted by onset */
+    std::vector<TimeIndexInterval> m_measureIntervals;
+    std::vector<TimeIndexInterval> m_elementIntervals;
+
+}; // class TimeIndex
+
 } // namespace vrv
 
 #endif // __VRV_TIMEMAP_H__
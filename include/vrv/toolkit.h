@@ -8,7 +8,9 @@
 #ifndef __VRV_TOOLKIT_H__
 #define __VRV_TOOLKIT_H__
 
+#include <functional>
 #include <string>
+#include <vector>
 
 //----------------------------------------------------------------------------
 
@@ -21,7 +23,9 @@
 namespace vrv {
 
 class EditorToolkit;
+class Input;
 class RuntimeClock;
+class SvgDeviceContext;
 
 enum FileFormat {
     UNKNOWN = 0,
@@ -164,6 +168,18 @@ public:
      */
     bool LoadData(const std::string &data);
 
+    /**
+     * Load a string data taking ownership of it.
+     *
+     * Same as Toolkit::LoadData(const std::string &) but XML data is parsed in place without being copied.
+     * The string is left empty.
+     * This methods is not available in the JavaScript version of the toolkit.
+     *
+     * @param data A string with the data (e.g., MEI data) to be loaded
+     * @return True if the data was successfully loaded
+     */
+    bool LoadData(std::string &&data);
+
     /**
      * Load a MusicXML compressed file passed as base64 encoded string.
      *
@@ -357,6 +373,35 @@ public:
      */
     std::string RenderToSVG(int pageNo = 1, bool xmlDeclaration = false);
 
+    /**
+     * Render a range of pages to SVG.
+     *
+     * All the pages of the range are laid out first. They are then rendered on the number of threads given
+     * by the renderThreads option, unless they do not all have the same dimensions.
+     * This methods is not available in the JavaScript version of the toolkit.
+     *
+     * @param firstPageNo The first page to render (1-based)
+     * @param lastPageNo The last page to render (1-based, 0 for the last page of the document)
+     * @param xmlDeclaration True for including the xml declaration in the SVG output
+     * @return The SVG pages as strings, in page order (empty if the range is not valid)
+     */
+    std::vector<std::string> RenderPagesToSVG(int firstPageNo = 1, int lastPageNo = 0, bool xmlDeclaration = false);
+
+    /**
+     * Load a list of small inputs (e.g., incipits) and render the first page of each of them to SVG.
+     *
+     * The records are loaded with the input format of the toolkit (or detected for each of them).
+     * Each thread given by the renderThreads option loads and renders the records it takes on a toolkit of its own,
+     * which is reused from one record to the next and kept for the next call, so lists of records can be given in
+     * chunks. Each record is loaded with the options of the toolkit and the document of the toolkit is left unchanged.
+     * This methods is not available in the JavaScript version of the toolkit.
+     *
+     * @param records The inputs to render
+     * @param xmlDeclaration True for including the xml declaration in the SVG output
+     * @return The SVG pages as strings, in record order (empty for the records that could not be loaded)
+     */
+    std::vector<std::string> RenderRecordsToSVG(const std::vector<std::string> &records, bool xmlDeclaration = false);
+
     /**
      * Render a page to SVG and save it to the file.
      *
@@ -528,6 +573,18 @@ public:
      */
     std::string GetElementsAtTime(int millisec);
 
+    /**
+     * Returns the changes (note, rest and measure onsets and offsets) between two times
+     *
+     * The changes are given as the entries of the timemap (see RenderToTimemap), with the rests and measures and with
+     * the repeated measures expanded.
+     *
+     * @param fromMillisec The start time in milliseconds
+     * @param toMillisec The end time in milliseconds (included)
+     * @return A stringified JSON array with the changes
+     */
+    std::string GetTimeEventsBetween(int fromMillisec, int toMillisec);
+
     /**
      * Return the page on which the element is the ID (xml:id) is rendered
      *
@@ -607,9 +664,13 @@ public:
      *
      * This can be called once the rendering option were changed, for example with a new page (sceen) height or a new
      * zoom level.
+     * Only the stages of the layout invalidated by the options changed since the previous layout are redone, unless
+     * resetCache is given. For example, nothing is redone for SVG output options, and only the vertical layout and the
+     * page cast-off are redone for a new page height.
      *
      * @param jsonOptions A stringified JSON object with the action options
-     * resetCache: true or false; true by default;
+     * resetCache: true or false; true for redoing the full layout (e.g., after modifying the document directly), false
+     * for keeping the cached horizontal layout; by default it depends on the options changed;
      */
     void RedoLayout(const std::string &jsonOptions = "");
 
@@ -752,13 +813,41 @@ protected:
     void ResetLogBuffer();
 
 private:
-    bool IsUTF16(const std::string &filename);
-    bool LoadUTF16File(const std::string &filename);
-    bool IsZip(const std::string &filename);
-    bool LoadZipFile(const std::string &filename);
+    /**
+     * Load the data, in place if a buffer owned by the toolkit is given
+     */
+    bool LoadData(const std::string &data, std::string *buffer);
+
+    /**
+     * Import Humdrum data converted from another format into the document.
+     * The data goes through MEI only when MEI XPath queries are given.
+     * Return the input used, or NULL if the import failed.
+     */
+    Input *ImportConvertedHumdrum(const std::string &humdrum);
+
+    /**
+     * Write the MEI element by element, for GetMEI and SaveFile.
+     * The output stream is given by openOutput, which is called only if the MEI can be written with the options.
+     * Return false if nothing could be written
+     */
+    bool WriteMEI(const std::string &jsonOptions, const std::function<std::ostream *()> &openOutput);
+
+    bool IsUTF16(const std::string &data);
+    bool LoadUTF16Data(const std::string &data);
+    bool IsZip(const std::string &data);
     bool LoadZipData(const std::vector<unsigned char> &bytes);
     void GetClassIds(const std::vector<std::string> &classStrings, std::vector<ClassId> &classIds);
 
+    /**
+     * Set the SVG device context options for rendering
+     */
+    void InitSvgDeviceContext(SvgDeviceContext *svg) const;
+
+    /**
+     * Set the dimensions and the scale of the device context for rendering the page (already laid out)
+     */
+    void SetDeviceContextSize(DeviceContext *deviceContext, const Page *page);
+
 public:
     //
 private:
@@ -772,6 +861,13 @@ private:
 
     bool m_skipLayoutOnLoad;
 
+    /**
+     * The option values with which the current layout was done, if m_hasLayoutOptions is true.
+     * They are compared to the current values in RedoLayout for redoing only the invalidated stages.
+     */
+    Options m_layoutOptions;
+    bool m_hasLayoutOptions;
+
     /**
      * The C buffer string.
      */
@@ -779,6 +875,12 @@ private:
 
     EditorToolkit *m_editorToolkit;
 
+    /**
+     * The toolkits used by the threads in RenderRecordsToSVG.
+     * They are kept for their document, view and resources to be reused from one call to the next.
+     */
+    std::vector<Toolkit *> m_recordToolkits;
+
 #ifndef NO_RUNTIME
     /** Measuring runtime */
     RuntimeClock *m_runtimeClock;
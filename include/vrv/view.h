@@ -8,6 +8,7 @@
 #ifndef __VRV_RENDERER_H__
 #define __VRV_RENDERER_H__
 
+#include <mutex>
 #include <optional>
 
 #include "devicecontextbase.h"
@@ -160,6 +161,15 @@ public:
      */
     void SetPage(int pageIdx, bool doLayout = true);
 
+    /**
+     * Set the current page to pageIdx for drawing it concurrently with other pages of the document.
+     * The page has to be laid out already and the drawing page parameters of the document have to be valid for it
+     * since the drawing page of the document is left unchanged (i.e., all the pages must have the same dimensions).
+     * The mutex is locked when drawing the objects shared between the pages, such as the elements spanning over
+     * several systems and the running elements.
+     */
+    void SetConcurrentPage(int pageIdx, std::mutex *sharedDrawingMutex);
+
     /**
      * Method that actually draw the current page.
      * This is the only drawing method that is public and that can be called for drawing.
@@ -588,8 +598,8 @@ private:
     std::wstring IntToTimeSigFigures(unsigned short number);
     std::wstring IntToSmuflFigures(unsigned short number, int offset);
     int NestedTuplets(Object *object);
-    int GetSylYRel(int verseN, Staff *staff);
-    int GetFYRel(F *f, Staff *staff);
+    int GetSylYRel(DeviceContext *dc, int verseN, Staff *staff);
+    int GetFYRel(DeviceContext *dc, F *f, Staff *staff);
     ///@}
 
     /**
@@ -627,6 +637,16 @@ private:
      */
     data_STEMDIRECTION GetMensuralStemDirection(Layer *layer, Note *note, int verticalCenter);
 
+    /**
+     * @name Return the fonts of the view sized for drawing.
+     * The view has its own fonts so pages can be drawn concurrently.
+     */
+    ///@{
+    FontInfo *GetDrawingSmuflFont(int staffSize, bool graceSize);
+    FontInfo *GetDrawingLyricFont(int staffSize);
+    FontInfo *GetFingeringFont(int staffSize);
+    ///@}
+
 public:
     /** Document */
     Doc *m_doc;
@@ -661,6 +681,11 @@ protected:
      */
     SlurHandling m_slurHandling;
 
+    /**
+     * The mutex for drawing the objects shared between pages (NULL when not drawing concurrently)
+     */
+    std::mutex *m_sharedDrawingMutex;
+
     /**
      * The current drawing score def.
      * The is set when starting to draw a page in DrawCurrentPage and then
@@ -668,6 +693,15 @@ protected:
      */
     ScoreDef m_drawingScoreDef;
 
+    /**
+     * @name The fonts returned by the font getters of the view
+     */
+    ///@{
+    FontInfo m_drawingSmuflFont;
+    FontInfo m_drawingLyricFont;
+    FontInfo m_fingeringFont;
+    ///@}
+
 private:
     //----------------//
     // Static members //
@@ -9,7 +9,9 @@
 #define __VRV_H__
 
 #include <cstring>
+#include <functional>
 #include <map>
+#include <mutex>
 #include <stdarg.h>
 #include <stdio.h>
 #include <string>
@@ -43,6 +45,7 @@ void LogWarning(const char *fmt, ...);
  */
 enum consoleLogLevel { CONSOLE_LOG = 0, CONSOLE_INFO, CONSOLE_WARN, CONSOLE_ERROR, CONSOLE_DEBUG };
 extern std::vector<std::string> logBuffer;
+extern std::mutex logMutex;
 bool LogBufferContains(const std::string &s);
 void LogString(std::string message, consoleLogLevel level);
 
@@ -85,6 +88,12 @@ std::string GetFileVersion(int vmaj, int vmin, int vrev);
  */
 std::string GetFilename(std::string fullpath);
 
+/**
+ * Get the size and the last modification time of a file without reading it.
+ * Return false if the file does not exist.
+ */
+bool GetFileInfo(const std::string &filename, size_t &size, time_t &modificationTime);
+
 /**
  * Return the version number (X.X.X)
  */
@@ -123,6 +132,66 @@ void LogElapsedTimeEnd(const char *msg = "unspecified operation");
  */
 bool Check(Object *object);
 
+/**
+ * Run the task for each index in [0, count) on a pool of threadCount threads (including the calling one).
+ * Indices are handed out in increasing order and the function returns once all the tasks are done.
+ * The tasks are run sequentially when threadCount is 1 or when threads are not available (e.g., emscripten).
+ */
+void RunInParallel(int count, int threadCount, const std::function<void(int)> &task);
+
+//----------------------------------------------------------------------------
+// MappedFile
+//----------------------------------------------------------------------------
+
+/**
+ * This class gives a read-only access to the content of a file mapped into memory.
+ * Where memory mapping is not available (Windows), the content is read into a buffer.
+ */
+class MappedFile {
+public:
+    /**
+     * @name Constructors, destructors, and other standard methods
+     */
+    ///@{
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    ///@}
+
+    /**
+     * Map the file into memory.
+     * Return false if the file cannot be opened or is empty.
+     */
+    bool Open(const std::string &filename);
+
+    /**
+     * Unmap the file (also done when destroyed)
+     */
+    void Close();
+
+    /**
+     * @name Getters
+     */
+    ///@{
+    const char *GetData() const { return m_data; }
+    size_t GetSize() const { return m_size; }
+    bool IsOpen() const { return (m_data != NULL); }
+    ///@}
+
+private:
+    //
+public:
+    //
+private:
+    /** The address of the content */
+    char *m_data;
+    /** The size of the content */
+    size_t m_size;
+    /** The buffer when the content cannot be mapped */
+    std::vector<char> m_buffer;
+};
+
 //----------------------------------------------------------------------------
 // Base64 code borrowed
 //----------------------------------------------------------------------------
@@ -14,6 +14,7 @@
 #include <map>
 #include <set>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 //----------------------------------------------------------------------------
@@ -276,7 +277,8 @@ enum InterfaceId {
     INTERFACE_SCOREDEF,
     INTERFACE_TEXT_DIR,
     INTERFACE_TIME_POINT,
-    INTERFACE_TIME_SPANNING
+    INTERFACE_TIME_SPANNING,
+    INTERFACE_max
 };
 
 //----------------------------------------------------------------------------
@@ -291,6 +293,8 @@ class BoundingBox;
 class Comparison;
 class CurveSpannedElement;
 class FloatingPositioner;
+class Functor;
+class FunctorParams;
 class FloatingCurvePositioner;
 class GraceAligner;
 class InterfaceComparison;
@@ -325,11 +329,21 @@ typedef std::vector<std::tuple<Alignment *, Arpeg *, int, bool>> ArrayOfAlignmen
 
 typedef std::vector<BeamElementCoord *> ArrayOfBeamElementCoords;
 
+typedef std::vector<std::tuple<Functor *, FunctorParams *, Functor *>> ArrayOfFunctorTuples;
+
 typedef std::vector<std::pair<int, int>> ArrayOfIntPairs;
 
-typedef std::multimap<std::string, LinkingInterface *> MapOfLinkingInterfaceIDPairs;
+typedef std::unordered_multimap<std::string, LinkingInterface *> MapOfLinkingInterfaceIDPairs;
+
+typedef std::unordered_map<std::string, Note *> MapOfNoteIDPairs;
+
+typedef std::unordered_multimap<std::string, Object *> MapOfIDObjects;
+
+typedef std::unordered_multimap<std::string, size_t> MapOfIDIndices;
 
-typedef std::map<std::string, Note *> MapOfNoteIDPairs;
+typedef std::unordered_multimap<std::string, std::pair<TimePointInterface *, ClassId>> MapOfPointingInterClassIdPairs;
+
+typedef std::unordered_multimap<std::string, std::pair<TimeSpanningInterface *, Object *>> MapOfSpanningInterOwnerPairs;
 
 typedef std::vector<std::tuple<PlistInterface *, std::string, Object *>> ArrayOfPlistInterfaceIDTuples;
 
@@ -337,12 +351,8 @@ typedef std::vector<CurveSpannedElement *> ArrayOfCurveSpannedElements;
 
 typedef std::list<std::pair<Object *, data_MEASUREBEAT>> ListOfObjectBeatPairs;
 
-typedef std::list<std::pair<TimePointInterface *, ClassId>> ListOfPointingInterClassIdPairs;
-
 typedef std::list<std::pair<TimeSpanningInterface *, ClassId>> ListOfSpanningInterClassIdPairs;
 
-typedef std::list<std::pair<TimeSpanningInterface *, Object *>> ListOfSpanningInterOwnerPairs;
-
 typedef std::vector<FloatingPositioner *> ArrayOfFloatingPositioners;
 
 typedef std::vector<FloatingCurvePositioner *> ArrayOfFloatingCurvePositioners;
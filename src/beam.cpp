@@ -1654,12 +1654,12 @@ bool Beam::IsSupportedChild(Object *child)
     return true;
 }
 
-void Beam::FilterList(ListOfConstObjects &childList) const
+void Beam::FilterList(ArrayOfConstObjects &childList) const
 {
     bool firstNoteGrace = false;
     // We want to keep only notes and rests
     // Eventually, we also need to filter out grace notes properly (e.g., with sub-beams)
-    ListOfConstObjects::iterator iter = childList.begin();
+    ArrayOfConstObjects::iterator iter = childList.begin();
 
     const bool isTabBeam = this->IsTabBeam();
 
@@ -2181,7 +2181,7 @@ int Beam::CalcStem(FunctorParams *functorParams)
 
     if (this->IsTabBeam()) return FUNCTOR_CONTINUE;
 
-    const ListOfObjects &beamChildren = this->GetList(this);
+    const ArrayOfObjects &beamChildren = this->GetList(this);
 
     // Should we assert this at the beginning?
     if (beamChildren.empty()) {
@@ -129,8 +129,8 @@ void Chord::CalculateClusters()
 {
     this->ClearClusters();
 
-    const ListOfObjects &childList = this->GetList(this);
-    ListOfObjects::const_iterator iter = childList.begin();
+    const ArrayOfObjects &childList = this->GetList(this);
+    ArrayOfObjects::const_iterator iter = childList.begin();
 
     Note *curNote, *lastNote = vrv_cast<Note *>(*iter);
     assert(lastNote);
@@ -206,17 +206,19 @@ void Chord::AddChild(Object *child)
     // for the drawing order in the SVG output
     if (child->Is({ DOTS, STEM })) {
         children.insert(children.begin(), child);
+        this->UpdateChildIndices();
     }
     else {
         children.push_back(child);
+        this->UpdateChildIndices((int)children.size() - 1);
     }
     Modify();
 }
 
-void Chord::FilterList(ListOfConstObjects &childList) const
+void Chord::FilterList(ArrayOfConstObjects &childList) const
 {
     // Retain only note children of chords
-    ListOfConstObjects::iterator iter = childList.begin();
+    ArrayOfConstObjects::iterator iter = childList.begin();
 
     while (iter != childList.end()) {
         if ((*iter)->Is(NOTE))
@@ -225,7 +227,7 @@ void Chord::FilterList(ListOfConstObjects &childList) const
             iter = childList.erase(iter);
     }
 
-    childList.sort(DiatonicSort());
+    std::stable_sort(childList.begin(), childList.end(), DiatonicSort());
 }
 
 int Chord::PositionInChord(const Note *note) const
@@ -286,11 +288,11 @@ const Note *Chord::GetBottomNote() const
 
 int Chord::GetXMin() const
 {
-    const ListOfConstObjects &childList = this->GetList(this); // make sure it's initialized
+    const ArrayOfConstObjects &childList = this->GetList(this); // make sure it's initialized
     assert(childList.size() > 0);
 
     int x = -VRV_UNSET;
-    ListOfConstObjects::const_iterator iter = childList.begin();
+    ArrayOfConstObjects::const_iterator iter = childList.begin();
     while (iter != childList.end()) {
         if ((*iter)->GetDrawingX() < x) x = (*iter)->GetDrawingX();
         ++iter;
@@ -300,11 +302,11 @@ int Chord::GetXMin() const
 
 int Chord::GetXMax() const
 {
-    const ListOfConstObjects &childList = this->GetList(this); // make sure it's initialized
+    const ArrayOfConstObjects &childList = this->GetList(this); // make sure it's initialized
     assert(childList.size() > 0);
 
     int x = VRV_UNSET;
-    ListOfConstObjects::const_iterator iter = childList.begin();
+    ArrayOfConstObjects::const_iterator iter = childList.begin();
     while (iter != childList.end()) {
         if ((*iter)->GetDrawingX() > x) x = (*iter)->GetDrawingX();
         ++iter;
@@ -379,7 +381,7 @@ Point Chord::GetStemDownNW(const Doc *doc, int staffSize, bool isCueSize) const
 
 data_STEMDIRECTION Chord::CalcStemDirection(int verticalCenter) const
 {
-    const ListOfConstObjects &childList = this->GetList(this);
+    const ArrayOfConstObjects &childList = this->GetList(this);
     ListOfConstObjects topNotes, bottomNotes;
 
     // split notes into two vectors - notes above vertical center and below
@@ -441,7 +443,7 @@ bool Chord::IsVisible() const
     }
 
     // if the chord doesn't have it, see if all the children are invisible
-    const ListOfConstObjects &notes = this->GetList(this);
+    const ArrayOfConstObjects &notes = this->GetList(this);
 
     for (auto &iter : notes) {
         const Note *note = vrv_cast<const Note *>(iter);
@@ -473,7 +475,7 @@ bool Chord::HasAdjacentNotesInStaff(const Staff *staff) const
 
 bool Chord::HasNoteWithDots() const
 {
-    const ListOfConstObjects &notes = this->GetList(this);
+    const ArrayOfConstObjects &notes = this->GetList(this);
 
     return std::any_of(notes.cbegin(), notes.cend(), [](const Object *object) {
         const Note *note = vrv_cast<const Note *>(object);
@@ -495,7 +497,7 @@ int Chord::AdjustOverlappingLayers(const Doc *doc, const std::vector<LayerElemen
             otherElementLocations.insert(note->GetDrawingLoc());
         }
     }
-    const ListOfObjects &notes = this->GetList(this);
+    const ArrayOfObjects &notes = this->GetList(this);
     // get current chord positions
     std::set<int> chordElementLocations;
     for (const auto iter : notes) {
@@ -553,7 +555,7 @@ int Chord::AdjustOverlappingLayers(const Doc *doc, const std::vector<LayerElemen
 
 std::list<const Note *> Chord::GetAdjacentNotesList(const Staff *staff, int loc) const
 {
-    const ListOfConstObjects &notes = this->GetList(this);
+    const ArrayOfConstObjects &notes = this->GetList(this);
 
     std::list<const Note *> adjacentNotes;
     for (const Object *obj : notes) {
@@ -781,7 +783,7 @@ int Chord::CalcChordNoteHeads(FunctorParams *functorParams)
 
 MapOfNoteLocs Chord::CalcNoteLocations(NotePredicate predicate) const
 {
-    const ListOfConstObjects &notes = this->GetList(this);
+    const ArrayOfConstObjects &notes = this->GetList(this);
 
     MapOfNoteLocs noteLocations;
     for (const Object *obj : notes) {
@@ -882,8 +884,8 @@ int Chord::PrepareLayerElementParts(FunctorParams *functorParams)
     this->CalculateClusters();
 
     // Also set the drawing stem object (or NULL) to all child notes
-    const ListOfObjects &childList = this->GetList(this);
-    for (ListOfObjects::const_iterator it = childList.begin(); it != childList.end(); ++it) {
+    const ArrayOfObjects &childList = this->GetList(this);
+    for (ArrayOfObjects::const_iterator it = childList.begin(); it != childList.end(); ++it) {
         assert((*it)->Is(NOTE));
         Note *note = vrv_cast<Note *>(*it);
         assert(note);
@@ -1030,7 +1032,7 @@ int Chord::GenerateMIDI(FunctorParams *functorParams)
     // Handle grace chords
     if (this->IsGraceNote()) {
         std::set<int> pitches;
-        const ListOfObjects &notes = this->GetList(this);
+        const ArrayOfObjects &notes = this->GetList(this);
         for (Object *obj : notes) {
             Note *note = vrv_cast<Note *>(obj);
             assert(note);
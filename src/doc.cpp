@@ -70,6 +70,11 @@
 
 namespace vrv {
 
+//----------------------------------------------------------------------------
+// Static members
+//----------------------------------------------------------------------------
+
+
 //----------------------------------------------------------------------------
 // Doc
 //----------------------------------------------------------------------------
@@ -83,12 +88,21 @@ Doc::Doc() : Object(DOC, "doc-")
     m_selectionFollowing = NULL;
 
     this->Reset();
+
+    this->SetIDIndex(&m_objectsByID);
 }
 
 Doc::~Doc()
 {
     this->ClearSelectionPages();
 
+    // Objects still registered (e.g., detached ones) must not refer to the index anymore
+    MapOfIDObjects idIndex;
+    idIndex.swap(m_objectsByID.m_objects);
+    for (auto &entry : idIndex) {
+        entry.second->SetIDIndex(NULL);
+    }
+
     delete m_options;
 }
 
@@ -121,9 +135,11 @@ void Doc::Reset()
     m_currentScoreDefDone = false;
     m_dataPreparationDone = false;
     m_timemapTempo = 0.0;
+    m_timeIndex.Reset();
     m_markup = MARKUP_DEFAULT;
     m_isMensuralMusicOnly = false;
     m_isCastOff = false;
+    m_isPageCastOffRedoable = false;
 
     m_facsimile = NULL;
 
@@ -277,6 +293,7 @@ bool Doc::HasTimemap() const
 void Doc::CalculateTimemap()
 {
     m_timemapTempo = 0.0;
+    m_timeIndex.Reset();
 
     // This happens if the document was never cast off (breaks none option in the toolkit)
     if (!m_drawingPage && this->GetPageCount() == 1) {
@@ -313,6 +330,20 @@ void Doc::CalculateTimemap()
     Functor initTimemapTies(&Object::InitTimemapTies);
     this->Process(&initTimemapTies, NULL, NULL, NULL, UNLIMITED_DEPTH, BACKWARD);
 
+    // Finally build the time index with the measures and their notes and rests
+    ListOfObjects measures;
+    ClassIdComparison matchMeasure(MEASURE);
+    this->FindAllDescendantsByComparison(&measures, &matchMeasure);
+    for (Object *object : measures) {
+        Measure *measure = vrv_cast<Measure *>(object);
+        assert(measure);
+        ListOfObjects notesOrRests;
+        ClassIdsComparison matchNoteOrRest({ NOTE, REST });
+        measure->FindAllDescendantsByComparison(&notesOrRests, &matchNoteOrRest);
+        m_timeIndex.AddMeasure(measure, notesOrRests);
+    }
+    m_timeIndex.Build();
+
     m_timemapTempo = m_options->m_midiTempoAdjustment.GetValue();
 }
 
@@ -355,33 +386,40 @@ void Doc::ExportMIDI(smf::MidiFile *midiFile)
     // For this, we use a array of AttNIntegerComparison that looks for each object if it is of the type
     // and with @n specified
 
-    IntTree_t::iterator staves;
-    IntTree_t::iterator layers;
+    // Each staff/layer is processed measure by measure (and scoreDef by scoreDef) instead of through the whole
+    // document - this also keeps the current score of the document unchanged and the processing thread safe
+    ListOfObjects midiObjects;
+    ClassIdsComparison midiObjectComparison({ MEASURE, SCOREDEF });
+    Functor findAllByComparison(&Object::FindAllByComparison);
+    FindAllByComparisonParams findAllByComparisonParams(&midiObjectComparison, &midiObjects);
+    findAllByComparisonParams.m_continueDepthSearchForMatches = false;
+    this->Process(&findAllByComparison, &findAllByComparisonParams);
 
-    // Process notes and chords, rests, spaces layer by layer
+    // First set the MIDI track and channel of each staff
     // track 0 (included by default) is reserved for meta messages common to all tracks
+    struct MIDIStaff {
+        StaffDef *m_staffDef;
+        int m_staffN;
+        int m_midiTrack;
+        int m_midiChannel;
+        int m_transSemi;
+        std::vector<int> m_layerNs;
+    };
+    std::vector<MIDIStaff> midiStaves;
     int midiChannel = 0;
     int midiTrack = 1;
-    Filters filters;
-    for (staves = initProcessingListsParams.m_layerTree.child.begin();
-         staves != initProcessingListsParams.m_layerTree.child.end(); ++staves) {
-
-        ScoreDef *currentScoreDef = this->GetCurrentScoreDef();
-        int transSemi = 0;
-        if (StaffDef *staffDef = currentScoreDef->GetStaffDef(staves->first)) {
+    for (auto &[staffN, layers] : initProcessingListsParams.m_layerTree.child) {
+        MIDIStaff midiStaff = { NULL, staffN, midiTrack, midiChannel, 0, {} };
+        if (StaffDef *staffDef = this->GetCurrentScoreDef()->GetStaffDef(staffN)) {
+            midiStaff.m_staffDef = staffDef;
             // get the transposition (semi-tone) value for the staff
-            if (staffDef->HasTransSemi()) transSemi = staffDef->GetTransSemi();
+            if (staffDef->HasTransSemi()) midiStaff.m_transSemi = staffDef->GetTransSemi();
             midiTrack = staffDef->GetN();
             if (midiFile->getTrackCount() < (midiTrack + 1)) {
                 midiFile->addTracks(midiTrack + 1 - midiFile->getTrackCount());
             }
-            // set MIDI channel and instrument
-            InstrDef *instrdef = dynamic_cast<InstrDef *>(staffDef->FindDescendantByType(INSTRDEF, 1));
-            if (!instrdef) {
-                StaffGrp *staffGrp = vrv_cast<StaffGrp *>(staffDef->GetFirstAncestor(STAFFGRP));
-                assert(staffGrp);
-                instrdef = dynamic_cast<InstrDef *>(staffGrp->FindDescendantByType(INSTRDEF, 1));
-            }
+            // set MIDI channel and track
+            InstrDef *instrdef = this->GetMIDIInstrDef(staffDef);
             if (instrdef) {
                 if (instrdef->HasMidiChannel()) midiChannel = instrdef->GetMidiChannel();
                 if (instrdef->HasMidiTrack()) {
@@ -393,69 +431,151 @@ void Doc::ExportMIDI(smf::MidiFile *midiFile)
                         LogWarning("A high MIDI track number was assigned to staff %d", staffDef->GetN());
                     }
                 }
-                if (instrdef->HasMidiInstrnum()) {
-                    midiFile->addPatchChange(midiTrack, 0, midiChannel, instrdef->GetMidiInstrnum());
-                }
-            }
-            // set MIDI track name
-            Label *label = vrv_cast<Label *>(staffDef->FindDescendantByType(LABEL, 1));
-            if (!label) {
-                StaffGrp *staffGrp = vrv_cast<StaffGrp *>(staffDef->GetFirstAncestor(STAFFGRP));
-                assert(staffGrp);
-                label = vrv_cast<Label *>(staffGrp->FindDescendantByType(LABEL, 1));
-            }
-            if (label) {
-                std::string trackName = UTF16to8(label->GetText(label)).c_str();
-                if (!trackName.empty()) midiFile->addTrackName(midiTrack, 0, trackName);
-            }
-            // set MIDI key signature
-            KeySig *keySig = vrv_cast<KeySig *>(staffDef->FindDescendantByType(KEYSIG));
-            if (!keySig && (currentScoreDef->HasKeySigInfo())) {
-                keySig = vrv_cast<KeySig *>(currentScoreDef->GetKeySig());
             }
-            if (keySig && keySig->HasSig()) {
-                midiFile->addKeySignature(midiTrack, 0, keySig->GetFifthsInt(), (keySig->GetMode() == MODE_minor));
+            midiStaff.m_midiTrack = midiTrack;
+            midiStaff.m_midiChannel = midiChannel;
+        }
+        for (auto &[layerN, verses] : layers.child) {
+            midiStaff.m_layerNs.push_back(layerN);
+        }
+        midiStaves.push_back(midiStaff);
+    }
+
+    // Staves with the same MIDI track are generated together because some events depend on the previous events of
+    // the track (e.g., with beatRpt). Each group is generated into its own MidiFile and merged afterwards in order.
+    std::vector<std::vector<const MIDIStaff *>> midiGroups;
+    std::map<int, int> midiGroupIndices;
+    for (const MIDIStaff &midiStaff : midiStaves) {
+        auto [iter, inserted] = midiGroupIndices.insert({ midiStaff.m_midiTrack, (int)midiGroups.size() });
+        if (inserted) midiGroups.push_back({});
+        midiGroups.at(iter->second).push_back(&midiStaff);
+    }
+
+    std::vector<smf::MidiFile> midiGroupFiles(midiGroups.size());
+    for (smf::MidiFile &midiGroupFile : midiGroupFiles) {
+        midiGroupFile.setTPQ(midiFile->getTPQ());
+        midiGroupFile.addTracks(midiFile->getTrackCount() - 1);
+    }
+
+    // The range of the events of each staff in track 0 of its group file, for merging them in staff order
+    std::vector<std::pair<int, int>> metaEventRanges(midiStaves.size());
+
+    const bool cueExclusion = this->GetOptions()->m_midiNoCue.GetValue();
+    const int threadCount = this->GetOptions()->m_midiThreads.GetValue();
+    RunInParallel((int)midiGroups.size(), threadCount, [&](int group) {
+        smf::MidiFile *midiGroupFile = &midiGroupFiles.at(group);
+        for (const MIDIStaff *midiStaff : midiGroups.at(group)) {
+            const int metaEventStart = midiGroupFile->getEventCount(0);
+            if (midiStaff->m_staffDef) {
+                this->GenerateMIDIStaffDef(
+                    midiGroupFile, midiStaff->m_staffDef, midiStaff->m_midiTrack, midiStaff->m_midiChannel);
             }
-            // set MIDI time signature
-            MeterSig *meterSig = vrv_cast<MeterSig *>(staffDef->FindDescendantByType(METERSIG));
-            if (!meterSig && (currentScoreDef->HasMeterSigInfo())) {
-                meterSig = vrv_cast<MeterSig *>(currentScoreDef->GetMeterSig());
+
+            // Set initial scoreDef values for tuning
+            Functor generateScoreDefMIDI(&Object::GenerateMIDI);
+            Functor generateScoreDefMIDIEnd(&Object::GenerateMIDIEnd);
+            GenerateMIDIParams generateScoreDefMIDIParams(midiGroupFile, &generateScoreDefMIDI);
+            generateScoreDefMIDIParams.m_midiChannel = midiStaff->m_midiChannel;
+            generateScoreDefMIDIParams.m_midiTrack = midiStaff->m_midiTrack;
+            this->GetCurrentScoreDef()->Process(
+                &generateScoreDefMIDI, &generateScoreDefMIDIParams, &generateScoreDefMIDIEnd);
+
+            for (int layerN : midiStaff->m_layerNs) {
+                Filters filters;
+                // Create ad comparison object for each type / @n
+                AttNIntegerComparison matchStaff(STAFF, midiStaff->m_staffN);
+                AttNIntegerComparison matchLayer(LAYER, layerN);
+                filters.Add(&matchStaff);
+                filters.Add(&matchLayer);
+
+                Functor generateMIDI(&Object::GenerateMIDI);
+                Functor generateMIDIEnd(&Object::GenerateMIDIEnd);
+                GenerateMIDIParams generateMIDIParams(midiGroupFile, &generateMIDI);
+                generateMIDIParams.m_midiChannel = midiStaff->m_midiChannel;
+                generateMIDIParams.m_midiTrack = midiStaff->m_midiTrack;
+                generateMIDIParams.m_staffN = midiStaff->m_staffN;
+                generateMIDIParams.m_transSemi = midiStaff->m_transSemi;
+                generateMIDIParams.m_currentTempo = tempo;
+                generateMIDIParams.m_deferredNotes = initMIDIParams.m_deferredNotes;
+                generateMIDIParams.m_cueExclusion = cueExclusion;
+
+                // LogDebug("Exporting track %d ----------------", midiTrack);
+                for (Object *object : midiObjects) {
+                    object->Process(&generateMIDI, &generateMIDIParams, &generateMIDIEnd, &filters);
+                }
             }
-            if (meterSig && meterSig->HasCount()) {
-                midiFile->addTimeSignature(midiTrack, 0, meterSig->GetTotalCount(), meterSig->GetUnit());
+            metaEventRanges.at(midiStaff - midiStaves.data()) = { metaEventStart, midiGroupFile->getEventCount(0) };
+        }
+    });
+
+    // Merge the events of track 0, which are shared by all the staves, in staff order as when generated serially
+    for (int staff = 0; staff < (int)midiStaves.size(); ++staff) {
+        smf::MidiFile &midiGroupFile = midiGroupFiles.at(midiGroupIndices.at(midiStaves.at(staff).m_midiTrack));
+        for (int i = metaEventRanges.at(staff).first; i < metaEventRanges.at(staff).second; ++i) {
+            midiFile->addEvent(0, midiGroupFile.getEvent(0, i));
+        }
+    }
+    // Merge the events of the other tracks, each of which is generated by a single group
+    for (smf::MidiFile &midiGroupFile : midiGroupFiles) {
+        for (int track = 1; track < midiGroupFile.getTrackCount(); ++track) {
+            for (int i = 0; i < midiGroupFile.getEventCount(track); ++i) {
+                midiFile->addEvent(track, midiGroupFile.getEvent(track, i));
             }
         }
+    }
+}
 
-        // Set initial scoreDef values for tuning
-        Functor generateScoreDefMIDI(&Object::GenerateMIDI);
-        Functor generateScoreDefMIDIEnd(&Object::GenerateMIDIEnd);
-        GenerateMIDIParams generateScoreDefMIDIParams(midiFile, &generateScoreDefMIDI);
-        generateScoreDefMIDIParams.m_midiChannel = midiChannel;
-        generateScoreDefMIDIParams.m_midiTrack = midiTrack;
-        currentScoreDef->Process(&generateScoreDefMIDI, &generateScoreDefMIDIParams, &generateScoreDefMIDIEnd);
+InstrDef *Doc::GetMIDIInstrDef(StaffDef *staffDef)
+{
+    assert(staffDef);
 
-        for (layers = staves->second.child.begin(); layers != staves->second.child.end(); ++layers) {
-            filters.Clear();
-            // Create ad comparison object for each type / @n
-            AttNIntegerComparison matchStaff(STAFF, staves->first);
-            AttNIntegerComparison matchLayer(LAYER, layers->first);
-            filters.Add(&matchStaff);
-            filters.Add(&matchLayer);
+    InstrDef *instrdef = dynamic_cast<InstrDef *>(staffDef->FindDescendantByType(INSTRDEF, 1));
+    if (!instrdef) {
+        StaffGrp *staffGrp = vrv_cast<StaffGrp *>(staffDef->GetFirstAncestor(STAFFGRP));
+        assert(staffGrp);
+        instrdef = dynamic_cast<InstrDef *>(staffGrp->FindDescendantByType(INSTRDEF, 1));
+    }
+    return instrdef;
+}
 
-            Functor generateMIDI(&Object::GenerateMIDI);
-            Functor generateMIDIEnd(&Object::GenerateMIDIEnd);
-            GenerateMIDIParams generateMIDIParams(midiFile, &generateMIDI);
-            generateMIDIParams.m_midiChannel = midiChannel;
-            generateMIDIParams.m_midiTrack = midiTrack;
-            generateMIDIParams.m_staffN = staves->first;
-            generateMIDIParams.m_transSemi = transSemi;
-            generateMIDIParams.m_currentTempo = tempo;
-            generateMIDIParams.m_deferredNotes = initMIDIParams.m_deferredNotes;
-            generateMIDIParams.m_cueExclusion = this->GetOptions()->m_midiNoCue.GetValue();
-
-            // LogDebug("Exporting track %d ----------------", midiTrack);
-            this->Process(&generateMIDI, &generateMIDIParams, &generateMIDIEnd, &filters);
-        }
+void Doc::GenerateMIDIStaffDef(smf::MidiFile *midiFile, StaffDef *staffDef, int midiTrack, int midiChannel)
+{
+    assert(midiFile);
+    assert(staffDef);
+
+    ScoreDef *currentScoreDef = this->GetCurrentScoreDef();
+
+    // set MIDI instrument
+    InstrDef *instrdef = this->GetMIDIInstrDef(staffDef);
+    if (instrdef && instrdef->HasMidiInstrnum()) {
+        midiFile->addPatchChange(midiTrack, 0, midiChannel, instrdef->GetMidiInstrnum());
+    }
+    // set MIDI track name
+    Label *label = vrv_cast<Label *>(staffDef->FindDescendantByType(LABEL, 1));
+    if (!label) {
+        StaffGrp *staffGrp = vrv_cast<StaffGrp *>(staffDef->GetFirstAncestor(STAFFGRP));
+        assert(staffGrp);
+        label = vrv_cast<Label *>(staffGrp->FindDescendantByType(LABEL, 1));
+    }
+    if (label) {
+        std::string trackName = UTF16to8(label->GetText(label)).c_str();
+        if (!trackName.empty()) midiFile->addTrackName(midiTrack, 0, trackName);
+    }
+    // set MIDI key signature
+    KeySig *keySig = vrv_cast<KeySig *>(staffDef->FindDescendantByType(KEYSIG));
+    if (!keySig && (currentScoreDef->HasKeySigInfo())) {
+        keySig = vrv_cast<KeySig *>(currentScoreDef->GetKeySig());
+    }
+    if (keySig && keySig->HasSig()) {
+        midiFile->addKeySignature(midiTrack, 0, keySig->GetFifthsInt(), (keySig->GetMode() == MODE_minor));
+    }
+    // set MIDI time signature
+    MeterSig *meterSig = vrv_cast<MeterSig *>(staffDef->FindDescendantByType(METERSIG));
+    if (!meterSig && (currentScoreDef->HasMeterSigInfo())) {
+        meterSig = vrv_cast<MeterSig *>(currentScoreDef->GetMeterSig());
+    }
+    if (meterSig && meterSig->HasCount()) {
+        midiFile->addTimeSignature(midiTrack, 0, meterSig->GetTotalCount(), meterSig->GetUnit());
     }
 }
 
@@ -514,9 +634,19 @@ void Doc::PrepareData()
 
     /************ Store default durations ************/
 
+    // Independent passes are added to the same array and done in a single traversal
+    ArrayOfFunctorTuples functors;
+
     Functor prepareDuration(&Object::PrepareDuration);
     PrepareDurationParams prepareDurationParams(&prepareDuration);
-    this->Process(&prepareDuration, &prepareDurationParams);
+    functors.push_back({ &prepareDuration, &prepareDurationParams, NULL });
+
+    // Resolve <reh> elements first, since they can be encoded without @startid or @tstamp, but we need one internally
+    // for placement
+    Functor prepareRehPosition(&Object::PrepareRehPosition);
+    functors.push_back({ &prepareRehPosition, NULL, NULL });
+
+    this->Process(functors);
 
     /************ Resolve @startid / @endid ************/
 
@@ -524,8 +654,15 @@ void Doc::PrepareData()
     PrepareTimeSpanningParams prepareTimeSpanningParams;
     Functor prepareTimeSpanning(&Object::PrepareTimeSpanning);
     Functor prepareTimeSpanningEnd(&Object::PrepareTimeSpanningEnd);
-    this->Process(
-        &prepareTimeSpanning, &prepareTimeSpanningParams, &prepareTimeSpanningEnd, NULL, UNLIMITED_DEPTH, BACKWARD);
+    functors = { { &prepareTimeSpanning, &prepareTimeSpanningParams, &prepareTimeSpanningEnd } };
+
+    // Try to match all time pointing elements (tempo, fermata, etc) by processing backwards
+    PrepareTimePointingParams prepareTimePointingParams;
+    Functor prepareTimePointing(&Object::PrepareTimePointing);
+    Functor prepareTimePointingEnd(&Object::PrepareTimePointingEnd);
+    functors.push_back({ &prepareTimePointing, &prepareTimePointingParams, &prepareTimePointingEnd });
+
+    this->Process(functors, NULL, UNLIMITED_DEPTH, BACKWARD);
 
     // First we try backwards because normally the spanning elements are at the end of
     // the measure. However, in some case, one (or both) end points will appear afterwards
@@ -538,36 +675,54 @@ void Doc::PrepareData()
     }
 
     // Display warning if some elements were not matched
-    const size_t unmatchedElements = std::count_if(prepareTimeSpanningParams.m_timeSpanningInterfaces.cbegin(),
-        prepareTimeSpanningParams.m_timeSpanningInterfaces.cend(),
-        [](const ListOfSpanningInterOwnerPairs::value_type &entry) {
-            return (entry.first->HasStartid() && entry.first->HasEndid());
-        });
-    if (unmatchedElements > 0) {
-        LogWarning("%d time spanning element(s) with startid and endid could not be matched.", unmatchedElements);
+    // An interface with neither end point matched is listed once for each of them
+    std::set<const TimeSpanningInterface *> unmatchedElements;
+    for (const auto &entry : prepareTimeSpanningParams.m_timeSpanningInterfaces) {
+        const TimeSpanningInterface *interface = entry.second.first;
+        if (interface->HasStartid() && interface->HasEndid()) unmatchedElements.insert(interface);
+    }
+    if (!unmatchedElements.empty()) {
+        LogWarning(
+            "%d time spanning element(s) with startid and endid could not be matched.", unmatchedElements.size());
     }
 
-    /************ Resolve @startid (only) ************/
-
-    // Resolve <reh> elements first, since they can be encoded without @startid or @tstamp, but we need one internally
-    // for placement
-    Functor prepareRehPosition(&Object::PrepareRehPosition);
-    this->Process(&prepareRehPosition, NULL);
-
-    // Try to match all time pointing elements (tempo, fermata, etc) by processing backwards
-    PrepareTimePointingParams prepareTimePointingParams;
-    Functor prepareTimePointing(&Object::PrepareTimePointing);
-    Functor prepareTimePointingEnd(&Object::PrepareTimePointingEnd);
-    this->Process(
-        &prepareTimePointing, &prepareTimePointingParams, &prepareTimePointingEnd, NULL, UNLIMITED_DEPTH, BACKWARD);
-
-    /************ Resolve @tstamp / tstamp2 ************/
+    /************ Resolve @tstamp / tstamp2, linking, @plist, cross staff and processing lists ************/
 
     // Now try to match the @tstamp and @tstamp2 attributes.
     PrepareTimestampsParams prepareTimestampsParams;
     Functor prepareTimestamps(&Object::PrepareTimestamps);
     Functor prepareTimestampsEnd(&Object::PrepareTimestampsEnd);
-    this->Process(&prepareTimestamps, &prepareTimestampsParams, &prepareTimestampsEnd);
+    functors = { { &prepareTimestamps, &prepareTimestampsParams, &prepareTimestampsEnd } };
+
+    // Try to match all pointing elements using @next, @sameas and @stem.sameas
+    PrepareLinkingParams prepareLinkingParams;
+    Functor prepareLinking(&Object::PrepareLinking);
+    functors.push_back({ &prepareLinking, &prepareLinkingParams, NULL });
+
+    // Try to match all pointing elements using @plist
+    PreparePlistParams preparePlistParams;
+    Functor preparePlist(&Object::PreparePlist);
+    functors.push_back({ &preparePlist, &preparePlistParams, NULL });
+
+    // Prepare the cross-staff pointers
+    PrepareCrossStaffParams prepareCrossStaffParams;
+    Functor prepareCrossStaff(&Object::PrepareCrossStaff);
+    Functor prepareCrossStaffEnd(&Object::PrepareCrossStaffEnd);
+    functors.push_back({ &prepareCrossStaff, &prepareCrossStaffParams, &prepareCrossStaffEnd });
+
+    // We need to populate processing lists for processing the document by Layer (for matching @tie) and
+    // by Verse (for matching syllable connectors)
+    InitProcessingListsParams initProcessingListsParams;
+    // Alternate solution with StaffN_LayerN_VerseN_t (see also Verse::PrepareData)
+    // StaffN_LayerN_VerseN_t staffLayerVerseTree;
+    // params.push_back(&staffLayerVerseTree);
+
+    // We first fill a tree of ints with [staff/layer] and [staff/layer/verse] numbers (@n) to be processed
+    // LogElapsedTimeStart();
+    Functor initProcessingLists(&Object::InitProcessingLists);
+    functors.push_back({ &initProcessingLists, &initProcessingListsParams, NULL });
+
+    this->Process(functors);
 
     // If some are still there, then it is probably an issue in the encoding
     if (!prepareTimestampsParams.m_timeSpanningInterfaces.empty()) {
@@ -577,11 +732,6 @@ void Doc::PrepareData()
 
     /************ Resolve linking (@next) ************/
 
-    // Try to match all pointing elements using @next, @sameas and @stem.sameas
-    PrepareLinkingParams prepareLinkingParams;
-    Functor prepareLinking(&Object::PrepareLinking);
-    this->Process(&prepareLinking, &prepareLinkingParams);
-
     // If we have some left process again backward
     if (!prepareLinkingParams.m_sameasIDPairs.empty() || !prepareLinkingParams.m_stemSameasIDPairs.empty()) {
         prepareLinkingParams.m_fillList = false;
@@ -602,11 +752,6 @@ void Doc::PrepareData()
 
     /************ Resolve @plist ************/
 
-    // Try to match all pointing elements using @plist
-    PreparePlistParams preparePlistParams;
-    Functor preparePlist(&Object::PreparePlist);
-    this->Process(&preparePlist, &preparePlistParams);
-
     // Process plist after all pairs has been collected
     if (!preparePlistParams.m_interfaceIDTuples.empty()) {
         preparePlistParams.m_fillList = false;
@@ -617,6 +762,7 @@ void Doc::PrepareData()
             plistInterface->SetRef(objectReference);
         }
         preparePlistParams.m_interfaceIDTuples.clear();
+        preparePlistParams.m_interfaceIDIndices.clear();
     }
 
     // If some are still there, then it is probably an issue in the encoding
@@ -625,14 +771,6 @@ void Doc::PrepareData()
             "%d element(s) with a @plist could not match the target", preparePlistParams.m_interfaceIDTuples.size());
     }
 
-    /************ Resolve cross staff ************/
-
-    // Prepare the cross-staff pointers
-    PrepareCrossStaffParams prepareCrossStaffParams;
-    Functor prepareCrossStaff(&Object::PrepareCrossStaff);
-    Functor prepareCrossStaffEnd(&Object::PrepareCrossStaffEnd);
-    this->Process(&prepareCrossStaff, &prepareCrossStaffParams, &prepareCrossStaffEnd);
-
     /************ Resolve beamspan elements ***********/
 
     FunctorDocParams functorDocParams(this);
@@ -641,18 +779,6 @@ void Doc::PrepareData()
 
     /************ Prepare processing by staff/layer/verse ************/
 
-    // We need to populate processing lists for processing the document by Layer (for matching @tie) and
-    // by Verse (for matching syllable connectors)
-    InitProcessingListsParams initProcessingListsParams;
-    // Alternate solution with StaffN_LayerN_VerseN_t (see also Verse::PrepareData)
-    // StaffN_LayerN_VerseN_t staffLayerVerseTree;
-    // params.push_back(&staffLayerVerseTree);
-
-    // We first fill a tree of ints with [staff/layer] and [staff/layer/verse] numbers (@n) to be processed
-    // LogElapsedTimeStart();
-    Functor initProcessingLists(&Object::InitProcessingLists);
-    this->Process(&initProcessingLists, &initProcessingListsParams);
-
     // The tree is used to process each staff/layer/verse separately
     // For this, we use an array of AttNIntegerComparison that looks for each object if it is of the type
     // and with @n specified
@@ -769,26 +895,24 @@ void Doc::PrepareData()
         }
     }
 
-    /************ Resolve endings ************/
+    /************ Resolve endings, floating groups and cue size ************/
 
     // Prepare the endings (pointers to the measure after and before the boundaries
     PrepareMilestonesParams prepareEndingsParams;
     Functor prepareEndings(&Object::PrepareMilestones);
-    this->Process(&prepareEndings, &prepareEndingsParams);
-
-    /************ Resolve floating groups for vertical alignment ************/
+    functors = { { &prepareEndings, &prepareEndingsParams, NULL } };
 
-    // Prepare the floating drawing groups
+    // Prepare the floating drawing groups for vertical alignment
     PrepareFloatingGrpsParams prepareFloatingGrpsParams(this);
     Functor prepareFloatingGrps(&Object::PrepareFloatingGrps);
     Functor prepareFloatingGrpsEnd(&Object::PrepareFloatingGrpsEnd);
-    this->Process(&prepareFloatingGrps, &prepareFloatingGrpsParams, &prepareFloatingGrpsEnd);
-
-    /************ Resolve cue size ************/
+    functors.push_back({ &prepareFloatingGrps, &prepareFloatingGrpsParams, &prepareFloatingGrpsEnd });
 
     // Prepare the drawing cue size
     Functor prepareCueSize(&Object::PrepareCueSize);
-    this->Process(&prepareCueSize, NULL);
+    functors.push_back({ &prepareCueSize, NULL, NULL });
+
+    this->Process(functors);
 
     /************ Instanciate LayerElement parts (stemp, flag, dots, etc) ************/
 
@@ -931,8 +1055,7 @@ void Doc::CastOffDocBase(bool useSb, bool usePb, bool smart)
         return;
     }
 
-    std::list<Score *> scores = this->GetScores();
-    assert(!scores.empty());
+    assert(!this->GetScores().empty());
 
     this->ScoreDefSetCurrentDoc();
 
@@ -982,11 +1105,70 @@ void Doc::CastOffDocBase(bool useSb, bool usePb, bool smart)
     Functor alignMeasuresEnd(&Object::AlignMeasuresEnd);
     castOffSinglePage->Process(&alignMeasures, &alignMeasuresParams, &alignMeasuresEnd);
 
+    this->CastOffPagesBase(castOffSinglePage, leftoverSystem);
+}
+
+void Doc::RedoPageCastOffDoc()
+{
+    if (!this->CanRedoPageCastOff()) {
+        LogDebug("The pages of the document cannot be cast off again");
+        return;
+    }
+
+    Pages *pages = this->GetPages();
+    assert(pages);
+
+    // Gather the systems and the page elements of all the pages into a single page
+    Page *castOffSinglePage = new Page();
+    for (Object *page : pages->GetChildren()) {
+        castOffSinglePage->MoveChildrenFrom(page);
+    }
+    pages->ClearChildren();
+    this->ResetDataPage();
+
+    // Restore the horizontal layout of the cast off and the system widths to have the page as after
+    // Doc::CastOffDocBase since the pages have been laid out and justified in between
+    // The drawing scoreDefs are unset as for new systems since they hold the label widths of the laid out pages
+    pages->AddChild(castOffSinglePage);
+    this->SetDrawingPage(0);
+    Functor scoreDefUnsetCurrent(&Object::ScoreDefUnsetCurrent);
+    ScoreDefUnsetCurrentParams scoreDefUnsetCurrentParams(&scoreDefUnsetCurrent);
+    castOffSinglePage->Process(&scoreDefUnsetCurrent, &scoreDefUnsetCurrentParams);
+    castOffSinglePage->LayOutHorizontallyWithCache(true);
+    AlignMeasuresParams alignMeasuresParams(this);
+    alignMeasuresParams.m_storeCastOffSystemWidths = true;
+    Functor alignMeasures(&Object::AlignMeasures);
+    Functor alignMeasuresEnd(&Object::AlignMeasuresEnd);
+    castOffSinglePage->Process(&alignMeasures, &alignMeasuresParams, &alignMeasuresEnd);
+    pages->DetachChild(0);
+    assert(castOffSinglePage && !castOffSinglePage->GetParent());
+    this->ResetDataPage();
+
+    m_isCastOff = false;
+
+    // A leftover system is merged only when first cast off, after which this is not called anymore
+    this->CastOffPagesBase(castOffSinglePage, NULL);
+}
+
+bool Doc::CanRedoPageCastOff() const
+{
+    return (m_isCastOff && m_isPageCastOffRedoable && !this->HasSelection());
+}
+
+void Doc::CastOffPagesBase(Page *castOffSinglePage, System *leftoverSystem)
+{
+    Pages *pages = this->GetPages();
+    assert(pages);
+
     // Replace it with the castOffSinglePage
     pages->AddChild(castOffSinglePage);
     this->ResetDataPage();
     this->SetDrawingPage(0);
 
+    // The scores are looked for in the pages and can be collected only once the page is added
+    std::list<Score *> scores = this->GetScores();
+    assert(!scores.empty());
+
     bool optimize = false;
     for (auto const score : scores) {
         if (score->ScoreDefNeedsOptimization(m_options->m_condense.GetValue())) {
@@ -1024,6 +1206,8 @@ void Doc::CastOffDocBase(bool useSb, bool usePb, bool smart)
     Functor castOffPagesEnd(&Object::CastOffPagesEnd);
     pages->AddChild(castOffFirstPage);
     castOffSinglePage->Process(&castOffPages, &castOffPagesParams, &castOffPagesEnd);
+    // A leftover system merged into the previous one stays in the single page
+    m_isPageCastOffRedoable = (!leftoverSystem || (leftoverSystem->GetParent() != castOffSinglePage));
     delete castOffSinglePage;
 
     this->ScoreDefSetCurrentDoc(true);
@@ -1063,6 +1247,7 @@ void Doc::UnCastOffDoc(bool resetCache)
     this->ScoreDefSetCurrentDoc(true);
 
     m_isCastOff = false;
+    m_isPageCastOffRedoable = false;
 }
 
 void Doc::CastOffEncodingDoc()
@@ -1108,6 +1293,7 @@ void Doc::CastOffEncodingDoc()
     }
 
     m_isCastOff = true;
+    m_isPageCastOffRedoable = false;
 }
 
 void Doc::InitSelectionDoc(DocSelection &selection, bool resetCache)
@@ -1601,13 +1787,13 @@ int Doc::GetGlyphTop(wchar_t code, int staffSize, bool graceSize) const
     return this->GetGlyphBottom(code, staffSize, graceSize) + this->GetGlyphHeight(code, staffSize, graceSize);
 }
 
-int Doc::GetTextGlyphHeight(wchar_t code, FontInfo *font, bool graceSize) const
+int Doc::GetTextGlyphHeight(wchar_t code, FontInfo *font, bool graceSize, const Resources *resources) const
 {
     assert(font);
 
     int x, y, w, h;
-    const Resources &resources = this->GetResources();
-    const Glyph *glyph = resources.GetTextGlyph(code);
+    if (!resources) resources = &this->GetResources();
+    const Glyph *glyph = resources->GetTextGlyph(code);
     assert(glyph);
     glyph->GetBoundingBox(x, y, w, h);
     h = h * font->GetPointSize() / glyph->GetUnitsPerEm();
@@ -1615,13 +1801,13 @@ int Doc::GetTextGlyphHeight(wchar_t code, FontInfo *font, bool graceSize) const
     return h;
 }
 
-int Doc::GetTextGlyphWidth(wchar_t code, FontInfo *font, bool graceSize) const
+int Doc::GetTextGlyphWidth(wchar_t code, FontInfo *font, bool graceSize, const Resources *resources) const
 {
     assert(font);
 
     int x, y, w, h;
-    const Resources &resources = this->GetResources();
-    const Glyph *glyph = resources.GetTextGlyph(code);
+    if (!resources) resources = &this->GetResources();
+    const Glyph *glyph = resources->GetTextGlyph(code);
     assert(glyph);
     glyph->GetBoundingBox(x, y, w, h);
     w = w * font->GetPointSize() / glyph->GetUnitsPerEm();
@@ -1629,12 +1815,12 @@ int Doc::GetTextGlyphWidth(wchar_t code, FontInfo *font, bool graceSize) const
     return w;
 }
 
-int Doc::GetTextGlyphAdvX(wchar_t code, FontInfo *font, bool graceSize) const
+int Doc::GetTextGlyphAdvX(wchar_t code, FontInfo *font, bool graceSize, const Resources *resources) const
 {
     assert(font);
 
-    const Resources &resources = this->GetResources();
-    const Glyph *glyph = resources.GetTextGlyph(code);
+    if (!resources) resources = &this->GetResources();
+    const Glyph *glyph = resources->GetTextGlyph(code);
     assert(glyph);
     int advX = glyph->GetHorizAdvX();
     advX = advX * font->GetPointSize() / glyph->GetUnitsPerEm();
@@ -1642,13 +1828,13 @@ int Doc::GetTextGlyphAdvX(wchar_t code, FontInfo *font, bool graceSize) const
     return advX;
 }
 
-int Doc::GetTextGlyphDescender(wchar_t code, FontInfo *font, bool graceSize) const
+int Doc::GetTextGlyphDescender(wchar_t code, FontInfo *font, bool graceSize, const Resources *resources) const
 {
     assert(font);
 
     int x, y, w, h;
-    const Resources &resources = this->GetResources();
-    const Glyph *glyph = resources.GetTextGlyph(code);
+    if (!resources) resources = &this->GetResources();
+    const Glyph *glyph = resources->GetTextGlyph(code);
     assert(glyph);
     glyph->GetBoundingBox(x, y, w, h);
     y = y * font->GetPointSize() / glyph->GetUnitsPerEm();
@@ -1656,10 +1842,10 @@ int Doc::GetTextGlyphDescender(wchar_t code, FontInfo *font, bool graceSize) con
     return y;
 }
 
-int Doc::GetTextLineHeight(FontInfo *font, bool graceSize) const
+int Doc::GetTextLineHeight(FontInfo *font, bool graceSize, const Resources *resources) const
 {
-    int descender = -this->GetTextGlyphDescender(L'q', font, graceSize);
-    int height = this->GetTextGlyphHeight(L'I', font, graceSize);
+    int descender = -this->GetTextGlyphDescender(L'q', font, graceSize, resources);
+    int height = this->GetTextGlyphHeight(L'I', font, graceSize, resources);
 
     int lineHeight = ((descender + height) * 1.1);
     if (font->GetSupSubScript()) lineHeight /= SUPER_SCRIPT_FACTOR;
@@ -1667,9 +1853,9 @@ int Doc::GetTextLineHeight(FontInfo *font, bool graceSize) const
     return lineHeight;
 }
 
-int Doc::GetTextXHeight(FontInfo *font, bool graceSize) const
+int Doc::GetTextXHeight(FontInfo *font, bool graceSize, const Resources *resources) const
 {
-    return this->GetTextGlyphHeight('x', font, graceSize);
+    return this->GetTextGlyphHeight('x', font, graceSize, resources);
 }
 
 int Doc::GetDrawingUnit(int staffSize) const
@@ -1768,23 +1954,44 @@ double Doc::GetCueScaling() const
 
 FontInfo *Doc::GetDrawingSmuflFont(int staffSize, bool graceSize)
 {
-    m_drawingSmuflFont.SetFaceName(m_options->m_font.GetValue().c_str());
-    int value = m_drawingSmuflFontSize * staffSize / 100;
-    if (graceSize) value = value * m_options->m_graceFactor.GetValue();
-    m_drawingSmuflFont.SetPointSize(value);
-    return &m_drawingSmuflFont;
+    return this->GetDrawingSmuflFont(&m_drawingSmuflFont, staffSize, graceSize);
 }
 
 FontInfo *Doc::GetDrawingLyricFont(int staffSize)
 {
-    m_drawingLyricFont.SetPointSize(m_drawingLyricFontSize * staffSize / 100);
-    return &m_drawingLyricFont;
+    return this->GetDrawingLyricFont(&m_drawingLyricFont, staffSize);
 }
 
 FontInfo *Doc::GetFingeringFont(int staffSize)
 {
-    m_fingeringFont.SetPointSize(m_fingeringFontSize * staffSize / 100);
-    return &m_fingeringFont;
+    return this->GetFingeringFont(&m_fingeringFont, staffSize);
+}
+
+FontInfo *Doc::GetDrawingSmuflFont(FontInfo *font, int staffSize, bool graceSize) const
+{
+    assert(font);
+
+    font->SetFaceName(m_options->m_font.GetValue().c_str());
+    int value = m_drawingSmuflFontSize * staffSize / 100;
+    if (graceSize) value = value * m_options->m_graceFactor.GetValue();
+    font->SetPointSize(value);
+    return font;
+}
+
+FontInfo *Doc::GetDrawingLyricFont(FontInfo *font, int staffSize) const
+{
+    assert(font);
+
+    font->SetPointSize(m_drawingLyricFontSize * staffSize / 100);
+    return font;
+}
+
+FontInfo *Doc::GetFingeringFont(FontInfo *font, int staffSize) const
+{
+    assert(font);
+
+    font->SetPointSize(m_fingeringFontSize * staffSize / 100);
+    return font;
 }
 
 double Doc::GetLeftMargin(const ClassId classId) const
@@ -2006,27 +2213,27 @@ int Doc::CalcMusicFontSize()
     return m_options->m_unit.GetValue() * 8;
 }
 
-int Doc::GetAdjustedDrawingPageHeight() const
+int Doc::GetAdjustedDrawingPageHeight(const Page *page) const
 {
-    assert(m_drawingPage);
+    assert(page);
 
     if ((this->GetType() == Transcription) || (this->GetType() == Facs)) {
-        return m_drawingPage->m_pageHeight / DEFINITION_FACTOR;
+        return page->m_pageHeight / DEFINITION_FACTOR;
     }
 
-    int contentHeight = m_drawingPage->GetContentHeight();
+    int contentHeight = page->GetContentHeight();
     return (contentHeight + m_drawingPageMarginTop + m_drawingPageMarginBottom) / DEFINITION_FACTOR;
 }
 
-int Doc::GetAdjustedDrawingPageWidth() const
+int Doc::GetAdjustedDrawingPageWidth(const Page *page) const
 {
-    assert(m_drawingPage);
+    assert(page);
 
     if ((this->GetType() == Transcription) || (this->GetType() == Facs)) {
-        return m_drawingPage->m_pageWidth / DEFINITION_FACTOR;
+        return page->m_pageWidth / DEFINITION_FACTOR;
     }
 
-    int contentWidth = m_drawingPage->GetContentWidth();
+    int contentWidth = page->GetContentWidth();
     return (contentWidth + m_drawingPageMarginLeft + m_drawingPageMarginRight) / DEFINITION_FACTOR;
 }
 
@@ -79,9 +79,9 @@ const ArrayOfBeamElementCoords *FTrem::GetElementCoords()
     return &m_beamElementCoords;
 }
 
-void FTrem::FilterList(ListOfConstObjects &childList) const
+void FTrem::FilterList(ArrayOfConstObjects &childList) const
 {
-    ListOfConstObjects::iterator iter = childList.begin();
+    ArrayOfConstObjects::iterator iter = childList.begin();
 
     while (iter != childList.end()) {
         if (!(*iter)->Is(NOTE) && !(*iter)->Is(CHORD)) {
@@ -200,7 +200,7 @@ int FTrem::CalcStem(FunctorParams *functorParams)
     CalcStemParams *params = vrv_params_cast<CalcStemParams *>(functorParams);
     assert(params);
 
-    const ListOfObjects &fTremChildren = this->GetList(this);
+    const ArrayOfObjects &fTremChildren = this->GetList(this);
 
     // Should we assert this at the beginning?
     if (fTremChildren.empty()) {
@@ -55,30 +55,33 @@ Alignment *HorizontalAligner::SearchAlignmentAtTime(double time, AlignmentType t
 
 const Alignment *HorizontalAligner::SearchAlignmentAtTime(double time, AlignmentType type, int &idx) const
 {
-    int i;
     idx = -1; // the index if we reach the end.
-    const Alignment *alignment = NULL;
-    // First try to see if we already have something at the time position
-    for (i = 0; i < this->GetAlignmentCount(); ++i) {
-        alignment = vrv_cast<const Alignment *>(this->GetChild(i));
+    // The alignments are ordered by time and then by type, so we can look for the first one not before with a
+    // binary search
+    int first = 0;
+    int last = this->GetAlignmentCount();
+    while (first < last) {
+        const int middle = (first + last) / 2;
+        const Alignment *alignment = vrv_cast<const Alignment *>(this->GetChild(middle));
         assert(alignment);
-
-        double alignment_time = alignment->GetTime();
-        if (AreEqual(alignment_time, time)) {
-            if (alignment->GetType() == type) {
-                return alignment;
-            }
-            else if (alignment->GetType() > type) {
-                idx = i;
-                break;
-            }
+        const bool isBefore = AreEqual(alignment->GetTime(), time) ? (alignment->GetType() < type)
+                                                                    : (alignment->GetTime() < time);
+        if (isBefore) {
+            first = middle + 1;
         }
-        // nothing found, do not go any further but keep the index
-        if (alignment->GetTime() > time) {
-            idx = i;
-            break;
+        else {
+            last = middle;
         }
     }
+    // nothing found, do not go any further but keep the index
+    if (first == this->GetAlignmentCount()) return NULL;
+
+    const Alignment *alignment = vrv_cast<const Alignment *>(this->GetChild(first));
+    assert(alignment);
+    // we already have something of the type at the time position
+    if (AreEqual(alignment->GetTime(), time) && (alignment->GetType() == type)) return alignment;
+
+    idx = first;
     return NULL;
 }
 
@@ -88,6 +91,7 @@ void HorizontalAligner::AddAlignment(Alignment *alignment, int idx)
     ArrayOfObjects &children = this->GetChildrenForModification();
     if (idx == -1) {
         children.push_back(alignment);
+        this->UpdateChildIndices((int)children.size() - 1);
     }
     else {
         InsertChild(alignment, idx);
@@ -137,7 +141,7 @@ Alignment *MeasureAligner::GetAlignmentAtTime(double time, AlignmentType type)
     if (idx == -1) {
         if (type != ALIGNMENT_MEASURE_END) {
             // This typically occurs when a tstamp event occurs after the last note of a measure
-            int rightBarlineIdx = m_rightBarLineAlignment->GetIdx();
+            int rightBarlineIdx = this->GetRightBarLineIdx();
             assert(rightBarlineIdx != -1);
             idx = rightBarlineIdx;
             this->SetMaxTime(time);
@@ -157,7 +161,7 @@ void MeasureAligner::SetMaxTime(double time)
     assert(m_rightBarLineAlignment);
 
     // it must be found in the aligner
-    int idx = m_rightBarLineAlignment->GetIdx();
+    int idx = this->GetRightBarLineIdx();
     assert(idx != -1);
 
     int i;
@@ -179,6 +183,16 @@ double MeasureAligner::GetMaxTime() const
     return m_rightAlignment->GetTime();
 }
 
+int MeasureAligner::GetRightBarLineIdx() const
+{
+    assert(m_rightBarLineAlignment);
+
+    for (int i = this->GetAlignmentCount() - 1; i >= 0; --i) {
+        if (this->GetChild(i) == m_rightBarLineAlignment) return i;
+    }
+    return -1;
+}
+
 void MeasureAligner::SetInitialTstamp(int meterUnit)
 {
     if (meterUnit != 0) {
@@ -886,6 +900,7 @@ TimestampAttr *TimestampAligner::GetTimestampAtTime(double time)
     timestampAttr->SetParent(this);
     if (idx == -1) {
         children.push_back(timestampAttr);
+        this->UpdateChildIndices((int)children.size() - 1);
     }
     else {
         InsertChild(timestampAttr, idx);
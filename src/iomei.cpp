@@ -144,8 +144,83 @@
 
 namespace vrv {
 
-const std::vector<std::string> MEIInput::s_editorialElementNames = { "abbr", "add", "app", "annot", "choice", "corr",
-    "damage", "del", "expan", "orig", "ref", "reg", "restore", "sic", "subst", "supplied", "unclear" };
+const std::unordered_set<std::string_view> MEIInput::s_editorialElementNames = { "abbr", "add", "app", "annot",
+    "choice", "corr", "damage", "del", "expan", "orig", "ref", "reg", "restore", "sic", "subst", "supplied",
+    "unclear" };
+
+const std::unordered_map<std::string_view, MEIInput::ChildReader> MEIInput::s_layerChildReaders = {
+    { "accid", &MEIInput::ReadAccid },
+    { "artic", &MEIInput::ReadArtic },
+    { "barLine", &MEIInput::ReadBarLine },
+    { "beam", &MEIInput::ReadBeam },
+    { "beatRpt", &MEIInput::ReadBeatRpt },
+    { "bTrem", &MEIInput::ReadBTrem },
+    { "chord", &MEIInput::ReadChord },
+    { "clef", &MEIInput::ReadClef },
+    { "custos", &MEIInput::ReadCustos },
+    { "dot", &MEIInput::ReadDot },
+    { "fTrem", &MEIInput::ReadFTrem },
+    { "graceGrp", &MEIInput::ReadGraceGrp },
+    { "halfmRpt", &MEIInput::ReadHalfmRpt },
+    { "keyAccid", &MEIInput::ReadKeyAccid },
+    { "keySig", &MEIInput::ReadKeySig },
+    { "label", &MEIInput::ReadLabel },
+    { "labelAbbr", &MEIInput::ReadLabelAbbr },
+    { "ligature", &MEIInput::ReadLigature },
+    { "mensur", &MEIInput::ReadMensur },
+    { "meterSig", &MEIInput::ReadMeterSig },
+    { "meterSigGrp", &MEIInput::ReadMeterSigGrp },
+    { "nc", &MEIInput::ReadNc },
+    { "neume", &MEIInput::ReadNeume },
+    { "note", &MEIInput::ReadNote },
+    { "rest", &MEIInput::ReadRest },
+    { "mRest", &MEIInput::ReadMRest },
+    { "mRpt", &MEIInput::ReadMRpt },
+    { "mRpt2", &MEIInput::ReadMRpt2 },
+    { "mSpace", &MEIInput::ReadMSpace },
+    { "multiRest", &MEIInput::ReadMultiRest },
+    { "multiRpt", &MEIInput::ReadMultiRpt },
+    { "plica", &MEIInput::ReadPlica },
+    { "proport", &MEIInput::ReadProport },
+    { "space", &MEIInput::ReadSpace },
+    { "stem", &MEIInput::ReadStem },
+    { "syl", &MEIInput::ReadSyl },
+    { "syllable", &MEIInput::ReadSyllable },
+    { "tabDurSym", &MEIInput::ReadTabDurSym },
+    { "tabGrp", &MEIInput::ReadTabGrp },
+    { "tuplet", &MEIInput::ReadTuplet },
+    { "verse", &MEIInput::ReadVerse }
+};
+
+const std::unordered_map<std::string_view, MEIInput::ChildReader> MEIInput::s_measureChildReaders = {
+    { "anchoredText", &MEIInput::ReadAnchoredText },
+    { "arpeg", &MEIInput::ReadArpeg },
+    { "beamSpan", &MEIInput::ReadBeamSpan },
+    { "bracketSpan", &MEIInput::ReadBracketSpan },
+    { "breath", &MEIInput::ReadBreath },
+    { "caesura", &MEIInput::ReadCaesura },
+    { "dir", &MEIInput::ReadDir },
+    { "dynam", &MEIInput::ReadDynam },
+    { "fermata", &MEIInput::ReadFermata },
+    { "fing", &MEIInput::ReadFing },
+    { "gliss", &MEIInput::ReadGliss },
+    { "hairpin", &MEIInput::ReadHairpin },
+    { "harm", &MEIInput::ReadHarm },
+    { "lv", &MEIInput::ReadLv },
+    { "mNum", &MEIInput::ReadMNum },
+    { "mordent", &MEIInput::ReadMordent },
+    { "octave", &MEIInput::ReadOctave },
+    { "pedal", &MEIInput::ReadPedal },
+    { "phrase", &MEIInput::ReadPhrase },
+    { "pitchInflection", &MEIInput::ReadPitchInflection },
+    { "reh", &MEIInput::ReadReh },
+    { "slur", &MEIInput::ReadSlur },
+    { "staff", &MEIInput::ReadStaff },
+    { "tempo", &MEIInput::ReadTempo },
+    { "tie", &MEIInput::ReadTie },
+    { "trill", &MEIInput::ReadTrill },
+    { "turn", &MEIInput::ReadTurn }
+};
 
 //----------------------------------------------------------------------------
 // MEIOutput
@@ -158,6 +233,8 @@ MEIOutput::MEIOutput(Doc *doc) : Output(doc)
     m_basic = false;
     m_ignoreHeader = false;
     m_removeIds = false;
+    m_stream = NULL;
+    m_outputFlags = pugi::format_default;
 
     this->Reset();
     this->ResetFilter();
@@ -166,6 +243,11 @@ MEIOutput::MEIOutput(Doc *doc) : Output(doc)
 MEIOutput::~MEIOutput() {}
 
 bool MEIOutput::Export()
+{
+    return this->Export(m_streamStringOutput);
+}
+
+bool MEIOutput::Export(std::ostream &stream)
 {
 
     if (m_removeIds) {
@@ -180,24 +262,18 @@ bool MEIOutput::Export()
     try {
         pugi::xml_document meiDoc;
 
-        if (this->HasFilter()) {
-            if (!this->IsScoreBasedMEI()) {
-                LogError("MEI output with filter is not possible in page-based MEI");
-                return false;
-            }
-            if (m_doc->IsMensuralMusicOnly()) {
-                LogError("MEI output with filter is not possible for mensural music");
-                return false;
-            }
-            if (!this->HasValidFilter()) {
-                LogError("Invalid filter, please check the input");
-                return false;
-            }
+        if (!this->CanExport()) return false;
+
+        m_outputFlags = pugi::format_default;
+        if (m_doc->GetOptions()->m_outputSmuflXmlEntities.GetValue()) {
+            m_outputFlags |= pugi::format_no_escapes;
         }
-        if (this->IsPageBasedMEI() && this->GetBasic()) {
-            LogError("MEI output in page-based MEI is not possible with MEI basic");
-            return false;
+        if (m_doc->GetOptions()->m_outputFormatRaw.GetValue()) {
+            m_outputFlags |= pugi::format_raw;
         }
+        m_outputIndent = (m_indent == -1) ? "\t" : std::string(m_indent, ' ');
+        m_stream = &stream;
+        m_streamedNodes.clear();
 
         // Saving the entire document
         // * With score-based MEI, all mdivs are saved
@@ -249,19 +325,14 @@ bool MEIOutput::Export()
 
         // Redo the mensural segment cast of if necessary
         m_doc->ConvertToCastOffMensuralDoc(true);
-        unsigned int output_flags = pugi::format_default;
-        if (m_doc->GetOptions()->m_outputSmuflXmlEntities.GetValue()) {
-            output_flags |= pugi::format_no_escapes;
-        }
-        if (m_doc->GetOptions()->m_outputFormatRaw.GetValue()) {
-            output_flags |= pugi::format_raw;
-        }
 
-        std::string indent = (m_indent == -1) ? "\t" : std::string(m_indent, ' ');
-        meiDoc.save(m_streamStringOutput, indent.c_str(), output_flags);
+        // Write what has not been streamed yet and the end tags of the elements still open
+        this->StreamChildren(meiDoc);
+        m_stream = NULL;
     }
     catch (char *str) {
         LogError("%s", str);
+        m_stream = NULL;
         return false;
     }
 
@@ -945,12 +1016,97 @@ bool MEIOutput::WriteObjectInternalEnd(Object *object)
     if (object->Is(DOC)) return true;
 
     assert(!m_nodeStack.empty());
+    pugi::xml_node node = m_nodeStack.back();
     m_nodeStack.pop_back();
     m_currentNode = m_nodeStack.back();
 
+    // Once complete, an element in a container (e.g., a measure in a section) can be written to the stream
+    if (m_stream && (node != m_currentNode) && this->IsStreamContainer(node.parent())) {
+        this->StreamNode(node);
+    }
+
     return true;
 }
 
+bool MEIOutput::IsStreamContainer(pugi::xml_node node) const
+{
+    if (node.type() != pugi::node_element) return false;
+
+    const std::string_view name = node.name();
+    return ((name == "mdiv") || (name == "score") || (name == "section") || (name == "ending") || (name == "pages")
+        || (name == "page") || (name == "system"));
+}
+
+void MEIOutput::StreamNode(pugi::xml_node node)
+{
+    assert(m_stream);
+
+    pugi::xml_node parent = node.parent();
+    this->StreamStartTag(parent);
+    this->StreamChildren(parent, node);
+
+    // The node has its start tag already written, so write its children and its end tag
+    auto isNode = [&node](const std::pair<pugi::xml_node, std::string> &streamedNode) {
+        return (streamedNode.first == node);
+    };
+    if (std::any_of(m_streamedNodes.begin(), m_streamedNodes.end(), isNode)) {
+        this->StreamChildren(node);
+        assert(m_streamedNodes.back().first == node);
+        (*m_stream) << m_streamedNodes.back().second;
+        m_streamedNodes.pop_back();
+    }
+    else {
+        node.print(*m_stream, m_outputIndent.c_str(), m_outputFlags, pugi::encoding_auto,
+            (unsigned int)m_streamedNodes.size());
+    }
+    parent.remove_child(node);
+}
+
+void MEIOutput::StreamStartTag(pugi::xml_node node)
+{
+    assert(m_stream);
+
+    if (node.type() == pugi::node_document) return;
+    auto isNode = [&node](const std::pair<pugi::xml_node, std::string> &streamedNode) {
+        return (streamedNode.first == node);
+    };
+    if (std::any_of(m_streamedNodes.begin(), m_streamedNodes.end(), isNode)) return;
+
+    pugi::xml_node parent = node.parent();
+    this->StreamStartTag(parent);
+    this->StreamChildren(parent, node);
+
+    // Print a copy of the node with a placeholder child for getting the tags as formatted by pugixml
+    pugi::xml_document tagDoc;
+    pugi::xml_node tag = tagDoc.append_child(node.name());
+    for (pugi::xml_attribute attribute : node.attributes()) {
+        tag.append_copy(attribute);
+    }
+    pugi::xml_node placeholder = tag.append_child(pugi::node_comment);
+    const unsigned int depth = (unsigned int)m_streamedNodes.size();
+    std::ostringstream tagStream;
+    tag.print(tagStream, m_outputIndent.c_str(), m_outputFlags, pugi::encoding_auto, depth);
+    std::ostringstream placeholderStream;
+    placeholder.print(placeholderStream, m_outputIndent.c_str(), m_outputFlags, pugi::encoding_auto, depth + 1);
+
+    const std::string tags = tagStream.str();
+    const std::string placeholderStr = placeholderStream.str();
+    const size_t pos = tags.rfind(placeholderStr);
+    assert(pos != std::string::npos);
+
+    (*m_stream) << tags.substr(0, pos);
+    m_streamedNodes.push_back({ node, tags.substr(pos + placeholderStr.size()) });
+}
+
+void MEIOutput::StreamChildren(pugi::xml_node node, pugi::xml_node until)
+{
+    pugi::xml_node child = node.first_child();
+    while (child && (child != until)) {
+        this->StreamNode(child);
+        child = node.first_child();
+    }
+}
+
 bool MEIOutput::HasFilter() const
 {
     return m_hasFilter;
@@ -1030,6 +1186,29 @@ bool MEIOutput::IsTreeObject(Object *object) const
     return !object->IsAttribute();
 }
 
+bool MEIOutput::CanExport() const
+{
+    if (this->HasFilter()) {
+        if (!this->IsScoreBasedMEI()) {
+            LogError("MEI output with filter is not possible in page-based MEI");
+            return false;
+        }
+        if (m_doc->IsMensuralMusicOnly()) {
+            LogError("MEI output with filter is not possible for mensural music");
+            return false;
+        }
+        if (!this->HasValidFilter()) {
+            LogError("Invalid filter, please check the input");
+            return false;
+        }
+    }
+    if (this->IsPageBasedMEI() && this->GetBasic()) {
+        LogError("MEI output in page-based MEI is not possible with MEI basic");
+        return false;
+    }
+    return true;
+}
+
 bool MEIOutput::HasValidFilter() const
 {
     // Verify page filter
@@ -3178,12 +3357,19 @@ MEIInput::MEIInput(Doc *doc) : Input(doc)
 MEIInput::~MEIInput() {}
 
 bool MEIInput::Import(const std::string &mei)
+{
+    std::string buffer(mei);
+    return this->ImportInPlace(buffer);
+}
+
+bool MEIInput::ImportInPlace(std::string &mei)
 {
     try {
         m_doc->Reset();
         m_doc->SetType(Raw);
         pugi::xml_document doc;
-        doc.load_string(mei.c_str(), (pugi::parse_comments | pugi::parse_default) & ~pugi::parse_eol);
+        doc.load_buffer_inplace(&mei[0], mei.size(), (pugi::parse_comments | pugi::parse_default) & ~pugi::parse_eol,
+            pugi::encoding_utf8);
         pugi::xml_node root = doc.first_child();
         return this->ReadDoc(root);
     }
@@ -3821,11 +4007,11 @@ bool MEIInput::ReadPages(Object *parent, pugi::xml_node pages)
     for (current = pages.first_child(); current; current = current.next_sibling()) {
         if (!success) break;
         // page
-        if (std::string(current.name()) == "page") {
+        if (std::string_view(current.name()) == "page") {
             success = this->ReadPage(vrvPages, current);
         }
         // xml comment
-        else if (std::string(current.name()) == "") {
+        else if (std::string_view(current.name()) == "") {
             success = this->ReadXMLComment(parent, current);
         }
         else {
@@ -3903,24 +4089,24 @@ bool MEIInput::ReadPageChildren(Object *parent, pugi::xml_node parentNode)
 
     pugi::xml_node current;
     for (current = parentNode.first_child(); current; current = current.next_sibling()) {
-        if (std::string(current.name()) == "mdiv") {
+        if (std::string_view(current.name()) == "mdiv") {
             this->ReadMdiv(parent, current, true);
         }
-        else if (std::string(current.name()) == "score") {
+        else if (std::string_view(current.name()) == "score") {
             this->ReadScore(parent, current);
         }
-        else if (std::string(current.name()) == "system") {
+        else if (std::string_view(current.name()) == "system") {
             this->ReadSystem(parent, current);
         }
         // mdiv in page-based MEI
-        else if (std::string(current.name()) == "mdivb") {
+        else if (std::string_view(current.name()) == "mdivb") {
             this->ReadMdiv(parent, current, true);
         }
-        else if (std::string(current.name()) == "milestoneEnd") {
+        else if (std::string_view(current.name()) == "milestoneEnd") {
             this->ReadPageMilestoneEnd(parent, current);
         }
         // xml comment
-        else if (std::string(current.name()) == "") {
+        else if (std::string_view(current.name()) == "") {
             this->ReadXMLComment(parent, current);
         }
         else {
@@ -3999,10 +4185,10 @@ bool MEIInput::ReadMdivChildren(Object *parent, pugi::xml_node parentNode, bool
         // We make the mdiv visible if already set or if matching the desired selection
         bool makeVisible = (isVisible || (m_selectedMdiv == current));
         if (!success) break;
-        if (std::string(current.name()) == "mdiv") {
+        if (std::string_view(current.name()) == "mdiv") {
             success = this->ReadMdiv(parent, current, makeVisible);
         }
-        else if (std::string(current.name()) == "score") {
+        else if (std::string_view(current.name()) == "score") {
             success = this->ReadScore(parent, current);
             if (parentNode.last_child() != current) {
                 LogWarning("Skipping nodes after <score> element");
@@ -4010,7 +4196,7 @@ bool MEIInput::ReadMdivChildren(Object *parent, pugi::xml_node parentNode, bool
             break;
         }
         // xml comment
-        else if (std::string(current.name()) == "") {
+        else if (std::string_view(current.name()) == "") {
             success = this->ReadXMLComment(parent, current);
         }
         else {
@@ -4069,7 +4255,7 @@ bool MEIInput::ReadScore(Object *parent, pugi::xml_node score)
             success = this->ReadPb(vrvScore, current);
         }
         // xml comment
-        else if (std::string(current.name()) == "") {
+        else if (std::string_view(current.name()) == "") {
             success = this->ReadXMLComment(parent, current);
         }
         else {
@@ -4116,29 +4302,29 @@ bool MEIInput::ReadSectionChildren(Object *parent, pugi::xml_node parentNode)
             success = this->ReadEditorialElement(parent, current, EDITORIAL_TOPLEVEL);
         }
         // content
-        else if (std::string(current.name()) == "ending") {
+        else if (std::string_view(current.name()) == "ending") {
             // we should not endings with unmeasured music ... (?)
             assert(!unmeasured);
             success = this->ReadEnding(parent, current);
         }
-        else if (std::string(current.name()) == "expansion") {
+        else if (std::string_view(current.name()) == "expansion") {
             success = this->ReadExpansion(parent, current);
         }
-        else if (std::string(current.name()) == "scoreDef") {
+        else if (std::string_view(current.name()) == "scoreDef") {
             success = this->ReadScoreDef(parent, current);
         }
-        else if (std::string(current.name()) == "section") {
+        else if (std::string_view(current.name()) == "section") {
             success = this->ReadSection(parent, current);
         }
         // pb and sb
-        else if (std::string(current.name()) == "pb") {
+        else if (std::string_view(current.name()) == "pb") {
             success = this->ReadPb(parent, current);
         }
-        else if (std::string(current.name()) == "sb") {
+        else if (std::string_view(current.name()) == "sb") {
             success = this->ReadSb(parent, current);
         }
         // unmeasured music
-        else if (std::string(current.name()) == "staff") {
+        else if (std::string_view(current.name()) == "staff") {
             if (!unmeasured) {
                 if (parent->Is(SECTION)) {
                     unmeasured = new Measure(false);
@@ -4152,7 +4338,7 @@ bool MEIInput::ReadSectionChildren(Object *parent, pugi::xml_node parentNode)
             }
             success = this->ReadStaff(unmeasured, current);
         }
-        else if (std::string(current.name()) == "measure") {
+        else if (std::string_view(current.name()) == "measure") {
             // we should not mix measured and unmeasured music within a system...
             assert(!unmeasured);
             // if (parent->IsEditorialElement()) {
@@ -4161,7 +4347,7 @@ bool MEIInput::ReadSectionChildren(Object *parent, pugi::xml_node parentNode)
             success = this->ReadMeasure(parent, current);
         }
         // xml comment
-        else if (std::string(current.name()) == "") {
+        else if (std::string_view(current.name()) == "") {
             success = this->ReadXMLComment(parent, current);
         }
         else {
@@ -4282,24 +4468,24 @@ bool MEIInput::ReadSystemChildren(Object *parent, pugi::xml_node parentNode)
             success = this->ReadEditorialElement(parent, current, EDITORIAL_TOPLEVEL);
         }
         // section
-        else if (std::string(current.name()) == "section") {
+        else if (std::string_view(current.name()) == "section") {
             success = this->ReadSection(parent, current);
         }
         // section in page-based MEI
-        else if (std::string(current.name()) == "secb") {
+        else if (std::string_view(current.name()) == "secb") {
             success = this->ReadSection(parent, current);
         }
-        else if (std::string(current.name()) == "milestoneEnd") {
+        else if (std::string_view(current.name()) == "milestoneEnd") {
             success = this->ReadSystemMilestoneEnd(parent, current);
         }
         // content
-        else if (std::string(current.name()) == "scoreDef") {
+        else if (std::string_view(current.name()) == "scoreDef") {
             // we should not have scoredef with unmeasured music within a system... (?)
             assert(!unmeasured);
             this->ReadScoreDef(parent, current);
         }
         // unmeasured music
-        else if (std::string(current.name()) == "staff") {
+        else if (std::string_view(current.name()) == "staff") {
             if (!unmeasured) {
                 if (parent->Is(SYSTEM)) {
                     System *system = vrv_cast<System *>(parent);
@@ -4318,13 +4504,13 @@ bool MEIInput::ReadSystemChildren(Object *parent, pugi::xml_node parentNode)
             }
             success = this->ReadStaff(unmeasured, current);
         }
-        else if (std::string(current.name()) == "measure") {
+        else if (std::string_view(current.name()) == "measure") {
             // we should not mix measured and unmeasured music within a system...
             assert(!unmeasured);
             success = this->ReadMeasure(parent, current);
         }
         // xml comment
-        else if (std::string(current.name()) == "") {
+        else if (std::string_view(current.name()) == "") {
             success = this->ReadXMLComment(parent, current);
         }
         else {
@@ -4516,43 +4702,43 @@ bool MEIInput::ReadScoreDefChildren(Object *parent, pugi::xml_node parentNode)
             success = this->ReadEditorialElement(parent, current, EDITORIAL_SCOREDEF);
         }
         // clef, keySig, etc.
-        else if (std::string(current.name()) == "clef") {
+        else if (std::string_view(current.name()) == "clef") {
             success = this->ReadClef(parent, current);
         }
-        else if (std::string(current.name()) == "grpSym") {
+        else if (std::string_view(current.name()) == "grpSym") {
             success = this->ReadGrpSym(parent, current);
         }
-        else if (std::string(current.name()) == "keySig") {
+        else if (std::string_view(current.name()) == "keySig") {
             success = this->ReadKeySig(parent, current);
         }
-        else if (std::string(current.name()) == "mensur") {
+        else if (std::string_view(current.name()) == "mensur") {
             success = this->ReadMensur(parent, current);
         }
-        else if (std::string(current.name()) == "meterSig") {
+        else if (std::string_view(current.name()) == "meterSig") {
             success = this->ReadMeterSig(parent, current);
         }
-        else if (std::string(current.name()) == "meterSigGrp") {
+        else if (std::string_view(current.name()) == "meterSigGrp") {
             success = this->ReadMeterSigGrp(parent, current);
         }
         // headers and footers
-        else if (std::string(current.name()) == "pgFoot") {
+        else if (std::string_view(current.name()) == "pgFoot") {
             success = this->ReadPgFoot(parent, current);
         }
-        else if (std::string(current.name()) == "pgFoot2") {
+        else if (std::string_view(current.name()) == "pgFoot2") {
             success = this->ReadPgFoot2(parent, current);
         }
-        else if (std::string(current.name()) == "pgHead") {
+        else if (std::string_view(current.name()) == "pgHead") {
             success = this->ReadPgHead(parent, current);
         }
-        else if (std::string(current.name()) == "pgHead2") {
+        else if (std::string_view(current.name()) == "pgHead2") {
             success = this->ReadPgHead2(parent, current);
         }
         // content
-        else if (std::string(current.name()) == "staffGrp") {
+        else if (std::string_view(current.name()) == "staffGrp") {
             success = this->ReadStaffGrp(parent, current);
         }
         // xml comment
-        else if (std::string(current.name()) == "") {
+        else if (std::string_view(current.name()) == "") {
             success = this->ReadXMLComment(parent, current);
         }
         else {
@@ -4608,28 +4794,28 @@ bool MEIInput::ReadStaffGrpChildren(Object *parent, pugi::xml_node parentNode)
             success = this->ReadEditorialElement(parent, current, EDITORIAL_STAFFGRP);
         }
         // content
-        else if (std::string(current.name()) == "grpSym") {
+        else if (std::string_view(current.name()) == "grpSym") {
             success = this->ReadGrpSym(parent, current);
         }
-        else if (std::string(current.name()) == "instrDef") {
+        else if (std::string_view(current.name()) == "instrDef") {
             success = this->ReadInstrDef(parent, current);
         }
-        else if (std::string(current.name()) == "label") {
+        else if (std::string_view(current.name()) == "label") {
             success = this->ReadLabel(parent, current);
         }
-        else if (std::string(current.name()) == "labelAbbr") {
+        else if (std::string_view(current.name()) == "labelAbbr") {
             success = this->ReadLabelAbbr(parent, current);
         }
-        else if (std::string(current.name()) == "staffGrp") {
+        else if (std::string_view(current.name()) == "staffGrp") {
             success = this->ReadStaffGrp(parent, current);
             missingStaffDef = false; // innermost staffGrp child will report missing staffDef
         }
-        else if (std::string(current.name()) == "staffDef") {
+        else if (std::string_view(current.name()) == "staffDef") {
             success = this->ReadStaffDef(parent, current);
             missingStaffDef = false;
         }
         // xml comment
-        else if (std::string(current.name()) == "") {
+        else if (std::string_view(current.name()) == "") {
             success = this->ReadXMLComment(parent, current);
         }
         else {
@@ -4804,39 +4990,39 @@ bool MEIInput::ReadStaffDefChildren(Object *parent, pugi::xml_node parentNode)
     for (current = parentNode.first_child(); current; current = current.next_sibling()) {
         if (!success) break;
         // clef, keySig, etc.
-        else if (std::string(current.name()) == "clef") {
+        else if (std::string_view(current.name()) == "clef") {
             success = this->ReadClef(parent, current);
         }
-        else if (std::string(current.name()) == "keySig") {
+        else if (std::string_view(current.name()) == "keySig") {
             success = this->ReadKeySig(parent, current);
         }
-        else if (std::string(current.name()) == "mensur") {
+        else if (std::string_view(current.name()) == "mensur") {
             success = this->ReadMensur(parent, current);
         }
-        else if (std::string(current.name()) == "meterSig") {
+        else if (std::string_view(current.name()) == "meterSig") {
             success = this->ReadMeterSig(parent, current);
         }
-        else if (std::string(current.name()) == "meterSigGrp") {
+        else if (std::string_view(current.name()) == "meterSigGrp") {
             success = this->ReadMeterSigGrp(parent, current);
         }
         // content
-        else if (std::string(current.name()) == "instrDef") {
+        else if (std::string_view(current.name()) == "instrDef") {
             success = this->ReadInstrDef(parent, current);
         }
-        else if (std::string(current.name()) == "label") {
+        else if (std::string_view(current.name()) == "label") {
             success = this->ReadLabel(parent, current);
         }
-        else if (std::string(current.name()) == "labelAbbr") {
+        else if (std::string_view(current.name()) == "labelAbbr") {
             success = this->ReadLabelAbbr(parent, current);
         }
-        else if (std::string(current.name()) == "layerDef") {
+        else if (std::string_view(current.name()) == "layerDef") {
             success = this->ReadLayerDef(parent, current);
         }
-        else if (std::string(current.name()) == "tuning") {
+        else if (std::string_view(current.name()) == "tuning") {
             success = this->ReadTuning(parent, current);
         }
         // xml comment
-        else if (std::string(current.name()) == "") {
+        else if (std::string_view(current.name()) == "") {
             success = this->ReadXMLComment(parent, current);
         }
         else {
@@ -4869,7 +5055,7 @@ bool MEIInput::ReadTuningChildren(Object *parent, pugi::xml_node parentNode)
     for (current = parentNode.first_child(); current; current = current.next_sibling()) {
         if (!success) break;
         // content
-        else if (std::string(current.name()) == "course") {
+        else if (std::string_view(current.name()) == "course") {
             success = this->ReadCourse(parent, current);
         }
         else {
@@ -5020,94 +5206,17 @@ bool MEIInput::ReadMeasureChildren(Object *parent, pugi::xml_node parentNode)
     bool success = true;
     pugi::xml_node current;
     for (current = parentNode.first_child(); current; current = current.next_sibling()) {
-        const std::string currentName = current.name();
+        const std::string_view currentName = current.name();
         if (!success) break;
         this->NormalizeAttributes(current);
+        const auto reader = s_measureChildReaders.find(currentName);
         // editorial
         if (this->IsEditorialElementName(currentName)) {
             success = this->ReadEditorialElement(parent, current, EDITORIAL_MEASURE);
         }
         // content
-        else if (currentName == "anchoredText") {
-            success = this->ReadAnchoredText(parent, current);
-        }
-        else if (currentName == "arpeg") {
-            success = this->ReadArpeg(parent, current);
-        }
-        else if (currentName == "beamSpan") {
-            success = this->ReadBeamSpan(parent, current);
-        }
-        else if (currentName == "bracketSpan") {
-            success = this->ReadBracketSpan(parent, current);
-        }
-        else if (currentName == "breath") {
-            success = this->ReadBreath(parent, current);
-        }
-        else if (currentName == "caesura") {
-            success = this->ReadCaesura(parent, current);
-        }
-        else if (currentName == "dir") {
-            success = this->ReadDir(parent, current);
-        }
-        else if (currentName == "dynam") {
-            success = this->ReadDynam(parent, current);
-        }
-        else if (currentName == "fermata") {
-            success = this->ReadFermata(parent, current);
-        }
-        else if (currentName == "fing") {
-            success = this->ReadFing(parent, current);
-        }
-        else if (currentName == "gliss") {
-            success = this->ReadGliss(parent, current);
-        }
-        else if (currentName == "hairpin") {
-            success = this->ReadHairpin(parent, current);
-        }
-        else if (currentName == "harm") {
-            success = this->ReadHarm(parent, current);
-        }
-        else if (currentName == "lv") {
-            success = this->ReadLv(parent, current);
-        }
-        else if (currentName == "mNum") {
-            success = this->ReadMNum(parent, current);
-        }
-        else if (currentName == "mordent") {
-            success = this->ReadMordent(parent, current);
-        }
-        else if (currentName == "octave") {
-            success = this->ReadOctave(parent, current);
-        }
-        else if (currentName == "pedal") {
-            success = this->ReadPedal(parent, current);
-        }
-        else if (currentName == "phrase") {
-            success = this->ReadPhrase(parent, current);
-        }
-        else if (currentName == "pitchInflection") {
-            success = this->ReadPitchInflection(parent, current);
-        }
-        else if (currentName == "reh") {
-            success = this->ReadReh(parent, current);
-        }
-        else if (currentName == "slur") {
-            success = this->ReadSlur(parent, current);
-        }
-        else if (currentName == "staff") {
-            success = this->ReadStaff(parent, current);
-        }
-        else if (currentName == "tempo") {
-            success = this->ReadTempo(parent, current);
-        }
-        else if (currentName == "tie") {
-            success = this->ReadTie(parent, current);
-        }
-        else if (currentName == "trill") {
-            success = this->ReadTrill(parent, current);
-        }
-        else if (currentName == "turn") {
-            success = this->ReadTurn(parent, current);
+        else if (reader != s_measureChildReaders.end()) {
+            success = (this->*reader->second)(parent, current);
         }
         else if (currentName == "tupletSpan") {
             if (!ReadTupletSpanAsTuplet(dynamic_cast<Measure *>(parent), current)) {
@@ -5151,11 +5260,11 @@ bool MEIInput::ReadMeterSigGrpChildren(Object *parent, pugi::xml_node parentNode
     for (current = parentNode.first_child(); current; current = current.next_sibling()) {
         if (!success) break;
         // content
-        else if (std::string(current.name()) == "meterSig") {
+        else if (std::string_view(current.name()) == "meterSig") {
             success = this->ReadMeterSig(parent, current);
         }
         // xml comment
-        else if (std::string(current.name()) == "") {
+        else if (std::string_view(current.name()) == "") {
             success = this->ReadXMLComment(parent, current);
         }
         else {
@@ -5621,11 +5730,11 @@ bool MEIInput::ReadFbChildren(Object *parent, pugi::xml_node parentNode)
             success = this->ReadEditorialElement(parent, current, EDITORIAL_FB);
         }
         // content
-        else if (std::string(current.name()) == "f") {
+        else if (std::string_view(current.name()) == "f") {
             success = this->ReadF(parent, current);
         }
         // xml comment
-        else if (std::string(current.name()) == "") {
+        else if (std::string_view(current.name()) == "") {
             success = this->ReadXMLComment(parent, current);
         }
         else {
@@ -5677,11 +5786,11 @@ bool MEIInput::ReadStaffChildren(Object *parent, pugi::xml_node parentNode)
             success = this->ReadEditorialElement(parent, current, EDITORIAL_STAFF);
         }
         // content
-        else if (std::string(current.name()) == "layer") {
+        else if (std::string_view(current.name()) == "layer") {
             success = this->ReadLayer(parent, current);
         }
         // xml comment
-        else if (std::string(current.name()) == "") {
+        else if (std::string_view(current.name()) == "") {
             success = this->ReadXMLComment(parent, current);
         }
         else {
@@ -5717,14 +5826,15 @@ bool MEIInput::ReadLayerChildren(Object *parent, pugi::xml_node parentNode, Obje
 {
     bool success = true;
     pugi::xml_node xmlElement;
-    std::string elementName;
+    std::string_view elementName;
     for (xmlElement = parentNode.first_child(); xmlElement; xmlElement = xmlElement.next_sibling()) {
         if (!success) break;
         this->NormalizeAttributes(xmlElement);
 
-        elementName = std::string(xmlElement.name());
+        elementName = xmlElement.name();
+        const auto reader = s_layerChildReaders.find(elementName);
         // LogDebug("ReadLayerChildren: element <%s>", xmlElement.name());
-        if (!this->IsAllowed(elementName, filter)) {
+        if (filter && !this->IsAllowed(std::string(elementName), filter)) {
             std::string meiElementName = filter->GetClassName();
             std::transform(meiElementName.begin(), meiElementName.begin() + 1, meiElementName.begin(), ::tolower);
             LogWarning("Element <%s> within <%s> is not supported and will be ignored ", xmlElement.name(),
@@ -5732,135 +5842,15 @@ bool MEIInput::ReadLayerChildren(Object *parent, pugi::xml_node parentNode, Obje
             continue;
         }
         // editorial
-        else if (this->IsEditorialElementName(xmlElement.name())) {
+        else if (this->IsEditorialElementName(elementName)) {
             success = this->ReadEditorialElement(parent, xmlElement, EDITORIAL_LAYER, filter);
         }
         // content
-        else if (elementName == "accid") {
-            success = this->ReadAccid(parent, xmlElement);
-        }
-        else if (elementName == "artic") {
-            success = this->ReadArtic(parent, xmlElement);
-        }
-        else if (elementName == "barLine") {
-            success = this->ReadBarLine(parent, xmlElement);
-        }
-        else if (elementName == "beam") {
-            success = this->ReadBeam(parent, xmlElement);
-        }
-        else if (elementName == "beatRpt") {
-            success = this->ReadBeatRpt(parent, xmlElement);
-        }
-        else if (elementName == "bTrem") {
-            success = this->ReadBTrem(parent, xmlElement);
-        }
-        else if (elementName == "chord") {
-            success = this->ReadChord(parent, xmlElement);
-        }
-        else if (elementName == "clef") {
-            success = this->ReadClef(parent, xmlElement);
-        }
-        else if (elementName == "custos") {
-            success = this->ReadCustos(parent, xmlElement);
-        }
-        else if (elementName == "dot") {
-            success = this->ReadDot(parent, xmlElement);
-        }
-        else if (elementName == "fTrem") {
-            success = this->ReadFTrem(parent, xmlElement);
-        }
-        else if (elementName == "graceGrp") {
-            success = this->ReadGraceGrp(parent, xmlElement);
-        }
-        else if (elementName == "halfmRpt") {
-            success = this->ReadHalfmRpt(parent, xmlElement);
-        }
-        else if (elementName == "keyAccid") {
-            success = this->ReadKeyAccid(parent, xmlElement);
-        }
-        else if (elementName == "keySig") {
-            success = this->ReadKeySig(parent, xmlElement);
-        }
-        else if (elementName == "label") {
-            success = this->ReadLabel(parent, xmlElement);
-        }
-        else if (elementName == "labelAbbr") {
-            success = this->ReadLabelAbbr(parent, xmlElement);
-        }
-        else if (elementName == "ligature") {
-            success = this->ReadLigature(parent, xmlElement);
-        }
-        else if (elementName == "mensur") {
-            success = this->ReadMensur(parent, xmlElement);
-        }
-        else if (elementName == "meterSig") {
-            success = this->ReadMeterSig(parent, xmlElement);
-        }
-        else if (elementName == "meterSigGrp") {
-            success = this->ReadMeterSigGrp(parent, xmlElement);
-        }
-        else if (elementName == "nc") {
-            success = this->ReadNc(parent, xmlElement);
-        }
-        else if (elementName == "neume") {
-            success = this->ReadNeume(parent, xmlElement);
-        }
-        else if (elementName == "note") {
-            success = this->ReadNote(parent, xmlElement);
-        }
-        else if (elementName == "rest") {
-            success = this->ReadRest(parent, xmlElement);
-        }
-        else if (elementName == "mRest") {
-            success = this->ReadMRest(parent, xmlElement);
-        }
-        else if (elementName == "mRpt") {
-            success = this->ReadMRpt(parent, xmlElement);
-        }
-        else if (elementName == "mRpt2") {
-            success = this->ReadMRpt2(parent, xmlElement);
-        }
-        else if (elementName == "mSpace") {
-            success = this->ReadMSpace(parent, xmlElement);
-        }
-        else if (elementName == "multiRest") {
-            success = this->ReadMultiRest(parent, xmlElement);
-        }
-        else if (elementName == "multiRpt") {
-            success = this->ReadMultiRpt(parent, xmlElement);
-        }
-        else if (elementName == "plica") {
-            success = this->ReadPlica(parent, xmlElement);
-        }
-        else if (elementName == "proport") {
-            success = this->ReadProport(parent, xmlElement);
-        }
-        else if (elementName == "space") {
-            success = this->ReadSpace(parent, xmlElement);
-        }
-        else if (elementName == "stem") {
-            success = this->ReadStem(parent, xmlElement);
-        }
-        else if (elementName == "syl") {
-            success = this->ReadSyl(parent, xmlElement);
-        }
-        else if (elementName == "syllable") {
-            success = this->ReadSyllable(parent, xmlElement);
-        }
-        else if (elementName == "tabDurSym") {
-            success = this->ReadTabDurSym(parent, xmlElement);
-        }
-        else if (elementName == "tabGrp") {
-            success = this->ReadTabGrp(parent, xmlElement);
-        }
-        else if (elementName == "tuplet") {
-            success = this->ReadTuplet(parent, xmlElement);
-        }
-        else if (elementName == "verse") {
-            success = this->ReadVerse(parent, xmlElement);
+        else if (reader != s_layerChildReaders.end()) {
+            success = (this->*reader->second)(parent, xmlElement);
         }
         // xml comment
-        else if (elementName == "") {
+        else if (elementName.empty()) {
             success = this->ReadXMLComment(parent, xmlElement);
         }
         // unknown
@@ -6842,55 +6832,55 @@ void MEIInput::ReadUnsupportedAttr(pugi::xml_node element, Object *object)
 
 bool MEIInput::ReadEditorialElement(Object *parent, pugi::xml_node current, EditorialLevel level, Object *filter)
 {
-    if (std::string(current.name()) == "abbr") {
+    if (std::string_view(current.name()) == "abbr") {
         return this->ReadAbbr(parent, current, level, filter);
     }
-    else if (std::string(current.name()) == "add") {
+    else if (std::string_view(current.name()) == "add") {
         return this->ReadAdd(parent, current, level, filter);
     }
-    else if (std::string(current.name()) == "app") {
+    else if (std::string_view(current.name()) == "app") {
         return this->ReadApp(parent, current, level, filter);
     }
-    else if (std::string(current.name()) == "annot") {
+    else if (std::string_view(current.name()) == "annot") {
         return this->ReadAnnot(parent, current);
     }
-    else if (std::string(current.name()) == "choice") {
+    else if (std::string_view(current.name()) == "choice") {
         return this->ReadChoice(parent, current, level, filter);
     }
-    else if (std::string(current.name()) == "corr") {
+    else if (std::string_view(current.name()) == "corr") {
         return this->ReadCorr(parent, current, level, filter);
     }
-    else if (std::string(current.name()) == "damage") {
+    else if (std::string_view(current.name()) == "damage") {
         return this->ReadDamage(parent, current, level, filter);
     }
-    else if (std::string(current.name()) == "del") {
+    else if (std::string_view(current.name()) == "del") {
         return this->ReadDel(parent, current, level, filter);
     }
-    else if (std::string(current.name()) == "expan") {
+    else if (std::string_view(current.name()) == "expan") {
         return this->ReadExpan(parent, current, level, filter);
     }
-    else if (std::string(current.name()) == "orig") {
+    else if (std::string_view(current.name()) == "orig") {
         return this->ReadOrig(parent, current, level, filter);
     }
-    else if (std::string(current.name()) == "ref") {
+    else if (std::string_view(current.name()) == "ref") {
         return this->ReadRef(parent, current, level, filter);
     }
-    else if (std::string(current.name()) == "reg") {
+    else if (std::string_view(current.name()) == "reg") {
         return this->ReadReg(parent, current, level, filter);
     }
-    else if (std::string(current.name()) == "restore") {
+    else if (std::string_view(current.name()) == "restore") {
         return this->ReadRestore(parent, current, level, filter);
     }
-    else if (std::string(current.name()) == "sic") {
+    else if (std::string_view(current.name()) == "sic") {
         return this->ReadSic(parent, current, level, filter);
     }
-    else if (std::string(current.name()) == "subst") {
+    else if (std::string_view(current.name()) == "subst") {
         return this->ReadSubst(parent, current, level, filter);
     }
-    else if (std::string(current.name()) == "supplied") {
+    else if (std::string_view(current.name()) == "supplied") {
         return this->ReadSupplied(parent, current, level, filter);
     }
-    else if (std::string(current.name()) == "unclear") {
+    else if (std::string_view(current.name()) == "unclear") {
         return this->ReadUnclear(parent, current, level, filter);
     }
     else {
@@ -6994,14 +6984,14 @@ bool MEIInput::ReadAppChildren(Object *parent, pugi::xml_node parentNode, Editor
     pugi::xml_node current;
     for (current = parentNode.first_child(); current; current = current.next_sibling()) {
         if (!success) break;
-        if (std::string(current.name()) == "lem") {
+        if (std::string_view(current.name()) == "lem") {
             success = this->ReadLem(parent, current, level, filter);
         }
-        else if (std::string(current.name()) == "rdg") {
+        else if (std::string_view(current.name()) == "rdg") {
             success = this->ReadRdg(parent, current, level, filter);
         }
         // xml comment
-        else if (std::string(current.name()) == "") {
+        else if (std::string_view(current.name()) == "") {
             success = this->ReadXMLComment(parent, current);
         }
         else {
@@ -7065,35 +7055,35 @@ bool MEIInput::ReadChoiceChildren(Object *parent, pugi::xml_node parentNode, Edi
     pugi::xml_node current;
     for (current = parentNode.first_child(); current; current = current.next_sibling()) {
         if (!success) break;
-        if (std::string(current.name()) == "abbr") {
+        if (std::string_view(current.name()) == "abbr") {
             success = this->ReadAbbr(parent, current, level, filter);
         }
-        else if (std::string(current.name()) == "choice") {
+        else if (std::string_view(current.name()) == "choice") {
             success = this->ReadChoice(parent, current, level, filter);
         }
-        else if (std::string(current.name()) == "corr") {
+        else if (std::string_view(current.name()) == "corr") {
             success = this->ReadCorr(parent, current, level, filter);
         }
-        else if (std::string(current.name()) == "expan") {
+        else if (std::string_view(current.name()) == "expan") {
             success = this->ReadExpan(parent, current, level, filter);
         }
-        else if (std::string(current.name()) == "orig") {
+        else if (std::string_view(current.name()) == "orig") {
             success = this->ReadOrig(parent, current, level, filter);
         }
-        else if (std::string(current.name()) == "ref") {
+        else if (std::string_view(current.name()) == "ref") {
             success = this->ReadRef(parent, current, level, filter);
         }
-        else if (std::string(current.name()) == "reg") {
+        else if (std::string_view(current.name()) == "reg") {
             success = this->ReadReg(parent, current, level, filter);
         }
-        else if (std::string(current.name()) == "sic") {
+        else if (std::string_view(current.name()) == "sic") {
             success = this->ReadSic(parent, current, level, filter);
         }
-        else if (std::string(current.name()) == "unclear") {
+        else if (std::string_view(current.name()) == "unclear") {
             success = this->ReadUnclear(parent, current, level, filter);
         }
         // xml comment
-        else if (std::string(current.name()) == "") {
+        else if (std::string_view(current.name()) == "") {
             success = this->ReadXMLComment(parent, current);
         }
         else {
@@ -7298,17 +7288,17 @@ bool MEIInput::ReadSubstChildren(Object *parent, pugi::xml_node parentNode, Edit
     pugi::xml_node current;
     for (current = parentNode.first_child(); current; current = current.next_sibling()) {
         if (!success) break;
-        if (std::string(current.name()) == "add") {
+        if (std::string_view(current.name()) == "add") {
             success = this->ReadAdd(parent, current, level, filter);
         }
-        else if (std::string(current.name()) == "del") {
+        else if (std::string_view(current.name()) == "del") {
             success = this->ReadDel(parent, current, level, filter);
         }
-        else if (std::string(current.name()) == "subst") {
+        else if (std::string_view(current.name()) == "subst") {
             success = this->ReadSubst(parent, current, level, filter);
         }
         // xml comment
-        else if (std::string(current.name()) == "") {
+        else if (std::string_view(current.name()) == "") {
             success = this->ReadXMLComment(parent, current);
         }
         else {
@@ -7560,11 +7550,9 @@ bool MEIInput::ReadXMLComment(Object *object, pugi::xml_node element)
     return true;
 }
 
-bool MEIInput::IsEditorialElementName(std::string elementName)
+bool MEIInput::IsEditorialElementName(std::string_view elementName)
 {
-    auto i = std::find(MEIInput::s_editorialElementNames.begin(), MEIInput::s_editorialElementNames.end(), elementName);
-    if (i != MEIInput::s_editorialElementNames.end()) return true;
-    return false;
+    return (MEIInput::s_editorialElementNames.count(elementName) > 0);
 }
 
 void MEIInput::NormalizeAttributes(pugi::xml_node &xmlElement)
@@ -114,12 +114,18 @@ MusicXmlInput::~MusicXmlInput() {}
 #ifndef NO_MUSICXML_SUPPORT
 
 bool MusicXmlInput::Import(const std::string &musicxml)
+{
+    std::string buffer(musicxml);
+    return this->ImportInPlace(buffer);
+}
+
+bool MusicXmlInput::ImportInPlace(std::string &musicxml)
 {
     try {
         m_doc->Reset();
         m_doc->SetType(Raw);
         pugi::xml_document xmlDoc;
-        xmlDoc.load_string(musicxml.c_str());
+        xmlDoc.load_buffer_inplace(&musicxml[0], musicxml.size(), pugi::parse_default, pugi::encoding_utf8);
         pugi::xml_node root = xmlDoc.first_child();
         return ReadMusicXml(root);
     }
@@ -173,9 +179,15 @@ std::string MusicXmlInput::GetContent(const pugi::xml_node node) const
     return "";
 }
 
+const pugi::xpath_query &MusicXmlInput::GetXPathQuery(const std::string &expression) const
+{
+    // The query is only constructed if the expression is not already in the map
+    return m_xpathQueries.try_emplace(expression, expression.c_str()).first->second;
+}
+
 std::string MusicXmlInput::GetContentOfChild(const pugi::xml_node node, const std::string &child) const
 {
-    pugi::xpath_node childNode = node.select_node(child.c_str());
+    pugi::xpath_node childNode = node.select_node(GetXPathQuery(child));
     if (childNode.node()) {
         return GetContent(childNode.node());
     }
@@ -187,8 +199,7 @@ void MusicXmlInput::ProcessClefChangeQueue(Section *section)
     while (!m_clefChangeQueue.empty()) {
         musicxml::ClefChange clefChange = m_clefChangeQueue.front();
         m_clefChangeQueue.pop();
-        AttNNumberLikeComparison comparisonMeasure(MEASURE, clefChange.m_measureNum);
-        Measure *currentMeasure = vrv_cast<Measure *>(section->FindDescendantByComparison(&comparisonMeasure));
+        Measure *currentMeasure = GetSectionMeasure(clefChange.m_measureNum);
         if (!currentMeasure) {
             LogWarning("MusicXML import: Clef change at measure %s, staff %d, time %d not inserted",
                 clefChange.m_measureNum.c_str(), clefChange.m_staff->GetN(), clefChange.m_scoreOnset);
@@ -345,13 +356,14 @@ void MusicXmlInput::AddMeasure(Section *section, Measure *measure, int i)
     assert(i >= 0);
 
     // we just need to add a measure
-    if (section->GetChildCount(MEASURE) <= i - GetMrestMeasuresCountBeforeIndex(i)) {
+    if (m_sectionMeasureCount <= i - GetMrestMeasuresCountBeforeIndex(i)) {
         section->AddChild(measure);
+        ++m_sectionMeasureCount;
+        m_sectionMeasures.emplace(measure->GetN(), measure);
     }
     // otherwise copy the content to the corresponding existing measure
     else {
-        AttNNumberLikeComparison comparisonMeasure(MEASURE, measure->GetN());
-        Measure *existingMeasure = vrv_cast<Measure *>(section->FindDescendantByComparison(&comparisonMeasure, 1));
+        Measure *existingMeasure = GetSectionMeasure(measure->GetN());
         if (existingMeasure) {
             for (auto current : measure->GetChildren()) {
                 if (!current->Is(STAFF)) {
@@ -373,10 +385,17 @@ void MusicXmlInput::AddMeasure(Section *section, Measure *measure, int i)
         if (m_endingStack.back().second.m_endingType == "start"
             && m_endingStack.back().first.back()->GetID() != measure->GetID()) {
             m_endingStack.back().first.push_back(measure);
+            m_endingMeasureNumbers.insert(measure->GetN());
         }
     }
 }
 
+Measure *MusicXmlInput::GetSectionMeasure(const std::string &measureNum) const
+{
+    auto iter = m_sectionMeasures.find(measureNum);
+    return (iter != m_sectionMeasures.end()) ? iter->second : NULL;
+}
+
 void MusicXmlInput::AddLayerElement(Layer *layer, LayerElement *element, int duration)
 {
     assert(layer);
@@ -780,7 +799,7 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
     assert(root);
 
     // check for multimetric music
-    bool multiMetric = root.select_node("/score-partwise/part/measure[@non-controlling='yes']");
+    bool multiMetric = root.select_node(GetXPathQuery("/score-partwise/part/measure[@non-controlling='yes']"));
     if (multiMetric) {
         LogError("MusicXML import: Multimetric music detected. Import cancelled.");
         exit(1);
@@ -799,20 +818,21 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
     Section *section = new Section();
     score->AddChild(section);
     // initialize layout
-    if (root.select_node("/score-partwise/part/measure/print[@new-system or @new-page]")) {
+    if (root.select_node(GetXPathQuery("/score-partwise/part/measure/print[@new-system or @new-page]"))) {
         m_layoutInformation = LAYOUT_ENCODED;
-        if (!root.select_node("/score-partwise/part[1]/measure[1]/print[@new-system or @new-page]")) {
+        if (!root.select_node(GetXPathQuery("/score-partwise/part[1]/measure[1]/print[@new-system or @new-page]"))) {
             // always start with a new page
             Pb *pb = new Pb();
             section->AddChild(pb);
         }
     }
 
-    pugi::xpath_node layout = root.select_node("/score-partwise/defaults/page-layout");
-    const float bottom = layout.node().select_node("page-margins/bottom-margin").node().text().as_float();
+    pugi::xpath_node layout = root.select_node(GetXPathQuery("/score-partwise/defaults/page-layout"));
+    const float bottom
+        = layout.node().select_node(GetXPathQuery("page-margins/bottom-margin")).node().text().as_float();
 
     // generate page head
-    pugi::xpath_node_set credits = root.select_nodes("/score-partwise/credit[@page='1']/credit-words");
+    pugi::xpath_node_set credits = root.select_nodes(GetXPathQuery("/score-partwise/credit[@page='1']/credit-words"));
     if (!credits.empty()) {
         PgHead *head = NULL;
         PgFoot *foot = NULL;
@@ -861,10 +881,30 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
     short int staffOffset = 0;
     m_octDis.push_back(0);
 
-    pugi::xpath_node scoreMidiBpm = root.select_node("/score-partwise/part[1]/measure[1]/sound[@tempo][1]");
+    pugi::xpath_node scoreMidiBpm
+        = root.select_node(GetXPathQuery("/score-partwise/part[1]/measure[1]/sound[@tempo][1]"));
     if (scoreMidiBpm) m_doc->GetCurrentScoreDef()->SetMidiBpm(scoreMidiBpm.node().attribute("tempo").as_double());
 
-    pugi::xpath_node_set partListChildren = root.select_nodes("/score-partwise/part-list/*");
+    // index the parts by id and collect the ending starts that are closed, all in a single pass over the parts
+    std::map<std::string, pugi::xml_node> parts;
+    std::set<std::string> closedEndingNumbers;
+    for (pugi::xml_node part : root.children("part")) {
+        parts.emplace(part.attribute("id").as_string(), part);
+    }
+    pugi::xpath_node_set endings = root.select_nodes(GetXPathQuery("/score-partwise/part/measure/barline/ending"));
+    // going backward, an ending start is closed if a stop or discontinue with the same number was found after it
+    for (auto it = std::make_reverse_iterator(endings.end()); it != std::make_reverse_iterator(endings.begin()); ++it) {
+        pugi::xml_node ending = it->node();
+        const pugi::xml_attribute type = ending.attribute("type");
+        if (type && (std::string(type.value()) != "start")) {
+            if (ending.attribute("number")) closedEndingNumbers.insert(ending.attribute("number").value());
+        }
+        else if (type && closedEndingNumbers.count(ending.attribute("number").as_string())) {
+            m_closedEndingStarts.insert(ending);
+        }
+    }
+
+    pugi::xpath_node_set partListChildren = root.select_nodes(GetXPathQuery("/score-partwise/part-list/*"));
     for (pugi::xpath_node_set::const_iterator it = partListChildren.begin(); it != partListChildren.end(); ++it) {
         pugi::xpath_node xpathNode = *it;
         if (IsElement(xpathNode.node(), "part-group")) {
@@ -898,7 +938,7 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
                     = GetContentOfChild(xpathNode.node(), "group-abbreviation[not(@print-object='no')]");
                 if (!groupName.empty() && !m_label) {
                     m_label = new Label();
-                    if (xpathNode.node().select_node("group-name-display[not(@print-object='no')]")) {
+                    if (xpathNode.node().select_node(GetXPathQuery("group-name-display[not(@print-object='no')]"))) {
                         const std::string name = StyleLabel(xpathNode.node().child("group-name-display"));
                         Text *text = new Text();
                         text->SetText(UTF8to16(name));
@@ -914,7 +954,8 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
                 }
                 if (!groupAbbr.empty() && !m_labelAbbr) {
                     m_labelAbbr = new LabelAbbr();
-                    if (xpathNode.node().select_node("group-abbreviation-display[not(@print-object='no')]")) {
+                    if (xpathNode.node().select_node(
+                            GetXPathQuery("group-abbreviation-display[not(@print-object='no')]"))) {
                         const std::string name = StyleLabel(xpathNode.node().child("group-abbreviation-display"));
                         Text *text = new Text();
                         text->SetText(UTF8to16(name));
@@ -939,9 +980,9 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
         else if (IsElement(xpathNode.node(), "score-part")) {
             // get the attributes element of the first measure of the part
             const std::string partId = xpathNode.node().attribute("id").as_string();
-            std::string xpath = StringFormat("/score-partwise/part[@id='%s']/measure[1]", partId.c_str());
-            pugi::xpath_node partFirstMeasure = root.select_node(xpath.c_str());
-            if (!partFirstMeasure.node().child("attributes")) {
+            const auto part = parts.find(partId);
+            pugi::xml_node partFirstMeasure = (part != parts.end()) ? part->second.child("measure") : pugi::xml_node();
+            if (!partFirstMeasure.child("attributes")) {
                 LogWarning("MusicXML import: Could not find the 'attributes' element in the first "
                            "measure of part '%s'",
                     partId.c_str());
@@ -954,7 +995,7 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
             pugi::xml_node midiInstrument = xpathNode.node().child("midi-instrument");
             if (!partName.empty() && !m_label) {
                 m_label = new Label();
-                if (xpathNode.node().select_node("part-name-display[not(@print-object='no')]")) {
+                if (xpathNode.node().select_node(GetXPathQuery("part-name-display[not(@print-object='no')]"))) {
                     const std::string name = StyleLabel(xpathNode.node().child("part-name-display"));
                     Text *text = new Text();
                     text->SetText(UTF8to16(name));
@@ -977,7 +1018,7 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
             }
             if (!partAbbr.empty() && !m_labelAbbr) {
                 m_labelAbbr = new LabelAbbr();
-                if (xpathNode.node().select_node("part-abbreviation-display[not(@print-object='no')]")) {
+                if (xpathNode.node().select_node(GetXPathQuery("part-abbreviation-display[not(@print-object='no')]"))) {
                     const std::string name = StyleLabel(xpathNode.node().child("part-abbreviation-display"));
                     Text *text = new Text();
                     text->SetText(UTF8to16(name));
@@ -1015,7 +1056,7 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
             StaffGrp *partStaffGrp = new StaffGrp();
             partStaffGrp->SetID(partId.c_str());
             const short int nbStaves
-                = ReadMusicXmlPartAttributesAsStaffDef(partFirstMeasure.node(), partStaffGrp, staffOffset);
+                = ReadMusicXmlPartAttributesAsStaffDef(partFirstMeasure, partStaffGrp, staffOffset);
             // if we have more than one staff in the part we create a new staffGrp
             if (nbStaves > 1) {
                 partStaffGrp->SetBarThru(BOOLEAN_true);
@@ -1031,14 +1072,9 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
                 delete partStaffGrp;
             }
 
-            // find the part and read it
-            xpath = StringFormat("/score-partwise/part[@id='%s']", partId.c_str());
-            pugi::xpath_node part = root.select_node(xpath.c_str());
-            if (!part) {
-                LogWarning("MusicXML import: Could not find the part '%s'", partId.c_str());
-                continue;
-            }
-            ReadMusicXmlPart(part.node(), section, nbStaves, staffOffset);
+            // read the part, keeping track of whether it is the first one in the file
+            m_isFirstPart = (part->second == root.child("part"));
+            ReadMusicXmlPart(part->second, section, nbStaves, staffOffset);
             // increment the staffOffset for reading the next part
             staffOffset += nbStaves;
         }
@@ -1053,8 +1089,7 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
     Measure *measure = NULL;
     for (auto iter = m_controlElements.begin(); iter != m_controlElements.end(); ++iter) {
         if (!measure || (measure->GetN() != iter->first)) {
-            AttNNumberLikeComparison comparisonMeasure(MEASURE, iter->first);
-            measure = dynamic_cast<Measure *>(section->FindDescendantByComparison(&comparisonMeasure, 1));
+            measure = GetSectionMeasure(iter->first);
         }
         if (!measure) {
             LogWarning("MusicXML import: Element '%s' could not be added to measure %s",
@@ -1102,6 +1137,7 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
             LogDebug(logString.c_str());
         }
         m_endingStack.clear();
+        m_endingMeasureNumbers.clear();
     }
 
     m_doc->ConvertToPageBasedDoc();
@@ -1150,10 +1186,10 @@ bool MusicXmlInput::ReadMusicXml(pugi::xml_node root)
 void MusicXmlInput::ReadMusicXmlTitle(pugi::xml_node root)
 {
     assert(root);
-    pugi::xpath_node workTitle = root.select_node("/score-partwise/work/work-title");
-    pugi::xpath_node movementTitle = root.select_node("/score-partwise/movement-title");
-    pugi::xpath_node workNumber = root.select_node("/score-partwise/work/work-number");
-    pugi::xpath_node movementNumber = root.select_node("/score-partwise/movement-number");
+    pugi::xpath_node workTitle = root.select_node(GetXPathQuery("/score-partwise/work/work-title"));
+    pugi::xpath_node movementTitle = root.select_node(GetXPathQuery("/score-partwise/movement-title"));
+    pugi::xpath_node workNumber = root.select_node(GetXPathQuery("/score-partwise/work/work-number"));
+    pugi::xpath_node movementNumber = root.select_node(GetXPathQuery("/score-partwise/movement-number"));
     pugi::xml_node meiHead = m_doc->m_header.append_child("meiHead");
 
     // <fileDesc> /////////////
@@ -1181,7 +1217,7 @@ void MusicXmlInput::ReadMusicXmlTitle(pugi::xml_node root)
 
     pugi::xml_node respStmt = titleStmt.append_child("respStmt");
 
-    pugi::xpath_node_set creators = root.select_nodes("/score-partwise/identification/creator");
+    pugi::xpath_node_set creators = root.select_nodes(GetXPathQuery("/score-partwise/identification/creator"));
     for (pugi::xpath_node_set::const_iterator it = creators.begin(); it != creators.end(); ++it) {
         pugi::xpath_node creator = *it;
         pugi::xml_node persName = respStmt.append_child("persName");
@@ -1189,7 +1225,8 @@ void MusicXmlInput::ReadMusicXmlTitle(pugi::xml_node root)
         persName.append_attribute("role").set_value(creator.node().attribute("type").as_string());
     }
 
-    pugi::xpath_node_set dateSet = root.select_nodes("/score-partwise/identification/encoding/encoding-date");
+    pugi::xpath_node_set dateSet
+        = root.select_nodes(GetXPathQuery("/score-partwise/identification/encoding/encoding-date"));
     for (pugi::xpath_node_set::const_iterator it = dateSet.begin(); it != dateSet.end(); ++it) {
         pugi::xpath_node encodingDate = *it;
         pugi::xml_node date = pubStmt.append_child("date");
@@ -1199,7 +1236,7 @@ void MusicXmlInput::ReadMusicXmlTitle(pugi::xml_node root)
     }
 
     // Convert rights into availability
-    pugi::xpath_node_set rightsSet = root.select_nodes("/score-partwise/identification/rights");
+    pugi::xpath_node_set rightsSet = root.select_nodes(GetXPathQuery("/score-partwise/identification/rights"));
     if (!rightsSet.empty()) {
         pugi::xml_node availability = pubStmt.append_child("availability");
         for (pugi::xpath_node_set::const_iterator it = rightsSet.begin(); it != rightsSet.end(); ++it) {
@@ -1240,7 +1277,7 @@ short int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(
 
     // First get the number of staves in the part
     short int nbStaves = 1;
-    pugi::xpath_node staves = node.select_node("attributes[1]/staves");
+    pugi::xpath_node staves = node.select_node(GetXPathQuery("attributes[1]/staves"));
     if (staves) {
         nbStaves = staves.node().text().as_int();
     }
@@ -1295,10 +1332,10 @@ short int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(
 
             // clef sign - first look if we have a clef-sign with the corresponding staff @number
             std::string xpath = StringFormat("clef[@number='%d']", i + 1);
-            pugi::xpath_node clef = it->select_node(xpath.c_str());
+            pugi::xpath_node clef = it->select_node(GetXPathQuery(xpath));
             // if not, look at a common one
             if (!clef) {
-                clef = it->select_node("clef[not(@number)]");
+                clef = it->select_node(GetXPathQuery("clef[not(@number)]"));
                 if (nbStaves > 1) clef.node().remove_attribute("id");
             }
             Clef *meiClef = ConvertClef(clef.node());
@@ -1310,9 +1347,9 @@ short int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(
 
             // key sig
             xpath = StringFormat("key[@number='%d']", i + 1);
-            pugi::xpath_node key = it->select_node(xpath.c_str());
+            pugi::xpath_node key = it->select_node(GetXPathQuery(xpath));
             if (!key) {
-                key = it->select_node("key[not(@number)]");
+                key = it->select_node(GetXPathQuery("key[not(@number)]"));
                 if (nbStaves > 1) key.node().remove_attribute("id");
             }
             if (key) {
@@ -1323,18 +1360,19 @@ short int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(
             // staff details
             pugi::xpath_node staffDetails;
             xpath = StringFormat("staff-details[@number='%d']", i + 1);
-            staffDetails = it->select_node(xpath.c_str());
+            staffDetails = it->select_node(GetXPathQuery(xpath));
             if (!staffDetails) {
-                staffDetails = it->select_node("staff-details");
+                staffDetails = it->select_node(GetXPathQuery("staff-details"));
             }
-            short int staffLines = staffDetails.node().select_node("staff-lines").node().text().as_int();
+            short int staffLines = staffDetails.node().select_node(GetXPathQuery("staff-lines")).node().text().as_int();
             if (staffLines) {
                 staffDef->SetLines(staffLines);
             }
             else if (!staffDef->HasLines()) {
                 staffDef->SetLines(5);
             }
-            std::string scaleStr = staffDetails.node().select_node("staff-size").node().text().as_string();
+            std::string scaleStr
+                = staffDetails.node().select_node(GetXPathQuery("staff-size")).node().text().as_string();
             if (!scaleStr.empty()) {
                 staffDef->SetScale(staffDef->AttScalable::StrToPercent(scaleStr + "%"));
             }
@@ -1406,9 +1444,9 @@ short int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(
             // time
             pugi::xpath_node time;
             xpath = StringFormat("time[@number='%d']", i + 1);
-            time = it->select_node(xpath.c_str());
+            time = it->select_node(GetXPathQuery(xpath));
             if (!time) {
-                time = it->select_node("time[not(@number)]");
+                time = it->select_node(GetXPathQuery("time[not(@number)]"));
                 if (nbStaves > 1) time.node().remove_attribute("id");
             }
             if (time) {
@@ -1419,9 +1457,9 @@ short int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(
             // transpose
             pugi::xpath_node transpose;
             xpath = StringFormat("transpose[@number='%d']", i + 1);
-            transpose = it->select_node(xpath.c_str());
+            transpose = it->select_node(GetXPathQuery(xpath));
             if (!transpose) {
-                transpose = it->select_node("transpose");
+                transpose = it->select_node(GetXPathQuery("transpose"));
             }
             if (transpose) {
                 staffDef->SetTransDiat(transpose.node().child("diatonic").text().as_int());
@@ -1434,13 +1472,13 @@ short int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(
                 }
             }
             // ppq
-            pugi::xpath_node divisions = it->select_node("divisions");
+            pugi::xpath_node divisions = it->select_node(GetXPathQuery("divisions"));
             if (divisions) {
                 m_ppq = divisions.node().text().as_int();
                 staffDef->SetPpq(m_ppq);
             }
             // measure style
-            pugi::xpath_node measureSlash = it->select_node("measure-style/slash");
+            pugi::xpath_node measureSlash = it->select_node(GetXPathQuery("measure-style/slash"));
             if (measureSlash) {
                 if (HasAttributeWithValue(measureSlash.node(), "type", "start"))
                     m_slash = true;
@@ -1455,12 +1493,12 @@ short int MusicXmlInput::ReadMusicXmlPartAttributesAsStaffDef(
 
 void MusicXmlInput::ReadMusicXMLMeterSig(const pugi::xml_node &time, Object *parent)
 {
-    if ((time.select_nodes("beats").size() > 1) || time.select_node("interchangeable")) {
+    if ((time.select_nodes(GetXPathQuery("beats")).size() > 1) || time.select_node(GetXPathQuery("interchangeable"))) {
         MeterSigGrp *meterSigGrp = new MeterSigGrp();
         if (time.attribute("id")) {
             meterSigGrp->SetID(time.attribute("id").as_string());
         }
-        pugi::xpath_node interchangeable = time.select_node("interchangeable");
+        pugi::xpath_node interchangeable = time.select_node(GetXPathQuery("interchangeable"));
         meterSigGrp->SetFunc(interchangeable ? meterSigGrpLog_FUNC_interchanging : meterSigGrpLog_FUNC_mixed);
 
         std::tie(m_meterCount, m_meterUnit) = this->GetMeterSigGrpValues(time, meterSigGrp);
@@ -1512,7 +1550,7 @@ bool MusicXmlInput::ReadMusicXmlPart(pugi::xml_node node, Section *section, shor
     assert(node);
     assert(section);
 
-    pugi::xpath_node_set measures = node.select_nodes("measure");
+    pugi::xpath_node_set measures = node.select_nodes(GetXPathQuery("measure"));
     if (measures.size() == 0) {
         LogWarning("MusicXML import: No measure to load");
         return false;
@@ -1608,6 +1646,7 @@ bool MusicXmlInput::ReadMusicXmlMeasure(
 
     // reset measure time
     m_durTotal = 0;
+    m_hasKeyInMeasure = false;
 
     const auto mrestPositonIter = m_multiRests.find(index);
     bool isMRestInOtherSystem = (mrestPositonIter != m_multiRests.end());
@@ -1616,10 +1655,13 @@ bool MusicXmlInput::ReadMusicXmlMeasure(
     // read the content of the measure
     for (pugi::xml_node::iterator it = node.begin(); it != node.end(); ++it) {
         // first check if there is a multi measure rest
-        if (it->select_node(".//multiple-rest")) {
-            const int multiRestLength = it->select_node(".//multiple-rest").node().text().as_int();
+        pugi::xpath_node multipleRest = it->select_node(GetXPathQuery(".//multiple-rest"));
+        if (multipleRest) {
+            const int multiRestLength = multipleRest.node().text().as_int();
             MultiRest *multiRest = new MultiRest;
-            if (it->select_node(".//multiple-rest[@use-symbols='yes']")) multiRest->SetBlock(BOOLEAN_false);
+            if (it->select_node(GetXPathQuery(".//multiple-rest[@use-symbols='yes']"))) {
+                multiRest->SetBlock(BOOLEAN_false);
+            }
             multiRest->SetNum(multiRestLength);
             Layer *layer = SelectLayer(1, measure);
             AddLayerElement(layer, multiRest);
@@ -1660,7 +1702,7 @@ bool MusicXmlInput::ReadMusicXmlMeasure(
             ReadMusicXmlNote(*it, measure, measureNum, staffOffset, section);
         }
         // for now only check first part
-        else if (IsElement(*it, "print") && node.select_node("parent::part[not(preceding-sibling::part)]")) {
+        else if (IsElement(*it, "print") && m_isFirstPart) {
             ReadMusicXmlPrint(*it, section);
         }
     }
@@ -1756,8 +1798,8 @@ void MusicXmlInput::ReadMusicXmlAttributes(
     pugi::xml_node time = node.child("time");
 
     // for now only read first key change in first part and update scoreDef
-    if ((key || time || divisionChange) && node.select_node("ancestor::part[not(preceding-sibling::part)]")
-        && !node.select_node("preceding-sibling::attributes/key")) {
+    // The attributes of the measure are read in order, so a previous key is one from a preceding sibling
+    if ((key || time || divisionChange) && m_isFirstPart && !m_hasKeyInMeasure) {
         ScoreDef *scoreDef = new ScoreDef();
         if (key) {
             KeySig *meiKey = ConvertKey(key);
@@ -1774,9 +1816,10 @@ void MusicXmlInput::ReadMusicXmlAttributes(
 
         section->AddChild(scoreDef);
     }
+    if (key) m_hasKeyInMeasure = true;
 
-    pugi::xpath_node measureRepeat = node.select_node("measure-style/measure-repeat");
-    pugi::xpath_node measureSlash = node.select_node("measure-style/slash");
+    pugi::xpath_node measureRepeat = node.select_node(GetXPathQuery("measure-style/measure-repeat"));
+    pugi::xpath_node measureSlash = node.select_node(GetXPathQuery("measure-style/slash"));
     if (measureRepeat) {
         if (HasAttributeWithValue(measureRepeat.node(), "type", "start"))
             m_mRpt = true;
@@ -1810,7 +1853,7 @@ void MusicXmlInput::ReadMusicXmlBarLine(pugi::xml_node node, Measure *measure, c
     assert(staff);
 
     const std::string barStyle = node.child("bar-style").text().as_string();
-    pugi::xpath_node repeat = node.select_node("repeat");
+    pugi::xpath_node repeat = node.select_node(GetXPathQuery("repeat"));
     if (!barStyle.empty()) {
         data_BARRENDITION barRendition = ConvertStyleToRend(barStyle, repeat);
         if (HasAttributeWithValue(node, "location", "left")) {
@@ -1857,19 +1900,20 @@ void MusicXmlInput::ReadMusicXmlBarLine(pugi::xml_node node, Measure *measure, c
         // endingText.c_str());
         if (endingType == "start") {
             // check for corresponding stop points
-            std::string xpath = StringFormat("following::ending[@number='%s'][@type != 'start']", endingNumber.c_str());
-            pugi::xpath_node endingEnd = node.select_node(xpath.c_str());
+            const bool endingEnd = m_closedEndingStarts.count(ending);
             if (endingEnd && (m_endingStack.empty() || NotInEndingStack(measure->GetN()))) {
                 musicxml::EndingInfo endingInfo(endingNumber, endingType, endingText);
                 std::vector<Measure *> measureList;
                 measureList.push_back(measure);
                 m_endingStack.push_back({ measureList, endingInfo });
+                m_endingMeasureNumbers.insert(measure->GetN());
             }
         }
         else if (endingType == "stop" || endingType == "discontinue") {
             m_endingStack.back().second.m_endingType = endingType;
             if (NotInEndingStack(measure->GetN())) {
                 m_endingStack.back().first.push_back(measure);
+                m_endingMeasureNumbers.insert(measure->GetN());
             }
         }
     }
@@ -1914,7 +1958,7 @@ void MusicXmlInput::ReadMusicXmlDirection(
     const std::string directionId = node.attribute("id").as_string();
 
     const pugi::xml_node typeNode = node.child("direction-type");
-    const pugi::xpath_node voice = node.select_node("voice");
+    const pugi::xpath_node voice = node.select_node(GetXPathQuery("voice"));
     const short int offset = node.child("offset").text().as_int();
     const pugi::xml_node staffNode = node.child("staff");
     const pugi::xml_node soundNode = node.child("sound");
@@ -1980,7 +2024,7 @@ void MusicXmlInput::ReadMusicXmlDirection(
     }
 
     // Dashes (to be connected with previous <dir> or <dynam> as @extender and @tstamp2 attribute
-    pugi::xpath_node dashes = typeNode.select_node("bracket|dashes");
+    pugi::xpath_node dashes = typeNode.select_node(GetXPathQuery("bracket|dashes"));
     if (dashes) {
         short int dashesNumber = dashes.node().attribute("number").as_int();
         dashesNumber = (dashesNumber < 1) ? 1 : dashesNumber;
@@ -2046,16 +2090,18 @@ void MusicXmlInput::ReadMusicXmlDirection(
         }
     }
 
-    pugi::xpath_node_set words = node.select_nodes("direction-type/words");
+    pugi::xpath_node_set words = node.select_nodes(GetXPathQuery("direction-type/words"));
     const bool containsWords = !words.empty();
     bool containsDynamics
-        = !node.select_node("direction-type/dynamics").node().empty() || soundNode.attribute("dynamics");
-    bool containsTempo = !node.select_node("direction-type/metronome").node().empty() || soundNode.attribute("tempo");
+        = !node.select_node(GetXPathQuery("direction-type/dynamics")).node().empty() || soundNode.attribute("dynamics");
+    bool containsTempo
+        = !node.select_node(GetXPathQuery("direction-type/metronome")).node().empty() || soundNode.attribute("tempo");
 
     // Directive
     int defaultY = 0; // y position attribute, only for directives and dynamics
     if (containsWords && !containsTempo && !containsDynamics) {
-        pugi::xpath_node_set words = node.select_nodes("direction-type/*[self::words or self::coda or self::segno]");
+        pugi::xpath_node_set words
+            = node.select_nodes(GetXPathQuery("direction-type/*[self::words or self::coda or self::segno]"));
         defaultY = words.first().node().attribute("default-y").as_int();
         std::string wordStr = words.first().node().text().as_string();
         if (wordStr.rfind("cresc", 0) == 0 || wordStr.rfind("dim", 0) == 0 || wordStr.rfind("decresc", 0) == 0) {
@@ -2109,8 +2155,8 @@ void MusicXmlInput::ReadMusicXmlDirection(
 
     // Dynamics
     if (containsDynamics) {
-        pugi::xpath_node_set dynamics = node.select_nodes(
-            containsWords ? "direction-type/dynamics|direction-type/words" : "direction-type/dynamics");
+        pugi::xpath_node_set dynamics = node.select_nodes(GetXPathQuery(
+            containsWords ? "direction-type/dynamics|direction-type/words" : "direction-type/dynamics"));
 
         dynamics.sort();
 
@@ -2166,7 +2212,7 @@ void MusicXmlInput::ReadMusicXmlDirection(
     }
 
     // Hairpins
-    pugi::xpath_node_set wedges = node.select_nodes("direction-type/wedge");
+    pugi::xpath_node_set wedges = node.select_nodes(GetXPathQuery("direction-type/wedge"));
     for (pugi::xpath_node_set::const_iterator wedge = wedges.begin(); wedge != wedges.end(); ++wedge) {
         short int hairpinNumber = wedge->node().attribute("number").as_int();
         hairpinNumber = (hairpinNumber < 1) ? 1 : hairpinNumber;
@@ -2416,7 +2462,8 @@ void MusicXmlInput::ReadMusicXmlDirection(
         }
         tempo->SetPlace(tempo->AttPlacementRelStaff::StrToStaffrel(placeStr.c_str()));
         if (words.size() != 0) TextRendition(words, tempo);
-        pugi::xpath_node metronome = node.select_node("direction-type/metronome[not(@print-object='no')]");
+        pugi::xpath_node metronome
+            = node.select_node(GetXPathQuery("direction-type/metronome[not(@print-object='no')]"));
         if (metronome) PrintMetronome(metronome.node(), tempo);
         if (soundNode.attribute("tempo")) {
             tempo->SetMidiBpm(soundNode.attribute("tempo").as_double());
@@ -2495,7 +2542,7 @@ void MusicXmlInput::ReadMusicXmlHarmony(pugi::xml_node node, Measure *measure, c
     int durOffset = 0;
 
     std::string harmText = GetContentOfChild(node, "root/root-step");
-    pugi::xpath_node alter = node.select_node("root/root-alter");
+    pugi::xpath_node alter = node.select_node(GetXPathQuery("root/root-alter"));
     if (alter) harmText += ConvertAlterToSymbol(GetContent(alter.node()));
     pugi::xml_node kind = node.child("kind");
     if (kind) {
@@ -2577,23 +2624,23 @@ void MusicXmlInput::ReadMusicXmlNote(
         return;
     }
 
-    const pugi::xpath_node notations = node.select_node("notations[not(@print-object='no')]");
+    const pugi::xpath_node notations = node.select_node(GetXPathQuery("notations[not(@print-object='no')]"));
 
-    const bool cue = (node.child("cue") || node.select_node("type[@size='cue']")) ? true : false;
+    const bool cue = (node.child("cue") || node.select_node(GetXPathQuery("type[@size='cue']"))) ? true : false;
     pugi::xml_node grace = node.child("grace");
 
     // duration string and dots
     const std::string typeStr = node.child("type").text().as_string();
-    const int dots = (int)node.select_nodes("dot").size();
+    const int dots = (int)node.select_nodes(GetXPathQuery("dot")).size();
 
     short int tremSlashNum = -1;
 
     const bool readBeamsAndTuplets = ReadMusicXmlBeamsAndTuplets(node, layer, isChord);
 
     // beam start
-    bool beamStart = node.select_node("beam[@number='1'][text()='begin']");
+    bool beamStart = node.select_node(GetXPathQuery("beam[@number='1'][text()='begin']"));
     // tremolos
-    pugi::xpath_node tremolo = notations.node().select_node("ornaments/tremolo");
+    pugi::xpath_node tremolo = notations.node().select_node(GetXPathQuery("ornaments/tremolo"));
 
     if (tremolo) {
         if (HasAttributeWithValue(tremolo.node(), "type", "start")) {
@@ -2606,7 +2653,7 @@ void MusicXmlInput::ReadMusicXmlNote(
                 while (beamStart && beamAttachedNum < 8) { // count number of (attached) beams, max 8
                     std::ostringstream o;
                     o << "beam[@number='" << ++beamAttachedNum + 1 << "'][text()='begin']";
-                    beamStart = node.select_node(o.str().c_str());
+                    beamStart = node.select_node(GetXPathQuery(o.str()));
                 }
                 fTrem->SetBeams(beamFloatNum + beamAttachedNum);
                 fTrem->SetBeamsFloat(beamFloatNum);
@@ -2816,7 +2863,7 @@ void MusicXmlInput::ReadMusicXmlNote(
         if (node.child("notehead-text")) LogWarning("MusicXML import: notehead-text is not supported");
 
         // look at the next note to see if we are starting or ending a chord
-        pugi::xpath_node nextNote = node.select_node("./following-sibling::note");
+        pugi::xpath_node nextNote = node.select_node(GetXPathQuery("./following-sibling::note"));
         if (nextNote.node().child("chord")) nextIsChord = true;
         Chord *chord = NULL;
         TabGrp *tabGrp = NULL;
@@ -3033,7 +3080,7 @@ void MusicXmlInput::ReadMusicXmlNote(
         }
 
         // slurs
-        pugi::xpath_node_set slurs = node.select_nodes("notations/slur");
+        pugi::xpath_node_set slurs = node.select_nodes(GetXPathQuery("notations/slur"));
         for (pugi::xpath_node_set::const_iterator it = slurs.begin(); it != slurs.end(); ++it) {
             pugi::xml_node slur = it->node();
             short int slurNumber = slur.attribute("number").as_int();
@@ -3183,7 +3230,7 @@ void MusicXmlInput::ReadMusicXmlNote(
     m_ID = "#" + element->GetID();
 
     // breath marks
-    pugi::xpath_node xmlBreath = notations.node().select_node("articulations/breath-mark");
+    pugi::xpath_node xmlBreath = notations.node().select_node(GetXPathQuery("articulations/breath-mark"));
     if (xmlBreath) {
         Breath *breath = new Breath();
         m_controlElements.push_back({ measureNum, breath });
@@ -3195,7 +3242,7 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // caesura
-    pugi::xpath_node xmlCaesura = notations.node().select_node("articulations/caesura");
+    pugi::xpath_node xmlCaesura = notations.node().select_node(GetXPathQuery("articulations/caesura"));
     if (xmlCaesura) {
         Caesura *caesura = new Caesura();
         m_controlElements.push_back({ measureNum, caesura });
@@ -3245,7 +3292,7 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // fingering
-    auto xmlFing = notations.node().select_node("technical/fingering");
+    auto xmlFing = notations.node().select_node(GetXPathQuery("technical/fingering"));
     if (xmlFing) {
         const std::string fingText = xmlFing.node().text().as_string();
         Fing *fing = new Fing();
@@ -3260,7 +3307,7 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // glissando and slide
-    pugi::xpath_node_set glissandi = notations.node().select_nodes("glissando|slide");
+    pugi::xpath_node_set glissandi = notations.node().select_nodes(GetXPathQuery("glissando|slide"));
     for (pugi::xpath_node_set::const_iterator it = glissandi.begin(); it != glissandi.end(); ++it) {
         std::string noteID = m_ID;
         // prevent from using chords or tabGrps
@@ -3294,7 +3341,8 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // mordents
-    pugi::xpath_node xmlMordent = notations.node().select_node("ornaments/*[contains(name(), 'mordent')]");
+    pugi::xpath_node xmlMordent
+        = notations.node().select_node(GetXPathQuery("ornaments/*[contains(name(), 'mordent')]"));
     if (xmlMordent) {
         Mordent *mordent = new Mordent();
         m_controlElements.push_back({ measureNum, mordent });
@@ -3342,7 +3390,8 @@ void MusicXmlInput::ReadMusicXmlNote(
 
     // schleifer/haydn (counts as mordent with different glyph)
     pugi::xpath_node xmlExtOrnament
-        = notations.node().select_node("ornaments/*[contains(name(), 'schleifer') or contains(name(), 'haydn')]");
+        = notations.node().select_node(
+            GetXPathQuery("ornaments/*[contains(name(), 'schleifer') or contains(name(), 'haydn')]"));
     if (xmlExtOrnament) {
         Mordent *mordent = new Mordent();
         m_controlElements.push_back({ measureNum, mordent });
@@ -3359,8 +3408,8 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // trill
-    pugi::xpath_node xmlTrill = notations.node().select_node("ornaments/trill-mark");
-    pugi::xpath_node xmlTrillLine = notations.node().select_node("ornaments/wavy-line[@type='start']");
+    pugi::xpath_node xmlTrill = notations.node().select_node(GetXPathQuery("ornaments/trill-mark"));
+    pugi::xpath_node xmlTrillLine = notations.node().select_node(GetXPathQuery("ornaments/wavy-line[@type='start']"));
     if (xmlTrill || xmlTrillLine) {
         Trill *trill = new Trill();
         m_controlElements.push_back({ measureNum, trill });
@@ -3391,9 +3440,13 @@ void MusicXmlInput::ReadMusicXmlNote(
             }
         }
     }
-    if (!m_trillStack.empty() && notations.node().select_node("ornaments/wavy-line[@type='stop']")) {
+    if (!m_trillStack.empty() && notations.node().select_node(GetXPathQuery("ornaments/wavy-line[@type='stop']"))) {
         short int extNumber
-            = notations.node().select_node("ornaments/wavy-line[@type='stop']").node().attribute("number").as_int();
+            = notations.node()
+                  .select_node(GetXPathQuery("ornaments/wavy-line[@type='stop']"))
+                  .node()
+                  .attribute("number")
+                  .as_int();
         std::vector<std::pair<Trill *, musicxml::OpenSpanner>>::iterator iter = m_trillStack.begin();
         while (iter != m_trillStack.end()) {
             const int measureDifference = m_measureCounts.at(measure) - iter->second.m_lastMeasureCount;
@@ -3410,7 +3463,7 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // turns
-    pugi::xpath_node xmlTurn = notations.node().select_node("ornaments/*[contains(name(), 'turn')]");
+    pugi::xpath_node xmlTurn = notations.node().select_node(GetXPathQuery("ornaments/*[contains(name(), 'turn')]"));
     if (xmlTurn) {
         Turn *turn = new Turn();
         m_controlElements.push_back({ measureNum, turn });
@@ -3450,7 +3503,7 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // arpeggio
-    pugi::xpath_node xmlArpeggiate = notations.node().select_node("*[contains(name(), 'arpeggiate')]");
+    pugi::xpath_node xmlArpeggiate = notations.node().select_node(GetXPathQuery("*[contains(name(), 'arpeggiate')]"));
     if (xmlArpeggiate) {
         short int arpegN = xmlArpeggiate.node().attribute("number").as_int();
         arpegN = (arpegN < 1) ? 1 : arpegN;
@@ -3503,15 +3556,15 @@ void MusicXmlInput::ReadMusicXmlNote(
     }
 
     // tuplet end
-    pugi::xpath_node tupletEnd = notations.node().select_node("tuplet[@type='stop']");
+    pugi::xpath_node tupletEnd = notations.node().select_node(GetXPathQuery("tuplet[@type='stop']"));
     if (tupletEnd) {
         RemoveLastFromStack(TUPLET, layer);
     }
 
     // beam end
-    bool beamEnd = node.select_node("beam[text()='end']");
+    bool beamEnd = node.select_node(GetXPathQuery("beam[text()='end']"));
     if (beamEnd) {
-        int breakSec = (int)node.select_nodes("beam[text()='continue']").size();
+        int breakSec = (int)node.select_nodes(GetXPathQuery("beam[text()='continue']")).size();
         if (breakSec) {
             if (element->Is(NOTE)) {
                 Note *note = dynamic_cast<Note *>(element);
@@ -3604,12 +3657,14 @@ void MusicXmlInput::ReadMusicXmlPrint(pugi::xml_node node, Section *section)
 
 bool MusicXmlInput::ReadMusicXmlBeamsAndTuplets(const pugi::xml_node &node, Layer *layer, bool isChord)
 {
-    pugi::xpath_node beamStart = node.select_node("beam[@number='1' and text()='begin']");
-    pugi::xpath_node tupletStart = node.select_node("notations/tuplet[@type='start']");
-    pugi::xpath_node currentMeasure = node.select_node("ancestor::measure");
+    pugi::xpath_node beamStart = node.select_node(GetXPathQuery("beam[@number='1' and text()='begin']"));
+    pugi::xpath_node tupletStart = node.select_node(GetXPathQuery("notations/tuplet[@type='start']"));
+    pugi::xpath_node currentMeasure = node.select_node(GetXPathQuery("ancestor::measure"));
 
-    pugi::xml_node beamEnd = node.select_node("./following-sibling::note[beam[@number='1' and text()='end']]").node();
-    pugi::xml_node tupletEnd = node.select_node("./following-sibling::note[notations[tuplet[@type='stop']]]").node();
+    pugi::xml_node beamEnd
+        = node.select_node(GetXPathQuery("./following-sibling::note[beam[@number='1' and text()='end']]")).node();
+    pugi::xml_node tupletEnd
+        = node.select_node(GetXPathQuery("./following-sibling::note[notations[tuplet[@type='stop']]]")).node();
 
     const auto measureNodeChildren = currentMeasure.node().children();
     std::vector<pugi::xml_node> currentMeasureNodes(measureNodeChildren.begin(), measureNodeChildren.end());
@@ -3635,7 +3690,7 @@ bool MusicXmlInput::ReadMusicXmlBeamsAndTuplets(const pugi::xml_node &node, Laye
     else if (beamStart) {
         // find whether there is a tuplet that starts during the span of the beam
         pugi::xpath_node nextTupletStart
-            = node.select_node("./following-sibling::note[notations[tuplet[@type='start']]]").node();
+            = node.select_node(GetXPathQuery("./following-sibling::note[notations[tuplet[@type='start']]]")).node();
 
         // find start and end of the beam
         const auto beamStartIterator = std::find(currentMeasureNodes.begin(), currentMeasureNodes.end(), node);
@@ -3643,8 +3698,8 @@ bool MusicXmlInput::ReadMusicXmlBeamsAndTuplets(const pugi::xml_node &node, Laye
 
         // find staff number for the corresponding elements - we do not want to match beam start on one staff with beam
         // end on another
-        pugi::xpath_node nodeStaff = node.select_node("staff");
-        pugi::xpath_node endBeamStaff = beamEnd.select_node("staff");
+        pugi::xpath_node nodeStaff = node.select_node(GetXPathQuery("staff"));
+        pugi::xpath_node endBeamStaff = beamEnd.select_node(GetXPathQuery("staff"));
 
         if (beamEndIterator == currentMeasureNodes.end()
             || (nodeStaff && endBeamStaff
@@ -3688,11 +3743,11 @@ void MusicXmlInput::ReadMusicXmlTupletStart(const pugi::xml_node &node, const pu
     Tuplet *tuplet = new Tuplet();
     AddLayerElement(layer, tuplet);
     m_elementStackMap.at(layer).push_back(tuplet);
-    short int num = node.select_node("time-modification/actual-notes").node().text().as_int();
-    short int numbase = node.select_node("time-modification/normal-notes").node().text().as_int();
+    short int num = node.select_node(GetXPathQuery("time-modification/actual-notes")).node().text().as_int();
+    short int numbase = node.select_node(GetXPathQuery("time-modification/normal-notes")).node().text().as_int();
     if (tupletStart.first_child()) {
-        num = tupletStart.select_node("tuplet-actual/tuplet-number").node().text().as_int();
-        numbase = tupletStart.select_node("tuplet-normal/tuplet-number").node().text().as_int();
+        num = tupletStart.select_node(GetXPathQuery("tuplet-actual/tuplet-number")).node().text().as_int();
+        numbase = tupletStart.select_node(GetXPathQuery("tuplet-normal/tuplet-number")).node().text().as_int();
     }
     if (num) tuplet->SetNum(num);
     if (numbase) tuplet->SetNumbase(numbase);
@@ -3705,7 +3760,7 @@ void MusicXmlInput::ReadMusicXmlTupletStart(const pugi::xml_node &node, const pu
 
 void MusicXmlInput::ReadMusicXmlBeamStart(const pugi::xml_node &node, const pugi::xml_node &beamStart, Layer *layer)
 {
-    if (!beamStart || (node.select_node("notations/ornaments/tremolo[@type='start']"))) return;
+    if (!beamStart || (node.select_node(GetXPathQuery("notations/ornaments/tremolo[@type='start']")))) return;
     if (m_elementStackMap.at(layer).size() > 0 && m_elementStackMap.at(layer).back()->Is(BEAM)) {
         LogDebug("MusicXML import: Adding a beam to a beam");
         if (!node.child("grace")) return;
@@ -3721,7 +3776,7 @@ void MusicXmlInput::ReadMusicXmlBeamStart(const pugi::xml_node &node, const pugi
 void MusicXmlInput::ReadMusicXmlTies(
     const pugi::xml_node &node, Layer *layer, Note *note, const std::string &measureNum)
 {
-    pugi::xpath_node xmlTie = node.select_node("tied");
+    pugi::xpath_node xmlTie = node.select_node(GetXPathQuery("tied"));
     if (!xmlTie) return;
 
     const std::string tieType = xmlTie.node().attribute("type").as_string();
@@ -4482,12 +4537,7 @@ std::string MusicXmlInput::ConvertFigureGlyph(const std::string &value)
 
 bool MusicXmlInput::NotInEndingStack(const std::string &measureN)
 {
-    for (auto &endingItem : m_endingStack) {
-        for (auto &measure : endingItem.first) {
-            if (measure->GetN() == measureN) return false;
-        }
-    }
-    return true;
+    return (m_endingMeasureNumbers.count(measureN) == 0);
 }
 
 void MusicXmlInput::SetFermataExternalSymbols(Fermata *fermata, const std::string &shape)
@@ -4540,8 +4590,8 @@ bool MusicXmlInput::IsMultirestMeasure(int index) const
 
 std::pair<std::vector<int>, int> MusicXmlInput::GetMeterSigGrpValues(const pugi::xml_node &node, MeterSigGrp *parent)
 {
-    pugi::xpath_node_set beats = node.select_nodes("beats");
-    pugi::xpath_node_set beat_type = node.select_nodes("beat-type");
+    pugi::xpath_node_set beats = node.select_nodes(GetXPathQuery("beats"));
+    pugi::xpath_node_set beat_type = node.select_nodes(GetXPathQuery("beat-type"));
     int maxUnit = 0;
     std::vector<int> meterCounts;
     for (auto iter1 = beats.begin(), iter2 = beat_type.begin(); (iter1 != beats.end()) && (iter2 != beat_type.end());
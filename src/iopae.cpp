@@ -9,10 +9,10 @@
 
 //----------------------------------------------------------------------------
 
+#include <algorithm>
 #include <cassert>
 #include <cctype>
 #include <fstream>
-#include <regex>
 #include <sstream>
 #include <string>
 
@@ -584,6 +584,76 @@ void PAEOutput::WriteGrace(AttGraced *attGraced)
     }
 }
 
+//----------------------------------------------------------------------------
+// Time signature and mensuration matching (shared by both PAEInput parsers)
+//----------------------------------------------------------------------------
+
+#ifndef NO_PAE_SUPPORT
+
+static bool IsDigit(char c)
+{
+    return ((c >= '0') && (c <= '9'));
+}
+
+static bool IsDigits(const std::string &str)
+{
+    return (!str.empty() && std::all_of(str.begin(), str.end(), IsDigit));
+}
+
+/**
+ * Match a time signature with a count and a unit, i.e., (\d+)/(\d+)
+ */
+static bool MatchTimeSigFraction(const std::string &timeSig, std::string &count, std::string &unit)
+{
+    const size_t slash = timeSig.find('/');
+    if (slash == std::string::npos) return false;
+    count = timeSig.substr(0, slash);
+    unit = timeSig.substr(slash + 1);
+    return (IsDigits(count) && IsDigits(unit));
+}
+
+/**
+ * Match a mensuration sign, i.e., ([co])([./]?)([./]?)(\d*)/?(\d*), and set it to the mensur.
+ * Return false if the time signature does not match.
+ */
+static bool ParseMensurSign(const std::string &timeSig, Mensur *mensur)
+{
+    assert(mensur);
+
+    const size_t size = timeSig.size();
+    size_t pos = 0;
+    if ((size == 0) || ((timeSig[0] != 'c') && (timeSig[0] != 'o'))) return false;
+    ++pos;
+    // Dot and slash (the order between . and / is not defined in PAE)
+    bool hasDot = false;
+    bool hasSlash = false;
+    for (int i = 0; (i < 2) && (pos < size) && ((timeSig[pos] == '.') || (timeSig[pos] == '/')); ++i, ++pos) {
+        if (timeSig[pos] == '.') hasDot = true;
+        if (timeSig[pos] == '/') hasSlash = true;
+    }
+    size_t numEnd = pos;
+    while ((numEnd < size) && IsDigit(timeSig[numEnd])) ++numEnd;
+    const std::string num = timeSig.substr(pos, numEnd - pos);
+    pos = numEnd;
+    if ((pos < size) && (timeSig[pos] == '/')) ++pos;
+    size_t numbaseEnd = pos;
+    while ((numbaseEnd < size) && IsDigit(timeSig[numbaseEnd])) ++numbaseEnd;
+    const std::string numbase = timeSig.substr(pos, numbaseEnd - pos);
+    if (numbaseEnd != size) return false;
+
+    mensur->SetSign((timeSig[0] == 'c') ? MENSURATIONSIGN_C : MENSURATIONSIGN_O);
+    if (hasDot) mensur->SetDot(BOOLEAN_true);
+    if (hasSlash) mensur->SetSlash(1);
+    if (!num.empty()) {
+        mensur->SetNum(std::stoi(num));
+        // Numbase (but only if Num is given)
+        if (!numbase.empty()) mensur->SetNumbase(std::stoi(numbase));
+    }
+    return true;
+}
+
+#endif // NO_PAE_SUPPORT
+
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 #ifdef USE_PAE_OLD_PARSER
@@ -616,6 +686,17 @@ char data_line[10001] = { 0 };
 char data_key[MAX_DATA_LEN];
 char data_value[MAX_DATA_LEN]; // ditto as above
 
+/**
+ * Return true if the character appears before the next pitch name, i.e., ^[^A-G]*c
+ */
+static bool HasBeforeNextPitch(const char *incipit, char c)
+{
+    for (; (*incipit != '\0') && ((*incipit < 'A') || (*incipit > 'G')); ++incipit) {
+        if (*incipit == c) return true;
+    }
+    return false;
+}
+
 #endif /* NO_PAE_SUPPORT */
 
 //----------------------------------------------------------------------------
@@ -1201,11 +1282,13 @@ int PAEInput::getTupletFermata(const char *incipit, pae::Note *note, int index)
 
     // Detect if it is a fermata or a tuplet.
     //
-    // std::regex_constants::ECMAScript is the default syntax, so optional.
-    // Previously these were extended regex syntax, but this case
-    // is the same in ECMAScript syntax.
-    std::regex exp("^([^)]*[ABCDEFG-][^)]*[ABCDEFG-][^)]*)", std::regex_constants::ECMAScript);
-    bool is_tuplet = regex_search(incipit + i, exp);
+    // This is a tuplet if there are at least two notes or rests before the closing parenthesis, as
+    // matched by ^([^)]*[ABCDEFG-][^)]*[ABCDEFG-][^)]*)
+    int noteCount = 0;
+    for (const char *c = incipit + i; (*c != '\0') && (*c != ')') && (noteCount < 2); ++c) {
+        if (((*c >= 'A') && (*c <= 'G')) || (*c == '-')) ++noteCount;
+    }
+    bool is_tuplet = (noteCount == 2);
 
     if (is_tuplet) {
         int t = i;
@@ -1385,17 +1468,15 @@ int PAEInput::getTimeInfo(const char *incipit, MeterSig *meter, Mensur *mensur,
 
     std::ostringstream sout;
 
-    // regex_match matches to the entire input string (regex_search does
-    // partial matches.  In this case cmatch is used to store the submatches
-    // (enclosed in parentheses) for later reference.  Use std::smatch when
-    // dealing with strings, or std::wmatch with wstrings.
-    std::cmatch matches;
+    const std::string timeSig = timesig_str;
+    std::string count;
+    std::string unit;
     if (meter) {
-        if (regex_match(timesig_str, matches, std::regex("(\\d+)/(\\d+)"))) {
-            meter->SetCount({ { std::stoi(matches[1]) }, MeterCountSign::None });
-            meter->SetUnit(std::stoi(matches[2]));
+        if (MatchTimeSigFraction(timeSig, count, unit)) {
+            meter->SetCount({ { std::stoi(count) }, MeterCountSign::None });
+            meter->SetUnit(std::stoi(unit));
         }
-        else if (regex_match(timesig_str, matches, std::regex("\\d+"))) {
+        else if (IsDigits(timeSig)) {
             meter->SetCount({ { std::stoi(timesig_str) }, MeterCountSign::None });
             meter->SetUnit(1);
             meter->SetForm(METERFORM_num);
@@ -1424,40 +1505,14 @@ int PAEInput::getTimeInfo(const char *incipit, MeterSig *meter, Mensur *mensur,
         }
     }
     else {
-        if (regex_match(timesig_str, matches, std::regex("(\\d+)/(\\d+)"))) {
-            mensur->SetNum(std::stoi(matches[1]));
-            mensur->SetNumbase(std::stoi(matches[2]));
+        if (MatchTimeSigFraction(timeSig, count, unit)) {
+            mensur->SetNum(std::stoi(count));
+            mensur->SetNumbase(std::stoi(unit));
         }
-        else if (regex_match(timesig_str, matches, std::regex("\\d+"))) {
+        else if (IsDigits(timeSig)) {
             mensur->SetNum(std::stoi(timesig_str));
         }
-        else if (regex_match(timesig_str, matches, std::regex("([co])([\\./]?)([\\./]?)(\\d*)/?(\\d*)"))) {
-            // C
-            if (matches[1] == "c") {
-                mensur->SetSign(MENSURATIONSIGN_C);
-            }
-            // O
-            else {
-                mensur->SetSign(MENSURATIONSIGN_O);
-            }
-            // Dot (second or third match since order between . and / is not defined in PAE)
-            if ((matches[2] == ".") || (matches[3] == ".")) {
-                mensur->SetDot(BOOLEAN_true);
-            }
-            // Slash (second or third match, ditto)
-            if ((matches[2] == "/") || (matches[3] == "/")) {
-                mensur->SetSlash(1);
-            }
-            // Num
-            if (matches[4] != "") {
-                mensur->SetNum(std::stoi(matches[4]));
-            }
-            // Numbase (but only if Num is given)
-            if ((matches[4] != "") && (matches[5] != "")) {
-                mensur->SetNumbase(std::stoi(matches[5]));
-            }
-        }
-        else {
+        else if (!ParseMensurSign(timeSig, mensur)) {
             LogWarning("Plaine & Easie import: unsupported time signature: %s", timesig_str);
         }
     }
@@ -1795,12 +1850,12 @@ int PAEInput::getNote(const char *incipit, pae::Note *note, pae::Measure *measur
     }
 
     // chord
-    if (regex_search(incipit + i + 1, std::regex("^[^A-G]*\\^"))) {
+    if (HasBeforeNextPitch(incipit + i + 1, '^')) {
         note->chord = true;
     }
 
     // tie
-    if (regex_search(incipit + i + 1, std::regex("^[^A-G]*\\+"))) {
+    if (HasBeforeNextPitch(incipit + i + 1, '+')) {
         note->tie = true;
         if (note->accidental) {
             m_tieAccid.first = note->pitch;
@@ -1813,7 +1868,7 @@ int PAEInput::getNote(const char *incipit, pae::Note *note, pae::Measure *measur
     }
 
     // trills
-    if (regex_search(incipit + i + 1, std::regex("^[^A-G]*t"))) {
+    if (HasBeforeNextPitch(incipit + i + 1, 't')) {
         note->trill = true;
     }
 
@@ -2528,6 +2583,8 @@ void PAEInput::LogPAE(int errCode, pae::Token &token, std::string value)
 
 void PAEInput::LogDebugTokens(bool vertical)
 {
+    // Nothing is logged by LogDebug in non-debug builds
+#if defined(DEBUG)
     // For long incipits or to see full class name
     if (vertical) {
         for (auto &token : m_pae) {
@@ -2542,9 +2599,10 @@ void PAEInput::LogDebugTokens(bool vertical)
         std::string row;
         for (auto &token : m_pae) {
             char c = (token.m_inputChar) ? token.m_inputChar : ' ';
+            // Escape % since the row is used as a format string
+            if (c == '%') row.push_back(c);
             row.push_back(c);
         }
-        row = std::regex_replace(row, std::regex("%"), "%%");
         LogDebug(row.c_str());
         if (m_hasErrors) {
             row.clear();
@@ -2566,6 +2624,7 @@ void PAEInput::LogDebugTokens(bool vertical)
             row.push_back(c);
         }
     }
+#endif
 }
 
 bool PAEInput::Is(pae::Token &token, const std::string &map)
@@ -2787,9 +2846,26 @@ bool PAEInput::Import(const std::string &input)
         data.erase(std::remove(data.begin(), data.end(), c), data.end());
     }
 
-    data = std::regex_replace(data, std::regex("qq"), "Q");
-    data = std::regex_replace(data, std::regex("xx"), "X");
-    data = std::regex_replace(data, std::regex("bb"), "Y");
+    // Replace qq, xx and bb with their internal character
+    std::string::iterator dataEnd = data.begin();
+    for (auto it = data.begin(); it != data.end(); ++it, ++dataEnd) {
+        *dataEnd = *it;
+        if ((std::next(it) == data.end()) || (*std::next(it) != *it)) continue;
+        if (*it == 'q') {
+            *dataEnd = 'Q';
+        }
+        else if (*it == 'x') {
+            *dataEnd = 'X';
+        }
+        else if (*it == 'b') {
+            *dataEnd = 'Y';
+        }
+        else {
+            continue;
+        }
+        ++it;
+    }
+    data.erase(dataEnd, data.end());
 
     int i = 0;
     for (char c : data) {
@@ -4723,12 +4799,13 @@ bool PAEInput::ParseMeterSig(MeterSig *meterSig, const std::string &paeStr, pae:
         return true;
     }
 
-    std::cmatch matches;
-    if (regex_match(paeStr.c_str(), matches, std::regex("(\\d+)/(\\d+)"))) {
-        meterSig->SetCount({ { std::stoi(matches[1]) }, MeterCountSign::None });
-        meterSig->SetUnit(std::stoi(matches[2]));
+    std::string count;
+    std::string unit;
+    if (MatchTimeSigFraction(paeStr, count, unit)) {
+        meterSig->SetCount({ { std::stoi(count) }, MeterCountSign::None });
+        meterSig->SetUnit(std::stoi(unit));
     }
-    else if (regex_match(paeStr.c_str(), matches, std::regex("\\d+"))) {
+    else if (IsDigits(paeStr)) {
         meterSig->SetCount({ { std::stoi(paeStr) }, MeterCountSign::None });
         meterSig->SetUnit(1);
         meterSig->SetForm(METERFORM_num);
@@ -4778,41 +4855,16 @@ bool PAEInput::ParseMensur(Mensur *mensur, const std::string &paeStr, pae::Token
         return true;
     }
 
-    std::cmatch matches;
-    if (regex_match(paeStr.c_str(), matches, std::regex("(\\d+)/(\\d+)"))) {
-        mensur->SetNum(std::stoi(matches[1]));
-        mensur->SetNumbase(std::stoi(matches[2]));
+    std::string num;
+    std::string numbase;
+    if (MatchTimeSigFraction(paeStr, num, numbase)) {
+        mensur->SetNum(std::stoi(num));
+        mensur->SetNumbase(std::stoi(numbase));
     }
-    else if (regex_match(paeStr.c_str(), matches, std::regex("\\d+"))) {
+    else if (IsDigits(paeStr)) {
         mensur->SetNum(std::stoi(paeStr.c_str()));
     }
-    else if (regex_match(paeStr.c_str(), matches, std::regex("([co])([\\./]?)([\\./]?)(\\d*)/?(\\d*)"))) {
-        // C
-        if (matches[1] == "c") {
-            mensur->SetSign(MENSURATIONSIGN_C);
-        }
-        // O
-        else {
-            mensur->SetSign(MENSURATIONSIGN_O);
-        }
-        // Dot (second or third match since order between . and / is not defined in PAE)
-        if ((matches[2] == ".") || (matches[3] == ".")) {
-            mensur->SetDot(BOOLEAN_true);
-        }
-        // Slash (second or third match, ditto)
-        if ((matches[2] == "/") || (matches[3] == "/")) {
-            mensur->SetSlash(1);
-        }
-        // Num
-        if (matches[4] != "") {
-            mensur->SetNum(std::stoi(matches[4]));
-        }
-        // Numbase (but only if Num is given)
-        if ((matches[4] != "") && (matches[5] != "")) {
-            mensur->SetNumbase(std::stoi(matches[5]));
-        }
-    }
-    else {
+    else if (!ParseMensurSign(paeStr, mensur)) {
         LogPAE(ERR_048_TIMESIG_INVALID, token, paeStr);
         if (m_pedanticMode) return false;
     }
@@ -110,9 +110,9 @@ void KeySig::Reset()
     m_drawingCancelAccidCount = 0;
 }
 
-void KeySig::FilterList(ListOfConstObjects &childList) const
+void KeySig::FilterList(ArrayOfConstObjects &childList) const
 {
-    ListOfConstObjects::iterator iter = childList.begin();
+    ArrayOfConstObjects::iterator iter = childList.begin();
     while (iter != childList.end()) {
         if ((*iter)->Is(KEYACCID))
             ++iter;
@@ -161,7 +161,7 @@ data_ACCIDENTAL_WRITTEN KeySig::GetAccidType() const
 
 bool KeySig::HasNonAttribKeyAccidChildren() const
 {
-    const ListOfConstObjects &childList = this->GetList(this);
+    const ArrayOfConstObjects &childList = this->GetList(this);
     return std::any_of(childList.begin(), childList.end(), [](const Object *child) { return !child->IsAttribute(); });
 }
 
@@ -192,7 +192,7 @@ void KeySig::FillMap(MapOfPitchAccid &mapOfPitchAccid) const
 {
     mapOfPitchAccid.clear();
 
-    const ListOfConstObjects &childList = this->GetList(this); // make sure it's initialized
+    const ArrayOfConstObjects &childList = this->GetList(this); // make sure it's initialized
     if (!childList.empty()) {
         for (auto &child : childList) {
             const KeyAccid *keyAccid = vrv_cast<const KeyAccid *>(child);
@@ -241,7 +241,7 @@ int KeySig::GetFifthsInt() const
 data_KEYSIGNATURE KeySig::ConvertToSig() const
 {
     data_KEYSIGNATURE sig = std::make_pair(-1, ACCIDENTAL_WRITTEN_NONE);
-    const ListOfConstObjects &childList = this->GetList(this);
+    const ArrayOfConstObjects &childList = this->GetList(this);
     if (childList.size() > 1) {
         data_ACCIDENTAL_WRITTEN accidType = ACCIDENTAL_WRITTEN_NONE;
         bool isCommon = true;
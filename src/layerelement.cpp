@@ -1528,14 +1528,14 @@ int LayerElement::CalcAlignmentPitchPos(FunctorParams *functorParams)
             if (beam) {
                 beam->ResetList(beam);
 
-                const ListOfObjects &beamList = beam->GetList(beam);
+                const ArrayOfObjects &beamList = beam->GetList(beam);
                 const int restIndex = beam->GetListIndex(rest);
                 assert(restIndex >= 0);
 
                 int leftLoc = loc;
-                ListOfObjects::const_iterator it = beamList.begin();
+                ArrayOfObjects::const_iterator it = beamList.begin();
                 std::advance(it, restIndex);
-                ListOfObjects::const_reverse_iterator rit(it);
+                ArrayOfObjects::const_reverse_iterator rit(it);
                 // iterate through the elements from the rest to the beginning of the beam
                 // until we hit a note or chord, which we will use to determine where the rest should be placed
                 for (; rit != beamList.rend(); ++rit) {
@@ -2405,10 +2405,12 @@ int LayerElement::PrepareTimePointing(FunctorParams *functorParams)
     // Do not look for tstamp pointing to these
     if (this->Is({ ARTIC, BEAM, FLAG, TUPLET, STEM, VERSE })) return FUNCTOR_CONTINUE;
 
-    ListOfPointingInterClassIdPairs::iterator iter = params->m_timePointingInterfaces.begin();
-    while (iter != params->m_timePointingInterfaces.end()) {
-        if (iter->first->SetStartOnly(this)) {
-            // We have both the start and the end that are matched
+    // Only look at the interfaces pointing to this element
+    auto range = params->m_timePointingInterfaces.equal_range(this->GetID());
+    auto iter = range.first;
+    while (iter != range.second) {
+        if (iter->second.first->SetStartOnly(this)) {
+            // We have the start that is matched
             iter = params->m_timePointingInterfaces.erase(iter);
         }
         else {
@@ -2429,12 +2431,17 @@ int LayerElement::PrepareTimeSpanning(FunctorParams *functorParams)
     // Do not look for tstamp pointing to these
     if (this->Is({ ARTIC, BEAM, FLAG, TUPLET, STEM, VERSE })) return FUNCTOR_CONTINUE;
 
-    ListOfSpanningInterOwnerPairs::iterator iter = params->m_timeSpanningInterfaces.begin();
-    while (iter != params->m_timeSpanningInterfaces.end()) {
-        if (iter->first->SetStartAndEnd(this)) {
+    // Only look at the interfaces with a start or an end pointing to this element
+    auto range = params->m_timeSpanningInterfaces.equal_range(this->GetID());
+    auto iter = range.first;
+    while (iter != range.second) {
+        TimeSpanningInterface *interface = iter->second.first;
+        if (interface->SetStartAndEnd(this)) {
             // Verify that the interface owner is encoded in the measure of its start
-            iter->first->VerifyMeasure(iter->second);
-            // We have both the start and the end that are matched
+            interface->VerifyMeasure(iter->second.second);
+        }
+        // Identical @startid and @endid are matched one after the other, so the entry remains until both are
+        if (!interface->IsWaitingFor(this->GetID())) {
             iter = params->m_timeSpanningInterfaces.erase(iter);
         }
         else {
@@ -140,6 +140,7 @@ void Measure::Reset()
     m_cachedXRel = VRV_UNSET;
     m_cachedOverflow = VRV_UNSET;
     m_cachedWidth = VRV_UNSET;
+    m_cachedJustifiableWidth = VRV_UNSET;
 
     // by default, we have a single barLine on the right (none on the left)
     m_rightBarLine.SetForm(this->GetRight());
@@ -192,14 +193,18 @@ void Measure::AddChildBack(Object *child)
     ArrayOfObjects &children = this->GetChildrenForModification();
     if (children.empty()) {
         children.push_back(child);
+        this->UpdateChildIndices((int)children.size() - 1);
     }
     else if (children.back()->Is(STAFF)) {
         children.push_back(child);
+        this->UpdateChildIndices((int)children.size() - 1);
     }
     else {
         for (auto it = children.begin(); it != children.end(); ++it) {
             if (!(*it)->Is(STAFF)) {
+                const int idx = (int)std::distance(children.begin(), it);
                 children.insert(it, child);
+                this->UpdateChildIndices(idx);
                 break;
             }
         }
@@ -241,8 +246,13 @@ void Measure::SetDrawingXRel(int drawingXRel)
 
 bool Measure::IsFirstInSystem() const
 {
-    assert(this->GetParent());
-    return (this->GetParent()->GetFirst(MEASURE) == this);
+    const Object *system = this->GetParent();
+    assert(system);
+    // Do not use Object::GetFirst since it changes the iterator of the system shared by all the measures
+    for (int i = 0; i < system->GetChildCount(); ++i) {
+        if (system->GetChild(i)->Is(MEASURE)) return (system->GetChild(i) == this);
+    }
+    return false;
 }
 
 bool Measure::IsLastInSystem() const
@@ -470,8 +480,7 @@ const Staff *Measure::GetBottomVisibleStaff() const
 int Measure::EnclosesTime(int time) const
 {
     int repeat = 1;
-    double timeDuration
-        = m_measureAligner.GetRightAlignment()->GetTime() * DURATION_4 / DUR_MAX * 60.0 / m_currentTempo * 1000.0 + 0.5;
+    double timeDuration = this->GetRealTimeDurationMilliseconds();
     std::vector<double>::const_iterator iter;
     for (iter = m_realTimeOffsetMilliseconds.begin(); iter != m_realTimeOffsetMilliseconds.end(); ++iter) {
         if ((time >= *iter) && (time <= *iter + timeDuration)) return repeat;
@@ -486,6 +495,18 @@ double Measure::GetRealTimeOffsetMilliseconds(int repeat) const
     return m_realTimeOffsetMilliseconds.at(repeat - 1);
 }
 
+double Measure::GetScoreTimeOffset(int repeat) const
+{
+    if ((repeat < 1) || repeat > (int)m_scoreTimeOffset.size()) return 0;
+    return m_scoreTimeOffset.at(repeat - 1);
+}
+
+double Measure::GetRealTimeDurationMilliseconds() const
+{
+    return m_measureAligner.GetRightAlignment()->GetTime() * DURATION_4 / DUR_MAX * 60.0 / m_currentTempo * 1000.0
+        + 0.5;
+}
+
 data_BARRENDITION Measure::GetDrawingLeftBarLineByStaffN(int staffN) const
 {
     auto elementIter = m_invisibleStaffBarlines.find(staffN);
@@ -1218,8 +1239,15 @@ int Measure::AlignMeasures(FunctorParams *functorParams)
 
     this->SetDrawingXRel(params->m_shift);
 
-    params->m_shift += this->GetWidth();
-    params->m_justifiableWidth += this->GetRightBarLineXRel() - this->GetLeftBarLineXRel();
+    // When casting off, use the cached values because the aligner can still hold the layout of a justified page
+    if (params->m_storeCastOffSystemWidths && this->HasCachedHorizontalLayout()) {
+        params->m_shift += m_cachedWidth;
+        params->m_justifiableWidth += m_cachedJustifiableWidth;
+    }
+    else {
+        params->m_shift += this->GetWidth();
+        params->m_justifiableWidth += this->GetRightBarLineXRel() - this->GetLeftBarLineXRel();
+    }
 
     return FUNCTOR_SIBLINGS;
 }
@@ -1473,10 +1501,7 @@ int Measure::PrepareTimePointingEnd(FunctorParams *functorParams)
             params->m_timePointingInterfaces.size(), this->GetID().c_str());
     }
 
-    ListOfPointingInterClassIdPairs::iterator iter = params->m_timePointingInterfaces.begin();
-    while (iter != params->m_timePointingInterfaces.end()) {
-        iter = params->m_timePointingInterfaces.erase(iter);
-    }
+    params->m_timePointingInterfaces.clear();
 
     return FUNCTOR_CONTINUE;
 }
@@ -1486,12 +1511,12 @@ int Measure::PrepareTimeSpanningEnd(FunctorParams *functorParams)
     PrepareTimeSpanningParams *params = vrv_params_cast<PrepareTimeSpanningParams *>(functorParams);
     assert(params);
 
-    ListOfSpanningInterOwnerPairs::iterator iter = params->m_timeSpanningInterfaces.begin();
+    MapOfSpanningInterOwnerPairs::iterator iter = params->m_timeSpanningInterfaces.begin();
     while (iter != params->m_timeSpanningInterfaces.end()) {
         // At the end of the measure (going backward) we remove element for which we do not need to match the end (for
         // now). Eventually, we could consider them, for example if we want to display their spanning or for improved
         // midi output
-        if (iter->second->GetClassId() == HARM) {
+        if (iter->second.second->GetClassId() == HARM) {
             iter = params->m_timeSpanningInterfaces.erase(iter);
         }
         else {
@@ -1680,6 +1705,7 @@ int Measure::UnCastOff(FunctorParams *functorParams)
         m_cachedXRel = VRV_UNSET;
         m_cachedWidth = VRV_UNSET;
         m_cachedOverflow = VRV_UNSET;
+        m_cachedJustifiableWidth = VRV_UNSET;
     }
 
     return FUNCTOR_CONTINUE;
@@ -1696,6 +1722,7 @@ int Measure::CacheHorizontalLayout(FunctorParams *functorParams)
     else {
         m_cachedWidth = this->GetWidth();
         m_cachedOverflow = this->GetDrawingOverflow();
+        m_cachedJustifiableWidth = this->GetRightBarLineXRel() - this->GetLeftBarLineXRel();
         m_cachedXRel = m_drawingXRel;
     }
     if (this->GetLeftBarLine()) this->GetLeftBarLine()->CacheHorizontalLayout(functorParams);
@@ -65,7 +65,7 @@ bool MeterSigGrp::IsSupportedChild(Object *child)
     return true;
 }
 
-void MeterSigGrp::FilterList(ListOfConstObjects &childList) const
+void MeterSigGrp::FilterList(ArrayOfConstObjects &childList) const
 {
     // We want to keep only MeterSig
     childList.erase(std::remove_if(childList.begin(), childList.end(),
@@ -81,7 +81,7 @@ void MeterSigGrp::AddAlternatingMeasureToVector(const Measure *measure)
 MeterSig *MeterSigGrp::GetSimplifiedMeterSig() const
 {
     MeterSig *newMeterSig = NULL;
-    const ListOfConstObjects &childList = this->GetList(this);
+    const ArrayOfConstObjects &childList = this->GetList(this);
     switch (this->GetFunc()) {
         // For alternating meterSig group alternate between children sequentially
         case meterSigGrpLog_FUNC_alternating: {
@@ -182,9 +182,11 @@ void Note::AddChild(Object *child)
     // for the drawing order in the SVG output
     if (child->Is({ DOTS, STEM })) {
         children.insert(children.begin(), child);
+        this->UpdateChildIndices();
     }
     else {
         children.push_back(child);
+        this->UpdateChildIndices((int)children.size() - 1);
     }
     Modify();
 }
@@ -790,7 +792,7 @@ void Note::DeferMIDINote(FunctorParams *functorParams, double shift, bool includ
     // Recursive call for chords
     Chord *chord = this->IsChordTone();
     if (chord && includeChordSiblings) {
-        const ListOfObjects &notes = chord->GetList(chord);
+        const ArrayOfObjects &notes = chord->GetList(chord);
 
         for (Object *obj : notes) {
             Note *note = vrv_cast<Note *>(obj);
@@ -98,8 +98,10 @@ Object::Object(const Object &object) : BoundingBox(object)
     this->ResetBoundingBox(); // It does not make sense to keep the values of the BBox
 
     m_classId = object.m_classId;
-    m_classIdStr = object.m_classIdStr;
+    m_classIdChar = object.m_classIdChar;
     m_parent = NULL;
+    m_childIdx = -1;
+    m_idIndex = NULL;
 
     // Flags
     m_isAttribute = object.m_isAttribute;
@@ -128,6 +130,7 @@ Object::Object(const Object &object) : BoundingBox(object)
             clone->SetParent(this);
             clone->CloneReset();
             m_children.push_back(clone);
+            clone->m_childIdx = (int)m_children.size() - 1;
         }
     }
 }
@@ -144,11 +147,14 @@ Object &Object::operator=(const Object &object)
     // not self assignement
     if (this != &object) {
         ClearChildren();
+        // The object is not attached anymore
+        this->SetIDIndex(NULL);
         this->ResetBoundingBox(); // It does not make sense to keep the values of the BBox
 
         m_classId = object.m_classId;
-        m_classIdStr = object.m_classIdStr;
+        m_classIdChar = object.m_classIdChar;
         m_parent = NULL;
+        m_childIdx = -1;
         // Flags
         m_isAttribute = object.m_isAttribute;
         m_isModified = true;
@@ -175,6 +181,7 @@ Object &Object::operator=(const Object &object)
                     clone->SetParent(this);
                     clone->CloneReset();
                     m_children.push_back(clone);
+                    clone->m_childIdx = (int)m_children.size() - 1;
                 }
             }
         }
@@ -184,6 +191,11 @@ Object &Object::operator=(const Object &object)
 
 Object::~Object()
 {
+    if (m_idIndex) {
+        const std::lock_guard<std::mutex> lock(m_idIndex->m_mutex);
+        this->EraseFromIDIndex();
+    }
+
     ClearChildren();
 }
 
@@ -192,15 +204,16 @@ void Object::Init(ClassId classId, const std::string &classIdStr)
     assert(classIdStr.size());
 
     m_classId = classId;
-    m_classIdStr = classIdStr;
+    m_classIdChar = classIdStr.at(0);
     m_parent = NULL;
+    m_childIdx = -1;
+    m_idIndex = NULL;
     // Flags
     m_isAttribute = false;
     m_isModified = true;
     m_isReferenceObject = false;
     // Comments
-    m_comment = "";
-    m_closingComment = "";
+    m_comments.reset();
 
     this->GenerateID();
 
@@ -243,8 +256,20 @@ void Object::Reset()
 
 void Object::RegisterInterface(std::vector<AttClassId> *attClasses, InterfaceId interfaceId)
 {
-    m_attClasses.insert(m_attClasses.end(), attClasses->begin(), attClasses->end());
-    m_interfaces.push_back(interfaceId);
+    for (AttClassId attClassId : *attClasses) m_attClasses.set(attClassId);
+    m_interfaces.set(interfaceId);
+}
+
+void Object::SetComment(std::string comment)
+{
+    if (!m_comments) m_comments = std::make_unique<std::pair<std::string, std::string>>();
+    m_comments->first = comment;
+}
+
+void Object::SetClosingComment(std::string endComment)
+{
+    if (!m_comments) m_comments = std::make_unique<std::pair<std::string, std::string>>();
+    m_comments->second = endComment;
 }
 
 bool Object::IsMilestoneElement()
@@ -296,6 +321,7 @@ void Object::MoveChildrenFrom(Object *sourceParent, int idx, bool allowTypeChang
         }
         else {
             m_children.push_back(child);
+            child->m_childIdx = (int)m_children.size() - 1;
         }
     }
 }
@@ -309,6 +335,7 @@ void Object::ReplaceChild(Object *currentChild, Object *replacingChild)
     currentChild->ResetParent();
     m_children.at(idx) = replacingChild;
     replacingChild->SetParent(this);
+    replacingChild->m_childIdx = idx;
     this->Modify();
 }
 
@@ -339,6 +366,7 @@ void Object::InsertAfter(Object *child, Object *newChild)
 void Object::SortChildren(Object::binaryComp comp)
 {
     std::stable_sort(m_children.begin(), m_children.end(), comp);
+    this->UpdateChildIndices();
     this->Modify();
 }
 
@@ -353,6 +381,19 @@ void Object::MoveItselfTo(Object *targetParent)
     targetParent->AddChild(relinquishedObject);
 }
 
+void Object::SetID(const std::string &id)
+{
+    if (m_idIndex) {
+        const std::lock_guard<std::mutex> lock(m_idIndex->m_mutex);
+        this->EraseFromIDIndex();
+        m_id = id;
+        m_idIndex->m_objects.emplace(m_id, this);
+    }
+    else {
+        m_id = id;
+    }
+}
+
 void Object::SwapID(Object *other)
 {
     assert(other);
@@ -449,10 +490,12 @@ Object *Object::GetFirst(const ClassId classId)
 
 const Object *Object::GetFirst(const ClassId classId) const
 {
-    m_iteratorElementType = classId;
-    m_iteratorEnd = m_children.end();
-    m_iteratorCurrent = std::find_if(m_children.begin(), m_iteratorEnd, ObjectComparison(m_iteratorElementType));
-    return (m_iteratorCurrent == m_iteratorEnd) ? NULL : *m_iteratorCurrent;
+    if (!m_iterator) m_iterator = std::make_unique<ObjectIterator>();
+    m_iterator->m_elementType = classId;
+    m_iterator->m_end = m_children.end();
+    m_iterator->m_current
+        = std::find_if(m_children.begin(), m_iterator->m_end, ObjectComparison(m_iterator->m_elementType));
+    return (m_iterator->m_current == m_iterator->m_end) ? NULL : *m_iterator->m_current;
 }
 
 Object *Object::GetNext()
@@ -462,9 +505,12 @@ Object *Object::GetNext()
 
 const Object *Object::GetNext() const
 {
-    ++m_iteratorCurrent;
-    m_iteratorCurrent = std::find_if(m_iteratorCurrent, m_iteratorEnd, ObjectComparison(m_iteratorElementType));
-    return (m_iteratorCurrent == m_iteratorEnd) ? NULL : *m_iteratorCurrent;
+    assert(m_iterator);
+
+    ++m_iterator->m_current;
+    m_iterator->m_current
+        = std::find_if(m_iterator->m_current, m_iterator->m_end, ObjectComparison(m_iterator->m_elementType));
+    return (m_iterator->m_current == m_iterator->m_end) ? NULL : *m_iterator->m_current;
 }
 
 Object *Object::GetNext(const Object *child, const ClassId classId)
@@ -474,9 +520,10 @@ Object *Object::GetNext(const Object *child, const ClassId classId)
 
 const Object *Object::GetNext(const Object *child, const ClassId classId) const
 {
+    const int idx = this->GetChildIndex(child);
     ArrayOfObjects::const_iterator iteratorEnd, iteratorCurrent;
     iteratorEnd = m_children.end();
-    iteratorCurrent = std::find(m_children.begin(), iteratorEnd, child);
+    iteratorCurrent = (idx == -1) ? iteratorEnd : m_children.begin() + idx;
     if (iteratorCurrent != iteratorEnd) {
         ++iteratorCurrent;
         iteratorCurrent = std::find_if(iteratorCurrent, iteratorEnd, ObjectComparison(classId));
@@ -491,9 +538,12 @@ Object *Object::GetPrevious(const Object *child, const ClassId classId)
 
 const Object *Object::GetPrevious(const Object *child, const ClassId classId) const
 {
+    const int idx = this->GetChildIndex(child);
     ArrayOfObjects::const_reverse_iterator riteratorEnd, riteratorCurrent;
     riteratorEnd = m_children.rend();
-    riteratorCurrent = std::find(m_children.rbegin(), riteratorEnd, child);
+    // The reverse iterator of the position after the child points to the child
+    riteratorCurrent
+        = (idx == -1) ? riteratorEnd : ArrayOfObjects::const_reverse_iterator(m_children.begin() + idx + 1);
     if (riteratorCurrent != riteratorEnd) {
         ++riteratorCurrent;
         riteratorCurrent = std::find_if(riteratorCurrent, riteratorEnd, ObjectComparison(classId));
@@ -527,10 +577,12 @@ void Object::InsertChild(Object *element, int idx)
 
     if (idx >= (int)m_children.size()) {
         m_children.push_back(element);
+        element->m_childIdx = (int)m_children.size() - 1;
         return;
     }
     ArrayOfObjects::iterator iter = m_children.begin();
     m_children.insert(iter + (idx), element);
+    this->UpdateChildIndices(idx);
 }
 
 Object *Object::DetachChild(int idx)
@@ -540,8 +592,10 @@ Object *Object::DetachChild(int idx)
     }
     Object *child = m_children.at(idx);
     child->ResetParent();
+    child->m_childIdx = -1;
     ArrayOfObjects::iterator iter = m_children.begin();
     m_children.erase(iter + (idx));
+    this->UpdateChildIndices(idx);
     return child;
 }
 
@@ -568,6 +622,7 @@ Object *Object::Relinquish(int idx)
     }
     Object *child = m_children.at(idx);
     child->ResetParent();
+    child->m_childIdx = -1;
     return child;
 }
 
@@ -581,6 +636,7 @@ void Object::ClearRelinquishedChildren()
         else
             ++iter;
     }
+    this->UpdateChildIndices();
 }
 
 Object *Object::FindDescendantByID(const std::string &id, int deepness, bool direction)
@@ -591,6 +647,29 @@ Object *Object::FindDescendantByID(const std::string &id, int deepness, bool dir
 const Object *Object::FindDescendantByID(const std::string &id, int deepness, bool direction) const
 {
     Functor findByID(&Object::FindByID);
+
+    // Use the ID index when searching the full subtree - the children of reference objects are not owned
+    if (m_idIndex && (deepness == UNLIMITED_DEPTH) && !m_isReferenceObject) {
+        ArrayOfConstObjects candidates;
+        {
+            const std::lock_guard<std::mutex> lock(m_idIndex->m_mutex);
+            auto range = m_idIndex->m_objects.equal_range(id);
+            for (auto iter = range.first; iter != range.second; ++iter) candidates.push_back(iter->second);
+        }
+        const Object *element = NULL;
+        bool isAmbiguous = false;
+        for (const Object *candidate : candidates) {
+            if (!this->IsIndexedDescendant(candidate, &findByID)) continue;
+            if (element) {
+                isAmbiguous = true;
+                break;
+            }
+            element = candidate;
+        }
+        // With duplicated IDs, we need the traversal order for finding the first one
+        if (!isAmbiguous) return element;
+    }
+
     FindByIDParams findByIDParams;
     findByIDParams.m_id = id;
     this->Process(&findByID, &findByIDParams, NULL, NULL, deepness, direction, true);
@@ -740,7 +819,8 @@ bool Object::DeleteChild(Object *child)
 {
     auto it = std::find(m_children.begin(), m_children.end(), child);
     if (it != m_children.end()) {
-        m_children.erase(it);
+        it = m_children.erase(it);
+        this->UpdateChildIndices((int)(it - m_children.begin()));
         if (!m_isReferenceObject) {
             delete child;
         }
@@ -767,13 +847,16 @@ int Object::DeleteChildrenByComparison(Comparison *comparison)
             ++iter;
         }
     }
-    if (count > 0) this->Modify();
+    if (count > 0) {
+        this->UpdateChildIndices();
+        this->Modify();
+    }
     return count;
 }
 
 void Object::GenerateID()
 {
-    m_id = m_classIdStr.at(0) + Object::GenerateRandID();
+    this->SetID(m_classIdChar + Object::GenerateRandID());
 }
 
 void Object::ResetID()
@@ -785,6 +868,63 @@ void Object::SetParent(Object *parent)
 {
     assert(!m_parent);
     m_parent = parent;
+
+    if (parent && parent->m_idIndex) this->SetIDIndex(parent->m_idIndex);
+}
+
+void Object::SetTemporaryParent(Object *parent)
+{
+    assert(!m_parent);
+    m_parent = parent;
+}
+
+void Object::SetIDIndex(IDIndex *idIndex)
+{
+    if (m_idIndex == idIndex) return;
+
+    if (m_idIndex) {
+        const std::lock_guard<std::mutex> lock(m_idIndex->m_mutex);
+        this->EraseFromIDIndex();
+    }
+    m_idIndex = idIndex;
+    if (m_idIndex) {
+        const std::lock_guard<std::mutex> lock(m_idIndex->m_mutex);
+        m_idIndex->m_objects.emplace(m_id, this);
+    }
+
+    if (m_isReferenceObject) return;
+
+    for (Object *child : m_children) {
+        // Relinquished children are registered with their new parent
+        if (child->m_parent == this) child->SetIDIndex(idIndex);
+    }
+}
+
+void Object::EraseFromIDIndex()
+{
+    assert(m_idIndex);
+
+    auto range = m_idIndex->m_objects.equal_range(m_id);
+    for (auto iter = range.first; iter != range.second; ++iter) {
+        if (iter->second == this) {
+            m_idIndex->m_objects.erase(iter);
+            return;
+        }
+    }
+}
+
+bool Object::IsIndexedDescendant(const Object *object, Functor *functor) const
+{
+    if (object == this) return false;
+
+    // Go up to this object and make sure each one is an actual child visited by the functor
+    while (object != this) {
+        const Object *parent = object->m_parent;
+        if (!parent || (parent->GetChildIndex(object) == -1)) return false;
+        if (parent->SkipChildren(functor)) return false;
+        object = parent;
+    }
+    return true;
 }
 
 bool Object::IsSupportedChild(Object *child)
@@ -808,6 +948,7 @@ void Object::AddChild(Object *child)
 
     child->SetParent(this);
     m_children.push_back(child);
+    child->m_childIdx = (int)m_children.size() - 1;
     Modify();
 }
 
@@ -845,14 +986,22 @@ void Object::ResetCachedDrawingY() const
 
 int Object::GetChildIndex(const Object *child) const
 {
-    ArrayOfObjects::const_iterator iter;
-    int i;
-    for (iter = m_children.begin(), i = 0; iter != m_children.end(); ++iter, ++i) {
-        if (child == *iter) {
-            return i;
-        }
+    // The position is kept only for the children we own - look for the other ones (e.g., in reference objects)
+    const int idx = child->m_childIdx;
+    if ((child->m_parent == this) && (idx >= 0) && (idx < (int)m_children.size()) && (m_children.at(idx) == child)) {
+        return idx;
+    }
+
+    ArrayOfObjects::const_iterator iter = std::find(m_children.begin(), m_children.end(), child);
+    return (iter != m_children.end()) ? (int)std::distance(m_children.begin(), iter) : -1;
+}
+
+void Object::UpdateChildIndices(int startIdx)
+{
+    for (int i = startIdx; i < (int)m_children.size(); ++i) {
+        Object *child = m_children.at(i);
+        if (child->m_parent == this) child->m_childIdx = i;
     }
-    return -1;
 }
 
 int Object::GetDescendantIndex(const Object *child, const ClassId classId, int depth)
@@ -875,7 +1024,7 @@ void Object::Modify(bool modified) const
     m_isModified = modified;
 }
 
-void Object::FillFlatList(ListOfConstObjects &flatList) const
+void Object::FillFlatList(ArrayOfConstObjects &flatList) const
 {
     Functor addToFlatList(&Object::AddLayerElementToFlatList);
     AddLayerElementToFlatListParams addLayerElementToFlatListParams(&flatList);
@@ -1104,6 +1253,84 @@ void Object::Process(Functor *functor, FunctorParams *functorParams, Functor *en
     }
 }
 
+void Object::Process(const ArrayOfFunctorTuples &functors, Filters *filters, int deepness, bool direction)
+{
+    assert(functors.size() <= MAX_FUSED_FUNCTORS);
+
+    const unsigned int functorMask = (functors.size() == MAX_FUSED_FUNCTORS) ? ~0u : (1u << functors.size()) - 1;
+    this->ProcessFused(functors, functorMask, filters, deepness, direction);
+}
+
+void Object::ProcessFused(
+    const ArrayOfFunctorTuples &functors, unsigned int functorMask, Filters *filters, int deepness, bool direction)
+{
+    // Functors that have been stopped are not processed anymore
+    unsigned int calledMask = 0;
+    for (int i = 0; i < (int)functors.size(); ++i) {
+        if ((functorMask & (1u << i)) && (std::get<0>(functors.at(i))->m_returnCode != FUNCTOR_STOP)) {
+            calledMask |= (1u << i);
+        }
+    }
+    if (!calledMask) return;
+
+    // Update the current score stored in the document
+    this->UpdateDocumentScore(direction);
+
+    unsigned int endMask = 0;
+    for (int i = 0; i < (int)functors.size(); ++i) {
+        if (!(calledMask & (1u << i))) continue;
+        auto [functor, functorParams, endFunctor] = functors.at(i);
+        functor->Call(this, functorParams);
+        // do not go any deeper with this functor
+        if (functor->m_returnCode == FUNCTOR_SIBLINGS) {
+            functor->m_returnCode = FUNCTOR_CONTINUE;
+        }
+        else {
+            endMask |= (1u << i);
+        }
+    }
+    if (!endMask) return;
+
+    if (this->IsEditorialElement()) {
+        // since editorial object doesn't count, we increase the deepness limit
+        deepness++;
+    }
+    if (deepness == 0) return;
+    deepness--;
+
+    unsigned int childMask = endMask;
+    for (int i = 0; i < (int)functors.size(); ++i) {
+        if ((childMask & (1u << i)) && this->SkipChildren(std::get<0>(functors.at(i)))) {
+            childMask &= ~(1u << i);
+        }
+    }
+
+    if (childMask) {
+        if (direction == BACKWARD) {
+            for (ArrayOfObjects::reverse_iterator iter = m_children.rbegin(); iter != m_children.rend(); ++iter) {
+                // we will end here if there is no filter at all or for the current child type
+                if (this->FiltersApply(filters, *iter)) {
+                    (*iter)->ProcessFused(functors, childMask, filters, deepness, direction);
+                }
+            }
+        }
+        else {
+            for (ArrayOfObjects::iterator iter = m_children.begin(); iter != m_children.end(); ++iter) {
+                // we will end here if there is no filter at all or for the current child type
+                if (this->FiltersApply(filters, *iter)) {
+                    (*iter)->ProcessFused(functors, childMask, filters, deepness, direction);
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < (int)functors.size(); ++i) {
+        if (!(endMask & (1u << i))) continue;
+        Functor *endFunctor = std::get<2>(functors.at(i));
+        if (endFunctor) endFunctor->Call(this, std::get<1>(functors.at(i)));
+    }
+}
+
 void Object::UpdateDocumentScore(bool direction)
 {
     // When we are starting a new score, we need to update the current score in the document
@@ -1205,6 +1432,8 @@ void Object::SeedID(unsigned int seed)
     else {
         s_randomGenerator.seed(seed);
     }
+    // Make sure the first object created on the thread does not seed the generator again
+    if (s_objectCounter == 0) s_objectCounter = 1;
 }
 
 std::string Object::GenerateRandID()
@@ -1218,6 +1447,12 @@ std::string Object::GenerateRandID()
     return BaseEncodeInt(nr, 36);
 }
 
+unsigned int Object::GenerateRandSeed()
+{
+    unsigned int seed = s_randomGenerator();
+    return (seed == 0) ? 1 : seed;
+}
+
 bool Object::sortByUlx(Object *a, Object *b)
 {
     FacsimileInterface *fa = NULL, *fb = NULL;
@@ -1306,6 +1541,7 @@ ObjectListInterface::ObjectListInterface(const ObjectListInterface &interface)
 {
     // actually nothing to do, we just don't want the list to be copied
     m_list.clear();
+    m_listIndices.clear();
 }
 
 ObjectListInterface &ObjectListInterface::operator=(const ObjectListInterface &interface)
@@ -1313,6 +1549,7 @@ ObjectListInterface &ObjectListInterface::operator=(const ObjectListInterface &i
     // actually nothing to do, we just don't want the list to be copied
     if (this != &interface) {
         m_list.clear();
+        m_listIndices.clear();
     }
     return *this;
 }
@@ -1328,18 +1565,26 @@ void ObjectListInterface::ResetList(const Object *node) const
     m_list.clear();
     node->FillFlatList(m_list);
     this->FilterList(m_list);
+
+    m_listIndices.clear();
+    m_listIndices.reserve(m_list.size());
+    for (int i = 0; i < (int)m_list.size(); ++i) {
+        // Keep the first position if an object appears more than once
+        m_listIndices.try_emplace(m_list.at(i), i);
+    }
 }
 
-const ListOfConstObjects &ObjectListInterface::GetList(const Object *node) const
+const ArrayOfConstObjects &ObjectListInterface::GetList(const Object *node) const
 {
     this->ResetList(node);
     return m_list;
 }
 
-ListOfObjects ObjectListInterface::GetList(const Object *node)
+ArrayOfObjects ObjectListInterface::GetList(const Object *node)
 {
     this->ResetList(node);
-    ListOfObjects result;
+    ArrayOfObjects result;
+    result.reserve(m_list.size());
     std::transform(m_list.begin(), m_list.end(), std::back_inserter(result),
         [](const Object *obj) { return const_cast<Object *>(obj); });
     return result;
@@ -1383,24 +1628,17 @@ Object *ObjectListInterface::GetListBack(const Object *node)
 
 int ObjectListInterface::GetListIndex(const Object *listElement) const
 {
-    ListOfConstObjects::iterator iter;
-    int i;
-    for (iter = m_list.begin(), i = 0; iter != m_list.end(); ++iter, ++i) {
-        if (listElement == *iter) {
-            return i;
-        }
-    }
-    return -1;
+    auto iter = m_listIndices.find(listElement);
+    return (iter == m_listIndices.end()) ? -1 : iter->second;
 }
 
 const Object *ObjectListInterface::GetListFirst(const Object *startFrom, const ClassId classId) const
 {
-    ListOfConstObjects::iterator it = m_list.begin();
     int idx = this->GetListIndex(startFrom);
     if (idx == -1) return NULL;
-    std::advance(it, idx);
-    it = std::find_if(it, m_list.end(), ObjectComparison(classId));
-    return (it == m_list.end()) ? NULL : *it;
+    ArrayOfConstObjects::const_iterator it = m_list.begin() + idx;
+    it = std::find_if(it, m_list.cend(), ObjectComparison(classId));
+    return (it == m_list.cend()) ? NULL : *it;
 }
 
 Object *ObjectListInterface::GetListFirst(const Object *startFrom, const ClassId classId)
@@ -1410,13 +1648,12 @@ Object *ObjectListInterface::GetListFirst(const Object *startFrom, const ClassId
 
 const Object *ObjectListInterface::GetListFirstBackward(const Object *startFrom, const ClassId classId) const
 {
-    ListOfConstObjects::iterator it = m_list.begin();
     int idx = this->GetListIndex(startFrom);
     if (idx == -1) return NULL;
-    std::advance(it, idx);
-    ListOfConstObjects::reverse_iterator rit(it);
-    rit = std::find_if(rit, m_list.rend(), ObjectComparison(classId));
-    return (rit == m_list.rend()) ? NULL : *rit;
+    // The search starts with the object before startFrom
+    ArrayOfConstObjects::const_reverse_iterator rit(m_list.begin() + idx);
+    rit = std::find_if(rit, m_list.crend(), ObjectComparison(classId));
+    return (rit == m_list.crend()) ? NULL : *rit;
 }
 
 Object *ObjectListInterface::GetListFirstBackward(const Object *startFrom, const ClassId classId)
@@ -1426,19 +1663,8 @@ Object *ObjectListInterface::GetListFirstBackward(const Object *startFrom, const
 
 const Object *ObjectListInterface::GetListPrevious(const Object *listElement) const
 {
-    ListOfConstObjects::iterator iter;
-    int i;
-    for (iter = m_list.begin(), i = 0; iter != m_list.end(); ++iter, ++i) {
-        if (listElement == *iter) {
-            if (i > 0) {
-                return *(--iter);
-            }
-            else {
-                return NULL;
-            }
-        }
-    }
-    return NULL;
+    int idx = this->GetListIndex(listElement);
+    return (idx > 0) ? m_list.at(idx - 1) : NULL;
 }
 
 Object *ObjectListInterface::GetListPrevious(const Object *listElement)
@@ -1448,19 +1674,8 @@ Object *ObjectListInterface::GetListPrevious(const Object *listElement)
 
 const Object *ObjectListInterface::GetListNext(const Object *listElement) const
 {
-    ListOfConstObjects::reverse_iterator iter;
-    int i;
-    for (iter = m_list.rbegin(), i = 0; iter != m_list.rend(); ++iter, ++i) {
-        if (listElement == *iter) {
-            if (i > 0) {
-                return *(--iter);
-            }
-            else {
-                return NULL;
-            }
-        }
-    }
-    return NULL;
+    int idx = this->GetListIndex(listElement);
+    return ((idx != -1) && (idx + 1 < (int)m_list.size())) ? m_list.at(idx + 1) : NULL;
 }
 
 Object *ObjectListInterface::GetListNext(const Object *listElement)
@@ -1476,8 +1691,8 @@ std::wstring TextListInterface::GetText(const Object *node) const
 {
     // alternatively we could cache the concatString in the interface and instantiate it in FilterList
     std::wstring concatText;
-    const ListOfConstObjects &childList = this->GetList(node); // make sure it's initialized
-    for (ListOfConstObjects::const_iterator it = childList.begin(); it != childList.end(); ++it) {
+    const ArrayOfConstObjects &childList = this->GetList(node); // make sure it's initialized
+    for (ArrayOfConstObjects::const_iterator it = childList.begin(); it != childList.end(); ++it) {
         if ((*it)->Is(LB)) {
             continue;
         }
@@ -1492,8 +1707,8 @@ void TextListInterface::GetTextLines(const Object *node, std::vector<std::wstrin
 {
     // alternatively we could cache the concatString in the interface and instantiate it in FilterList
     std::wstring concatText;
-    const ListOfConstObjects &childList = this->GetList(node); // make sure it's initialized
-    for (ListOfConstObjects::const_iterator it = childList.begin(); it != childList.end(); ++it) {
+    const ArrayOfConstObjects &childList = this->GetList(node); // make sure it's initialized
+    for (ArrayOfConstObjects::const_iterator it = childList.begin(); it != childList.end(); ++it) {
         if ((*it)->Is(LB) && !concatText.empty()) {
             lines.push_back(concatText);
             concatText.clear();
@@ -1508,9 +1723,9 @@ void TextListInterface::GetTextLines(const Object *node, std::vector<std::wstrin
     }
 }
 
-void TextListInterface::FilterList(ListOfConstObjects &childList) const
+void TextListInterface::FilterList(ArrayOfConstObjects &childList) const
 {
-    ListOfConstObjects::iterator iter = childList.begin();
+    ArrayOfConstObjects::iterator iter = childList.begin();
     while (iter != childList.end()) {
         if (!(*iter)->Is({ LB, TEXT })) {
             // remove anything that is not an LayerElement (e.g. Verse, Syl, etc. but keep Lb)
@@ -1934,11 +2149,9 @@ int Object::PrepareProcessPlist(FunctorParams *functorParams)
 
     if (!this->IsLayerElement()) return FUNCTOR_CONTINUE;
 
-    std::string id = this->GetID();
-    auto i = std::find_if(params->m_interfaceIDTuples.begin(), params->m_interfaceIDTuples.end(),
-        [&id](std::tuple<PlistInterface *, std::string, Object *> tuple) { return (std::get<1>(tuple) == id); });
-    if (i != params->m_interfaceIDTuples.end()) {
-        std::get<2>(*i) = this;
+    auto range = params->m_interfaceIDIndices.equal_range(this->GetID());
+    for (auto i = range.first; i != range.second; ++i) {
+        std::get<2>(params->m_interfaceIDTuples.at(i->second)) = this;
     }
 
     return FUNCTOR_CONTINUE;
@@ -2449,6 +2662,7 @@ int Object::ReorderByXPos(FunctorParams *functorParams)
     }
 
     std::stable_sort(m_children.begin(), m_children.end(), sortByUlx);
+    this->UpdateChildIndices();
     this->Modify();
     return FUNCTOR_CONTINUE;
 }
@@ -870,6 +870,13 @@ Options::Options()
     m_standardOutput.SetShortOption(' ', true);
     m_baseOptions.AddOption(&m_standardOutput);
 
+    m_records.SetInfo("Records",
+        "Render each record of the input file to SVG, with one record per \"line\" or \"block\" of non-empty lines");
+    m_records.Init("");
+    m_records.SetKey("records");
+    m_records.SetShortOption(' ', true);
+    m_baseOptions.AddOption(&m_records);
+
     m_help.SetInfo("Help", "Display this message");
     m_help.Init(false);
     m_help.SetKey("help");
@@ -936,6 +943,7 @@ Options::Options()
 
     m_general.SetLabel("Input and page configuration options", "1-general");
     m_general.SetCategory(OptionsCategory::General);
+    m_general.SetStage(OptionStage::DataPreparation);
     m_grps.push_back(&m_general);
 
     m_adjustPageHeight.SetInfo("Adjust page height", "Adjust the page height to the height of the content");
@@ -945,37 +953,45 @@ Options::Options()
     m_adjustPageWidth.SetInfo("Adjust page width", "Adjust the page width to the width of the content");
     m_adjustPageWidth.Init(false);
     this->Register(&m_adjustPageWidth, "adjustPageWidth", &m_general);
+    m_adjustPageWidth.SetStage(OptionStage::PageCastOff);
 
     m_breaks.SetInfo("Breaks", "Define page and system breaks layout");
     m_breaks.Init(BREAKS_auto, &Option::s_breaks);
     this->Register(&m_breaks, "breaks", &m_general);
+    m_breaks.SetStage(OptionStage::SystemCastOff);
 
     m_breaksSmartSb.SetInfo("Smart breaks sb usage threshold",
         "In smart breaks mode, the portion of system width usage at which an encoded sb will be used");
     m_breaksSmartSb.Init(0.66, 0.0, 1.0);
     this->Register(&m_breaksSmartSb, "breaksSmartSb", &m_general);
+    m_breaksSmartSb.SetStage(OptionStage::SystemCastOff);
 
     m_condense.SetInfo("Condense", "Control condensed score layout");
     m_condense.Init(CONDENSE_auto, &Option::s_condense);
     this->Register(&m_condense, "condense", &m_general);
+    m_condense.SetStage(OptionStage::SystemCastOff);
 
     m_condenseFirstPage.SetInfo("Condense first page", "When condensing a score also condense the first page");
     m_condenseFirstPage.Init(false);
     this->Register(&m_condenseFirstPage, "condenseFirstPage", &m_general);
+    m_condenseFirstPage.SetStage(OptionStage::SystemCastOff);
 
     m_condenseNotLastSystem.SetInfo(
         "Condense not last system", "When condensing a score never condense the last system");
     m_condenseNotLastSystem.Init(false);
     this->Register(&m_condenseNotLastSystem, "condenseNotLastSystem", &m_general);
+    m_condenseNotLastSystem.SetStage(OptionStage::SystemCastOff);
 
     m_condenseTempoPages.SetInfo(
         "Condense tempo pages", "When condensing a score also condense pages with a tempo change");
     m_condenseTempoPages.Init(false);
     this->Register(&m_condenseTempoPages, "condenseTempoPages", &m_general);
+    m_condenseTempoPages.SetStage(OptionStage::SystemCastOff);
 
     m_evenNoteSpacing.SetInfo("Even note spacing", "Specify the linear spacing factor");
     m_evenNoteSpacing.Init(false);
     this->Register(&m_evenNoteSpacing, "evenNoteSpacing", &m_general);
+    m_evenNoteSpacing.SetStage(OptionStage::HorizontalLayout);
 
     m_expand.SetInfo("Expand expansion", "Expand all referenced elements in the expansion <xml:id>");
     m_expand.Init("");
@@ -996,14 +1012,22 @@ Options::Options()
     m_justifyVertically.SetInfo("Justify vertically", "Justify spacing vertically to fill the page");
     m_justifyVertically.Init(false);
     this->Register(&m_justifyVertically, "justifyVertically", &m_general);
+    m_justifyVertically.SetStage(OptionStage::PageCastOff);
 
     m_landscape.SetInfo("Landscape orientation", "The landscape paper orientation flag");
     m_landscape.Init(false);
     this->Register(&m_landscape, "landscape", &m_general);
+    m_landscape.SetStage(OptionStage::SystemCastOff);
+
+    m_layoutThreads.SetInfo("Layout threads", "The number of threads for the horizontal layout of the measures");
+    m_layoutThreads.Init(1, 1, 64);
+    this->Register(&m_layoutThreads, "layoutThreads", &m_general);
+    m_layoutThreads.SetStage(OptionStage::Output);
 
     m_ligatureAsBracket.SetInfo("Ligature as bracket", "Render ligatures as bracket instead of original notation");
     m_ligatureAsBracket.Init(false);
     this->Register(&m_ligatureAsBracket, "ligatureAsBracket", &m_general);
+    m_ligatureAsBracket.SetStage(OptionStage::HorizontalLayout);
 
     m_mensuralToMeasure.SetInfo("Mensural to measure", "Convert mensural sections to measure-based MEI");
     m_mensuralToMeasure.Init(false);
@@ -1013,10 +1037,12 @@ Options::Options()
         "The last system is only justified if the unjustified width is greater than this percent");
     m_minLastJustification.Init(0.8, 0.0, 1.0);
     this->Register(&m_minLastJustification, "minLastJustification", &m_general);
+    m_minLastJustification.SetStage(OptionStage::PageCastOff);
 
     m_mmOutput.SetInfo("MM output", "Specify that the output in the SVG is given in mm (default is px)");
     m_mmOutput.Init(false);
     this->Register(&m_mmOutput, "mmOutput", &m_general);
+    m_mmOutput.SetStage(OptionStage::Output);
 
     m_moveScoreDefinitionToStaff.SetInfo("Move score definition to staff",
         "Move score definition (clef, keySig, meterSig, etc.) from scoreDef to staffDef");
@@ -1026,6 +1052,7 @@ Options::Options()
     m_noJustification.SetInfo("No justification", "Do not justify the system");
     m_noJustification.Init(false);
     this->Register(&m_noJustification, "noJustification", &m_general);
+    m_noJustification.SetStage(OptionStage::PageCastOff);
 
     m_openControlEvents.SetInfo("Open control event", "Render open control events");
     m_openControlEvents.Init(false);
@@ -1034,48 +1061,59 @@ Options::Options()
     m_outputIndent.SetInfo("Output indentation", "Output indentation value for MEI and SVG");
     m_outputIndent.Init(3, 1, 10);
     this->Register(&m_outputIndent, "outputIndent", &m_general);
+    m_outputIndent.SetStage(OptionStage::Output);
 
     m_outputFormatRaw.SetInfo(
         "Raw formatting for MEI output", "Writes MEI out with no line indenting or non-content newlines.");
     m_outputFormatRaw.Init(false);
     this->Register(&m_outputFormatRaw, "outputFormatRaw", &m_general);
+    m_outputFormatRaw.SetStage(OptionStage::Output);
 
     m_outputIndentTab.SetInfo("Output indentation with tab", "Output indentation with tabulation for MEI and SVG");
     m_outputIndentTab.Init(false);
     this->Register(&m_outputIndentTab, "outputIndentTab", &m_general);
+    m_outputIndentTab.SetStage(OptionStage::Output);
 
     m_outputSmuflXmlEntities.SetInfo(
         "Output SMuFL XML entities", "Output SMuFL characters as XML entities instead of hex byte codes ");
     m_outputSmuflXmlEntities.Init(false);
     this->Register(&m_outputSmuflXmlEntities, "outputSmuflXmlEntities", &m_general);
+    m_outputSmuflXmlEntities.SetStage(OptionStage::Output);
 
     m_pageHeight.SetInfo("Page height", "The page height");
     m_pageHeight.Init(2970, 100, 60000, true);
     this->Register(&m_pageHeight, "pageHeight", &m_general);
+    m_pageHeight.SetStage(OptionStage::PageCastOff);
 
     m_pageMarginBottom.SetInfo("Page bottom margin", "The page bottom margin");
     m_pageMarginBottom.Init(50, 0, 500, true);
     this->Register(&m_pageMarginBottom, "pageMarginBottom", &m_general);
+    m_pageMarginBottom.SetStage(OptionStage::PageCastOff);
 
     m_pageMarginLeft.SetInfo("Page left margin", "The page left margin");
     m_pageMarginLeft.Init(50, 0, 500, true);
     this->Register(&m_pageMarginLeft, "pageMarginLeft", &m_general);
+    m_pageMarginLeft.SetStage(OptionStage::SystemCastOff);
 
     m_pageMarginRight.SetInfo("Page right margin", "The page right margin");
     m_pageMarginRight.Init(50, 0, 500, true);
     this->Register(&m_pageMarginRight, "pageMarginRight", &m_general);
+    m_pageMarginRight.SetStage(OptionStage::SystemCastOff);
 
     m_pageMarginTop.SetInfo("Page top margin", "The page top margin");
     m_pageMarginTop.Init(50, 0, 500, true);
     this->Register(&m_pageMarginTop, "pageMarginTop", &m_general);
+    m_pageMarginTop.SetStage(OptionStage::PageCastOff);
 
     m_pageWidth.SetInfo("Page width", "The page width");
     m_pageWidth.Init(2100, 100, 60000, true);
     this->Register(&m_pageWidth, "pageWidth", &m_general);
+    m_pageWidth.SetStage(OptionStage::SystemCastOff);
 
     m_pedalStyle.SetInfo("Pedal style", "The global pedal style");
     m_pedalStyle.Init(PEDALSTYLE_auto, &Option::s_pedalStyle);
     this->Register(&m_pedalStyle, "pedalStyle", &m_general);
+    m_pedalStyle.SetStage(OptionStage::HorizontalLayout);
 
     m_preserveAnalyticalMarkup.SetInfo("Preserve analytical markup", "Preserves the analytical markup in MEI");
     m_preserveAnalyticalMarkup.Init(false);
@@ -1084,60 +1122,78 @@ Options::Options()
     m_removeIds.SetInfo("Remove IDs in MEI", "Remove XML IDs in the MEI output that are not referenced");
     m_removeIds.Init(false);
     this->Register(&m_removeIds, "removeIds", &m_general);
+    m_removeIds.SetStage(OptionStage::Output);
+
+    m_renderThreads.SetInfo("Render threads", "The number of threads for rendering several pages or records to SVG");
+    m_renderThreads.Init(1, 1, 64);
+    this->Register(&m_renderThreads, "renderThreads", &m_general);
+    m_renderThreads.SetStage(OptionStage::Output);
 
     m_showRuntime.SetInfo("Show runtime on CLI", "Display the total runtime on command-line");
     m_showRuntime.Init(false);
     this->Register(&m_showRuntime, "showRuntime", &m_general);
+    m_showRuntime.SetStage(OptionStage::Output);
 
     m_shrinkToFit.SetInfo("Shrink content to fit page", "Scale down page content to fit the page height if needed");
     m_shrinkToFit.Init(false);
     this->Register(&m_shrinkToFit, "shrinkToFit", &m_general);
+    m_shrinkToFit.SetStage(OptionStage::Output);
 
     m_staccatoCenter.SetInfo(
         "Center staccato", "Align staccato and staccatissimo articulations with center of the note");
     m_staccatoCenter.Init(false);
     this->Register(&m_staccatoCenter, "staccatoCenter", &m_general);
+    m_staccatoCenter.SetStage(OptionStage::HorizontalLayout);
 
     m_svgBoundingBoxes.SetInfo("Svg bounding boxes viewbox on svg root", "Include bounding boxes in SVG output");
     m_svgBoundingBoxes.Init(false);
     this->Register(&m_svgBoundingBoxes, "svgBoundingBoxes", &m_general);
+    m_svgBoundingBoxes.SetStage(OptionStage::PageCastOff);
 
     m_svgCss.SetInfo("SVG additional CSS", "CSS (as a string) to be added to the SVG output");
     m_svgCss.Init("");
     this->Register(&m_svgCss, "svgCss", &m_general);
+    m_svgCss.SetStage(OptionStage::Output);
 
     m_svgViewBox.SetInfo("Use viewbox on svg root", "Use viewBox on svg root element for easy scaling of document");
     m_svgViewBox.Init(false);
     this->Register(&m_svgViewBox, "svgViewBox", &m_general);
+    m_svgViewBox.SetStage(OptionStage::Output);
 
     m_svgHtml5.SetInfo("Output SVG for HTML5 embedding",
         "Write data-id and data-class attributes for JS usage and id clash avoidance");
     m_svgHtml5.Init(false);
     this->Register(&m_svgHtml5, "svgHtml5", &m_general);
+    m_svgHtml5.SetStage(OptionStage::Output);
 
     m_svgFormatRaw.SetInfo(
         "Raw formatting for SVG output", "Writes SVG out with no line indenting or non-content newlines");
     m_svgFormatRaw.Init(false);
     this->Register(&m_svgFormatRaw, "svgFormatRaw", &m_general);
+    m_svgFormatRaw.SetStage(OptionStage::Output);
 
     m_svgRemoveXlink.SetInfo("Remove xlink: from href attributes",
         "Removes the xlink: prefix on href attributes for compatibility with some newer browsers");
     m_svgRemoveXlink.Init(false);
     this->Register(&m_svgRemoveXlink, "svgRemoveXlink", &m_general);
+    m_svgRemoveXlink.SetStage(OptionStage::Output);
 
     m_svgAdditionalAttribute.SetInfo("Add additional attribute in SVG",
         "Add additional attribute for graphical elements in SVG as \"data-*\", for "
         "example, \"note@pname\" would add a \"data-pname\" to all note elements");
     m_svgAdditionalAttribute.Init();
     this->Register(&m_svgAdditionalAttribute, "svgAdditionalAttribute", &m_general);
+    m_svgAdditionalAttribute.SetStage(OptionStage::Output);
 
     m_unit.SetInfo("Unit", "The MEI unit (1⁄2 of the distance between the staff lines)");
     m_unit.Init(9, 6, 20, true);
     this->Register(&m_unit, "unit", &m_general);
+    m_unit.SetStage(OptionStage::HorizontalLayout);
 
     m_useBraceGlyph.SetInfo("Use Brace Glyph", "Use brace glyph from current font");
     m_useBraceGlyph.Init(false);
     this->Register(&m_useBraceGlyph, "useBraceGlyph", &m_general);
+    m_useBraceGlyph.SetStage(OptionStage::HorizontalLayout);
 
     m_useFacsimile.SetInfo(
         "Use facsimile for layout", "Use information in the <facsimile> element to control the layout");
@@ -1147,10 +1203,12 @@ Options::Options()
     m_usePgFooterForAll.SetInfo("Use PgFooter for all", "Use the pgFooter for all pages");
     m_usePgFooterForAll.Init(false);
     this->Register(&m_usePgFooterForAll, "usePgFooterForAll", &m_general);
+    m_usePgFooterForAll.SetStage(OptionStage::VerticalLayout);
 
     m_usePgHeaderForAll.SetInfo("Use PgHeader for all", "Use the pgHeader for all pages");
     m_usePgHeaderForAll.Init(false);
     this->Register(&m_usePgHeaderForAll, "usePgHeaderForAll", &m_general);
+    m_usePgHeaderForAll.SetStage(OptionStage::VerticalLayout);
 
     m_xmlIdChecksum.SetInfo(
         "XML IDs based on checksum", "Seed the generator for XML IDs using the checksum of the input data");
@@ -1161,6 +1219,7 @@ Options::Options()
 
     m_generalLayout.SetLabel("General layout options", "2-generalLayout");
     m_generalLayout.SetCategory(OptionsCategory::Layout);
+    m_generalLayout.SetStage(OptionStage::HorizontalLayout);
     m_grps.push_back(&m_generalLayout);
 
     m_barLineSeparation.SetInfo(
@@ -1202,6 +1261,7 @@ Options::Options()
         "Breaks no widow", "Prevent single measures on the last page by fitting it into previous system");
     m_breaksNoWidow.Init(false);
     this->Register(&m_breaksNoWidow, "breaksNoWidow", &m_generalLayout);
+    m_breaksNoWidow.SetStage(OptionStage::SystemCastOff);
 
     // Optimized for five line staves
     constexpr double dashedBarLineLengthDefault = 8.0 / 7.0;
@@ -1216,6 +1276,7 @@ Options::Options()
     m_dynamDist.SetInfo("Dynam dist", "The default distance from the staff for dynamic marks");
     m_dynamDist.Init(1.0, 0.5, 16.0);
     this->Register(&m_dynamDist, "dynamDist", &m_generalLayout);
+    m_dynamDist.SetStage(OptionStage::VerticalLayout);
 
     m_engravingDefaults.SetInfo("Engraving defaults", "Json describing defaults for engraving SMuFL elements");
     m_engravingDefaults.Init(JsonSource::String, "{}");
@@ -1262,29 +1323,35 @@ Options::Options()
     m_harmDist.SetInfo("Harm dist", "The default distance from the staff of harmonic indications");
     m_harmDist.Init(1.0, 0.5, 16.0);
     this->Register(&m_harmDist, "harmDist", &m_generalLayout);
+    m_harmDist.SetStage(OptionStage::VerticalLayout);
 
     m_justificationStaff.SetInfo("Spacing staff justification", "The staff justification");
     m_justificationStaff.Init(1., 0., 10.);
     this->Register(&m_justificationStaff, "justificationStaff", &m_generalLayout);
+    m_justificationStaff.SetStage(OptionStage::VerticalLayout);
 
     m_justificationSystem.SetInfo("Spacing system justification", "The system spacing justification");
     m_justificationSystem.Init(1., 0., 10.);
     this->Register(&m_justificationSystem, "justificationSystem", &m_generalLayout);
+    m_justificationSystem.SetStage(OptionStage::VerticalLayout);
 
     m_justificationBracketGroup.SetInfo(
         "Spacing bracket group justification", "Space between staves inside a bracketed group justification");
     m_justificationBracketGroup.Init(1., 0., 10.);
     this->Register(&m_justificationBracketGroup, "justificationBracketGroup", &m_generalLayout);
+    m_justificationBracketGroup.SetStage(OptionStage::VerticalLayout);
 
     m_justificationBraceGroup.SetInfo(
         "Spacing brace group justification", "Space between staves inside a braced group justification");
     m_justificationBraceGroup.Init(1., 0., 10.);
     this->Register(&m_justificationBraceGroup, "justificationBraceGroup", &m_generalLayout);
+    m_justificationBraceGroup.SetStage(OptionStage::VerticalLayout);
 
     m_justificationMaxVertical.SetInfo("Maximum ratio of justifiable height for page",
         "Maximum ratio of justifiable height to page height that can be used for the vertical justification");
     m_justificationMaxVertical.Init(0.3, 0.0, 1.0);
     this->Register(&m_justificationMaxVertical, "justificationMaxVertical", &m_generalLayout);
+    m_justificationMaxVertical.SetStage(OptionStage::VerticalLayout);
 
     m_ledgerLineThickness.SetInfo("Ledger line thickness", "The thickness of the ledger lines");
     m_ledgerLineThickness.Init(0.25, 0.10, 0.50);
@@ -1314,6 +1381,7 @@ Options::Options()
     m_lyricTopMinMargin.SetInfo("Lyric top min margin", "The minmal margin above the lyrics in MEI units");
     m_lyricTopMinMargin.Init(2.0, 0.0, 8.0);
     this->Register(&m_lyricTopMinMargin, "lyricTopMinMargin", &m_generalLayout);
+    m_lyricTopMinMargin.SetStage(OptionStage::VerticalLayout);
 
     m_lyricWordSpace.SetInfo("Lyric word space", "The lyric word space length");
     m_lyricWordSpace.Init(1.20, 0.50, 3.00);
@@ -1393,11 +1461,13 @@ Options::Options()
         "Spacing brace group", "Minimum space between staves inside a braced group in MEI units");
     m_spacingBraceGroup.Init(12, 0, 48);
     this->Register(&m_spacingBraceGroup, "spacingBraceGroup", &m_generalLayout);
+    m_spacingBraceGroup.SetStage(OptionStage::VerticalLayout);
 
     m_spacingBracketGroup.SetInfo(
         "Spacing bracket group", "Minimum space between staves inside a bracketed group in MEI units");
     m_spacingBracketGroup.Init(12, 0, 48);
     this->Register(&m_spacingBracketGroup, "spacingBracketGroup", &m_generalLayout);
+    m_spacingBracketGroup.SetStage(OptionStage::VerticalLayout);
 
     m_spacingDurDetection.SetInfo("Spacing dur detection", "Detect long duration for adjusting spacing");
     m_spacingDurDetection.Init(false);
@@ -1414,10 +1484,12 @@ Options::Options()
     m_spacingStaff.SetInfo("Spacing staff", "The staff minimal spacing in MEI units");
     m_spacingStaff.Init(12, 0, 48);
     this->Register(&m_spacingStaff, "spacingStaff", &m_generalLayout);
+    m_spacingStaff.SetStage(OptionStage::VerticalLayout);
 
     m_spacingSystem.SetInfo("Spacing system", "The system minimal spacing in MEI units");
     m_spacingSystem.Init(12, 0, 48);
     this->Register(&m_spacingSystem, "spacingSystem", &m_generalLayout);
+    m_spacingSystem.SetStage(OptionStage::VerticalLayout);
 
     m_staffLineWidth.SetInfo("Staff line width", "The staff line width in unit");
     m_staffLineWidth.Init(0.15, 0.10, 0.30);
@@ -1438,6 +1510,7 @@ Options::Options()
     m_systemMaxPerPage.SetInfo("Max. System per Page", "Maximun number of systems per page");
     m_systemMaxPerPage.Init(0, 0, 24);
     this->Register(&m_systemMaxPerPage, "systemMaxPerPage", &m_generalLayout);
+    m_systemMaxPerPage.SetStage(OptionStage::PageCastOff);
 
     m_textEnclosureThickness.SetInfo("Text box line thickness", "The thickness of the line text enclosing box");
     m_textEnclosureThickness.Init(0.2, 0.10, 0.80);
@@ -1471,6 +1544,7 @@ Options::Options()
 
     m_selectors.SetLabel("Element selectors and processing", "3-selectors");
     m_selectors.SetCategory(OptionsCategory::Selectors);
+    m_selectors.SetStage(OptionStage::DataPreparation);
     m_grps.push_back(&m_selectors);
 
     m_appXPathQuery.SetInfo("App xPath query",
@@ -1524,11 +1598,13 @@ Options::Options()
 
     m_elementMargins.SetLabel("Element margins", "4-elementMargins");
     m_elementMargins.SetCategory(OptionsCategory::Margins);
+    m_elementMargins.SetStage(OptionStage::HorizontalLayout);
     m_grps.push_back(&m_elementMargins);
 
     m_defaultBottomMargin.SetInfo("Default bottom margin", "The default bottom margin");
     m_defaultBottomMargin.Init(0.5, 0.0, 5.0);
     this->Register(&m_defaultBottomMargin, "defaultBottomMargin", &m_elementMargins);
+    m_defaultBottomMargin.SetStage(OptionStage::VerticalLayout);
 
     m_defaultLeftMargin.SetInfo("Default left margin", "The default left margin");
     m_defaultLeftMargin.Init(0.0, 0.0, 2.0);
@@ -1541,20 +1617,24 @@ Options::Options()
     m_defaultTopMargin.SetInfo("Default top margin", "The default top margin");
     m_defaultTopMargin.Init(0.5, 0.0, 6.0);
     this->Register(&m_defaultTopMargin, "defaultTopMargin", &m_elementMargins);
+    m_defaultTopMargin.SetStage(OptionStage::VerticalLayout);
 
     /// custom bottom
 
     m_bottomMarginArtic.SetInfo("Bottom margin artic", "The margin for artic in MEI units");
     m_bottomMarginArtic.Init(0.75, 0.0, 10.0);
     this->Register(&m_bottomMarginArtic, "bottomMarginArtic", &m_elementMargins);
+    m_bottomMarginArtic.SetStage(OptionStage::VerticalLayout);
 
     m_bottomMarginHarm.SetInfo("Bottom margin harm", "The margin for harm in MEI units");
     m_bottomMarginHarm.Init(1.0, 0.0, 10.0);
     this->Register(&m_bottomMarginHarm, "bottomMarginHarm", &m_elementMargins);
+    m_bottomMarginHarm.SetStage(OptionStage::VerticalLayout);
 
     m_bottomMarginPgHead.SetInfo("Bottom margin header", "The margin for header in MEI units");
     m_bottomMarginPgHead.Init(2.0, 0.0, 24.0);
     this->Register(&m_bottomMarginPgHead, "bottomMarginHeader", &m_elementMargins);
+    m_bottomMarginPgHead.SetStage(OptionStage::VerticalLayout);
 
     /// custom left
 
@@ -1701,19 +1781,23 @@ Options::Options()
     m_topMarginArtic.SetInfo("Top margin artic", "The margin for artic in MEI units");
     m_topMarginArtic.Init(0.75, 0.0, 10.0);
     this->Register(&m_topMarginArtic, "topMarginArtic", &m_elementMargins);
+    m_topMarginArtic.SetStage(OptionStage::VerticalLayout);
 
     m_topMarginHarm.SetInfo("Top margin harm", "The margin for harm in MEI units");
     m_topMarginHarm.Init(1.0, 0.0, 10.0);
     this->Register(&m_topMarginHarm, "topMarginHarm", &m_elementMargins);
+    m_topMarginHarm.SetStage(OptionStage::VerticalLayout);
 
     m_topMarginPgFooter.SetInfo("Top margin footer", "The margin for footer in MEI units");
     m_topMarginPgFooter.Init(2.0, 0.0, 24.0);
     this->Register(&m_topMarginPgFooter, "topMarginPgFooter", &m_elementMargins);
+    m_topMarginPgFooter.SetStage(OptionStage::VerticalLayout);
 
     /********* midi *********/
 
     m_midi.SetLabel("Midi options", "5-midi");
     m_midi.SetCategory(OptionsCategory::Midi);
+    m_midi.SetStage(OptionStage::Output);
     m_grps.push_back(&m_midi);
 
     m_midiNoCue.SetInfo("MIDI playback of cue notes", "Skip cue notes in MIDI output");
@@ -1724,6 +1808,10 @@ Options::Options()
     m_midiTempoAdjustment.Init(1.0, 0.2, 4.0);
     this->Register(&m_midiTempoAdjustment, "midiTempoAdjustment", &m_midi);
 
+    m_midiThreads.SetInfo("MIDI threads", "The number of threads for generating the MIDI tracks");
+    m_midiThreads.Init(1, 1, 64);
+    this->Register(&m_midiThreads, "midiThreads", &m_midi);
+
     /********* Deprecated options *********/
 
     /*
@@ -1842,6 +1930,17 @@ void Options::Sync()
         [](const std::string &key) { LogError("Unsupported engraving default '%s'", key.c_str()); });
 }
 
+OptionStage Options::GetInvalidatedStage(const Options &options) const
+{
+    OptionStage stage = OptionStage::Output;
+    for (const auto &[key, option] : m_items) {
+        if (option->GetStage() >= stage) continue;
+        const Option *other = options.GetItems()->at(key);
+        if (option->GetStrValue() != other->GetStrValue()) stage = option->GetStage();
+    }
+    return stage;
+}
+
 void Options::Register(Option *option, const std::string &key, OptionGrp *grp)
 {
     assert(option);
@@ -1849,6 +1948,7 @@ void Options::Register(Option *option, const std::string &key, OptionGrp *grp)
 
     m_items[key] = option;
     option->SetKey(key);
+    option->SetStage(grp->GetStage());
     grp->AddOption(option);
 }
 
@@ -50,6 +50,8 @@ void Page::Reset()
     m_score = NULL;
     m_scoreEnd = NULL;
     m_layoutDone = false;
+    m_drawingHeaderYRels.clear();
+    m_drawingFooterYRels.clear();
     this->ResetID();
 
     // by default we have no values and use the document ones
@@ -155,8 +157,7 @@ void Page::LayOut(bool force)
 {
     if (m_layoutDone && !force) {
         // We only need to reset the header - this will adjust the page number if necessary
-        if (this->GetHeader()) this->GetHeader()->SetDrawingPage(this);
-        if (this->GetFooter()) this->GetFooter()->SetDrawingPage(this);
+        this->SetRunningElementsDrawingPage();
         return;
     }
 
@@ -176,9 +177,26 @@ void Page::LayOut(bool force)
         view.DrawCurrentPage(&bBoxDC, false);
     }
 
+    m_drawingHeaderYRels = (this->GetHeader()) ? this->GetHeader()->GetDrawingYRels() : std::vector<int>();
+    m_drawingFooterYRels = (this->GetFooter()) ? this->GetFooter()->GetDrawingYRels() : std::vector<int>();
+
     m_layoutDone = true;
 }
 
+void Page::SetRunningElementsDrawingPage()
+{
+    RunningElement *header = this->GetHeader();
+    if (header) {
+        header->SetDrawingPage(this);
+        header->SetDrawingYRels(m_drawingHeaderYRels);
+    }
+    RunningElement *footer = this->GetFooter();
+    if (footer) {
+        footer->SetDrawingPage(this);
+        footer->SetDrawingYRels(m_drawingFooterYRels);
+    }
+}
+
 void Page::LayOutTranscription(bool force)
 {
     if (m_layoutDone && !force) {
@@ -366,68 +384,86 @@ void Page::LayOutHorizontally()
     view.SetPage(this->GetIdx(), false);
     view.DrawCurrentPage(&bBoxDC, false);
 
+    // The passes until AdjustClefChanges only change the content of each measure and can be run concurrently
+    const int threadCount = doc->GetOptions()->m_layoutThreads.GetValue();
+    ListOfObjects scoresAndMeasures;
+    if (threadCount > 1) {
+        // Looking for the scores changes the current one in the doc
+        Score *currentScore = doc->GetCurrentScore();
+        ClassIdsComparison matchType({ SCORE, MEASURE });
+        this->FindAllDescendantsByComparison(&scoresAndMeasures, &matchType);
+        doc->SetCurrentScore(currentScore);
+    }
+
     // Adjust the position of outside articulations
-    AdjustArticParams adjustArticParams(doc);
-    Functor adjustArtic(&Object::AdjustArtic);
-    this->Process(&adjustArtic, &adjustArticParams);
+    this->ProcessMeasuresHorizontally(scoresAndMeasures, threadCount, &Object::AdjustArtic, NULL,
+        [doc](Functor *functor, Functor *functorEnd, const std::vector<int> &staffNs) {
+            return std::make_unique<AdjustArticParams>(doc);
+        });
 
     // Adjust the x position of the LayerElement where multiple layer collide
     // Look at each LayerElement and change the m_xShift if the bounding box is overlapping
     // For the first iteration align elements without taking dots into consideration
-    Functor adjustLayers(&Object::AdjustLayers);
-    Functor adjustLayersEnd(&Object::AdjustLayersEnd);
-    AdjustLayersParams adjustLayersParams(
-        doc, &adjustLayers, &adjustLayersEnd, doc->GetCurrentScoreDef()->GetStaffNs());
-    this->Process(&adjustLayers, &adjustLayersParams, &adjustLayersEnd);
+    this->ProcessMeasuresHorizontally(scoresAndMeasures, threadCount, &Object::AdjustLayers, &Object::AdjustLayersEnd,
+        [doc](Functor *functor, Functor *functorEnd, const std::vector<int> &staffNs) {
+            return std::make_unique<AdjustLayersParams>(doc, functor, functorEnd, staffNs);
+        });
 
     // Adjust dots for the multiple layers. Try to align dots that can be grouped together when layers collide,
     // otherwise keep their relative positioning
-    Functor adjustDots(&Object::AdjustDots);
-    Functor adjustDotsEnd(&Object::AdjustDotsEnd);
-    AdjustDotsParams adjustDotsParams(doc, &adjustDots, &adjustDotsEnd, doc->GetCurrentScoreDef()->GetStaffNs());
-    this->Process(&adjustDots, &adjustDotsParams, &adjustDotsEnd);
+    this->ProcessMeasuresHorizontally(scoresAndMeasures, threadCount, &Object::AdjustDots, &Object::AdjustDotsEnd,
+        [doc](Functor *functor, Functor *functorEnd, const std::vector<int> &staffNs) {
+            return std::make_unique<AdjustDotsParams>(doc, functor, functorEnd, staffNs);
+        });
 
     // adjust Layers again, this time including dots positioning
-    AdjustLayersParams newAdjustLayersParams(
-        doc, &adjustLayers, &adjustLayersEnd, doc->GetCurrentScoreDef()->GetStaffNs());
-    newAdjustLayersParams.m_ignoreDots = false;
-    this->Process(&adjustLayers, &newAdjustLayersParams, &adjustLayersEnd);
+    this->ProcessMeasuresHorizontally(scoresAndMeasures, threadCount, &Object::AdjustLayers, &Object::AdjustLayersEnd,
+        [doc](Functor *functor, Functor *functorEnd, const std::vector<int> &staffNs) {
+            auto newAdjustLayersParams = std::make_unique<AdjustLayersParams>(doc, functor, functorEnd, staffNs);
+            newAdjustLayersParams->m_ignoreDots = false;
+            return newAdjustLayersParams;
+        });
 
     // Adjust the X position of the accidentals, including in chords
-    Functor adjustAccidX(&Object::AdjustAccidX);
-    AdjustAccidXParams adjustAccidXParams(doc, &adjustAccidX);
-    this->Process(&adjustAccidX, &adjustAccidXParams);
+    this->ProcessMeasuresHorizontally(scoresAndMeasures, threadCount, &Object::AdjustAccidX, NULL,
+        [doc](Functor *functor, Functor *functorEnd, const std::vector<int> &staffNs) {
+            return std::make_unique<AdjustAccidXParams>(doc, functor);
+        });
 
     // Adjust the X shift of the Alignment looking at the bounding boxes
     // Look at each LayerElement and change the m_xShift if the bounding box is overlapping
-    Functor adjustXPos(&Object::AdjustXPos);
-    Functor adjustXPosEnd(&Object::AdjustXPosEnd);
-    AdjustXPosParams adjustXPosParams(doc, &adjustXPos, &adjustXPosEnd, doc->GetCurrentScoreDef()->GetStaffNs());
-    adjustXPosParams.m_excludes.push_back(TABDURSYM);
-    this->Process(&adjustXPos, &adjustXPosParams, &adjustXPosEnd);
+    this->ProcessMeasuresHorizontally(scoresAndMeasures, threadCount, &Object::AdjustXPos, &Object::AdjustXPosEnd,
+        [doc](Functor *functor, Functor *functorEnd, const std::vector<int> &staffNs) {
+            auto adjustXPosParams = std::make_unique<AdjustXPosParams>(doc, functor, functorEnd, staffNs);
+            adjustXPosParams->m_excludes.push_back(TABDURSYM);
+            return adjustXPosParams;
+        });
 
     // Adjust tabRhyhtm separately
-    adjustXPosParams.m_excludes.clear();
-    adjustXPosParams.m_includes.push_back(TABDURSYM);
-    adjustXPosParams.m_includes.push_back(BARLINE);
-    adjustXPosParams.m_includes.push_back(METERSIG);
-    adjustXPosParams.m_includes.push_back(KEYSIG);
-    adjustXPosParams.m_rightBarLinesOnly = true;
-    this->Process(&adjustXPos, &adjustXPosParams, &adjustXPosEnd);
+    this->ProcessMeasuresHorizontally(scoresAndMeasures, threadCount, &Object::AdjustXPos, &Object::AdjustXPosEnd,
+        [doc](Functor *functor, Functor *functorEnd, const std::vector<int> &staffNs) {
+            auto adjustXPosParams = std::make_unique<AdjustXPosParams>(doc, functor, functorEnd, staffNs);
+            adjustXPosParams->m_includes.push_back(TABDURSYM);
+            adjustXPosParams->m_includes.push_back(BARLINE);
+            adjustXPosParams->m_includes.push_back(METERSIG);
+            adjustXPosParams->m_includes.push_back(KEYSIG);
+            adjustXPosParams->m_rightBarLinesOnly = true;
+            return adjustXPosParams;
+        });
 
     // Adjust the X shift of the Alignment looking at the bounding boxes
     // Look at each LayerElement and change the m_xShift if the bounding box is overlapping
-    Functor adjustGraceXPos(&Object::AdjustGraceXPos);
-    Functor adjustGraceXPosEnd(&Object::AdjustGraceXPosEnd);
-    AdjustGraceXPosParams adjustGraceXPosParams(
-        doc, &adjustGraceXPos, &adjustGraceXPosEnd, doc->GetCurrentScoreDef()->GetStaffNs());
-    this->Process(&adjustGraceXPos, &adjustGraceXPosParams, &adjustGraceXPosEnd);
+    this->ProcessMeasuresHorizontally(scoresAndMeasures, threadCount, &Object::AdjustGraceXPos,
+        &Object::AdjustGraceXPosEnd, [doc](Functor *functor, Functor *functorEnd, const std::vector<int> &staffNs) {
+            return std::make_unique<AdjustGraceXPosParams>(doc, functor, functorEnd, staffNs);
+        });
 
     // Adjust the spacing of clef changes since they are skipped in AdjustXPos
     // Look at each clef change and  move them to the left and add space if necessary
-    Functor adjustClefChanges(&Object::AdjustClefChanges);
-    AdjustClefsParams adjustClefChangesParams(doc);
-    this->Process(&adjustClefChanges, &adjustClefChangesParams);
+    this->ProcessMeasuresHorizontally(scoresAndMeasures, threadCount, &Object::AdjustClefChanges, NULL,
+        [doc](Functor *functor, Functor *functorEnd, const std::vector<int> &staffNs) {
+            return std::make_unique<AdjustClefsParams>(doc);
+        });
 
     // We need to populate processing lists for processing the document by Layer (for matching @tie) and
     // by Verse (for matching syllable connectors)
@@ -471,6 +507,55 @@ void Page::LayOutHorizontally()
     this->Process(&alignMeasures, &alignMeasuresParams, &alignMeasuresEnd);
 }
 
+void Page::ProcessMeasuresHorizontally(const ListOfObjects &scoresAndMeasures, int threadCount,
+    int (Object::*method)(FunctorParams *), int (Object::*endMethod)(FunctorParams *),
+    const std::function<std::unique_ptr<FunctorParams>(Functor *, Functor *, const std::vector<int> &)> &createParams)
+{
+    Doc *doc = vrv_cast<Doc *>(this->GetFirstAncestor(DOC));
+    assert(doc);
+
+    // Each chunk of measures is processed with its own functors and params
+    auto process = [method, endMethod, &createParams](const ArrayOfObjects &objects, const std::vector<int> &staffNs) {
+        Functor functor(method);
+        Functor functorEnd = (endMethod) ? Functor(endMethod) : Functor();
+        Functor *end = (endMethod) ? &functorEnd : NULL;
+        std::unique_ptr<FunctorParams> params = createParams(&functor, end, staffNs);
+        for (Object *object : objects) object->Process(&functor, params.get(), end);
+    };
+
+    if (threadCount <= 1) {
+        process({ this }, doc->GetCurrentScoreDef()->GetStaffNs());
+        return;
+    }
+
+    // Process the measures since the previous score in chunks - the current score must not change meanwhile
+    ArrayOfObjects measures;
+    auto processMeasures = [doc, threadCount, &measures, &process]() {
+        if (measures.empty()) return;
+        const std::vector<int> staffNs = doc->GetCurrentScoreDef()->GetStaffNs();
+        const int chunkCount = std::min((int)measures.size(), 4 * threadCount);
+        RunInParallel(chunkCount, threadCount, [chunkCount, &measures, &staffNs, &process](int chunk) {
+            ArrayOfObjects::iterator begin = measures.begin() + measures.size() * chunk / chunkCount;
+            ArrayOfObjects::iterator end = measures.begin() + measures.size() * (chunk + 1) / chunkCount;
+            process(ArrayOfObjects(begin, end), staffNs);
+        });
+        measures.clear();
+    };
+
+    for (Object *object : scoresAndMeasures) {
+        if (object->Is(SCORE)) {
+            processMeasures();
+            Score *score = vrv_cast<Score *>(object);
+            assert(score);
+            score->SetAsCurrent();
+        }
+        else {
+            measures.push_back(object);
+        }
+    }
+    processMeasures();
+}
+
 void Page::LayOutHorizontallyWithCache(bool restore)
 {
     Doc *doc = vrv_cast<Doc *>(this->GetFirstAncestor(DOC));
@@ -516,6 +601,13 @@ void Page::LayOutVertically()
     view.SetPage(this->GetIdx(), false);
     view.DrawCurrentPage(&bBoxDC, false);
 
+    // Index the layer elements of each system for the slur collision queries
+    // The horizontal positions do not change anymore during the vertical layout
+    ListOfObjects systems = this->FindAllDescendantsByType(SYSTEM, false, 1);
+    for (Object *object : systems) {
+        vrv_cast<System *>(object)->IndexSpannedLayerElements();
+    }
+
     // Adjust the position of outside articulations with slurs end and start positions
     FunctorDocParams adjustArticWithSlursParams(doc);
     Functor adjustArticWithSlurs(&Object::AdjustArticWithSlurs);
@@ -582,6 +674,10 @@ void Page::LayOutVertically()
         this->Process(&adjustSlurs, &adjustSlursParams);
     }
 
+    for (Object *object : systems) {
+        vrv_cast<System *>(object)->ClearSpannedLayerElementIndex();
+    }
+
     doc->SetCurrentScore(this->m_score);
 
     if (this->GetHeader()) {
@@ -110,6 +110,7 @@ int PlistInterface::InterfacePreparePlist(FunctorParams *functorParams, Object *
 
     std::vector<std::string>::iterator iter;
     for (iter = m_ids.begin(); iter != m_ids.end(); ++iter) {
+        params->m_interfaceIDIndices.insert({ *iter, params->m_interfaceIDTuples.size() });
         params->m_interfaceIDTuples.push_back(std::make_tuple(this, *iter, (Object *)NULL));
     }
 
@@ -9,7 +9,13 @@
 
 //----------------------------------------------------------------------------
 
+#include <cassert>
+#include <cstring>
+
+//----------------------------------------------------------------------------
+
 #include "smufl.h"
+#include "vrv.h"
 #include "vrvdef.h"
 
 //----------------------------------------------------------------------------
@@ -25,6 +31,10 @@ namespace vrv {
 thread_local std::string Resources::s_defaultPath = "/usr/local/share/verovio";
 const Resources::StyleAttributes Resources::k_defaultStyle{ data_FONTWEIGHT::FONTWEIGHT_normal,
     data_FONTSTYLE::FONTSTYLE_normal };
+std::map<std::string, std::unique_ptr<pugi::xml_document>> Resources::s_svgDefs;
+std::mutex Resources::s_svgDefsMutex;
+std::map<std::string, Resources::LoadedFontPtr> Resources::s_fontRegistry;
+std::mutex Resources::s_fontRegistryMutex;
 
 //----------------------------------------------------------------------------
 // Resources
@@ -38,14 +48,27 @@ Resources::Resources()
 
 bool Resources::InitFonts()
 {
+    m_fonts.clear();
+    m_textFont.clear();
+
     // We will need to rethink this for adding the option to add custom fonts
     // Font Bravura first since it is expected to have always all symbols
     if (!LoadFont("Bravura")) LogError("Bravura font could not be loaded.");
     // The Leipzig as the default font
     if (!LoadFont("Leipzig")) LogError("Leipzig font could not be loaded.");
 
-    if (m_fontGlyphTable.size() < SMUFL_COUNT) {
-        LogError("Expected %d default SMuFL glyphs but could load only %d.", SMUFL_COUNT, m_fontGlyphTable.size());
+    // Count the glyphs available through all the loaded fonts
+    int glyphCount = 0;
+    for (auto it = m_fonts.begin(); it != m_fonts.end(); ++it) {
+        for (const auto &entry : (*it)->m_glyphTable) {
+            const bool isOverriden = std::any_of(it + 1, m_fonts.end(),
+                [&entry](const LoadedFontPtr &font) { return font->m_glyphTable.count(entry.first); });
+            if (!isOverriden) ++glyphCount;
+        }
+    }
+
+    if (glyphCount < SMUFL_COUNT) {
+        LogError("Expected %d default SMuFL glyphs but could load only %d.", SMUFL_COUNT, glyphCount);
         return false;
     }
 
@@ -82,17 +105,22 @@ bool Resources::SetFont(const std::string &fontName)
 
 const Glyph *Resources::GetGlyph(wchar_t smuflCode) const
 {
-    return m_fontGlyphTable.count(smuflCode) ? &m_fontGlyphTable.at(smuflCode) : NULL;
+    return Resources::FindGlyph(m_fonts, smuflCode);
 }
 
 const Glyph *Resources::GetGlyph(const std::string &smuflName) const
 {
-    return m_glyphNameTable.count(smuflName) ? &m_fontGlyphTable.at(m_glyphNameTable.at(smuflName)) : NULL;
+    const wchar_t smuflCode = this->GetGlyphCode(smuflName);
+    return (smuflCode) ? this->GetGlyph(smuflCode) : NULL;
 }
 
 wchar_t Resources::GetGlyphCode(const std::string &smuflName) const
 {
-    return m_glyphNameTable.count(smuflName) ? m_glyphNameTable.at(smuflName) : 0;
+    for (auto it = m_fonts.rbegin(); it != m_fonts.rend(); ++it) {
+        auto entry = (*it)->m_glyphNameTable.find(smuflName);
+        if (entry != (*it)->m_glyphNameTable.end()) return entry->second;
+    }
+    return 0;
 }
 
 void Resources::SelectTextFont(data_FONTWEIGHT fontWeight, data_FONTSTYLE fontStyle) const
@@ -117,18 +145,99 @@ const Glyph *Resources::GetTextGlyph(wchar_t code) const
     const StyleAttributes style = (m_textFont.count(m_currentStyle) != 0) ? m_currentStyle : k_defaultStyle;
     if (m_textFont.count(style) == 0) return NULL;
 
-    const GlyphTable &currentTable = m_textFont.at(style);
-    if (currentTable.count(code) == 0) {
-        return NULL;
-    }
+    return Resources::FindGlyph(m_textFont.at(style), code);
+}
+
+pugi::xml_node Resources::GetGlyphSvgDefs(const Glyph *glyph)
+{
+    assert(glyph);
+
+    return Resources::LoadSvgDefs(glyph->GetPath());
+}
 
-    return &currentTable.at(code);
+pugi::xml_node Resources::GetWoffSvgDef() const
+{
+    return Resources::LoadSvgDefs(this->GetPath() + "/woff.xml").first_child();
+}
+
+pugi::xml_node Resources::LoadSvgDefs(const std::string &filename)
+{
+    const std::lock_guard<std::mutex> lock(s_svgDefsMutex);
+
+    auto it = s_svgDefs.find(filename);
+    if (it == s_svgDefs.end()) {
+        // A file that cannot be loaded is cached as an empty document
+        auto doc = std::make_unique<pugi::xml_document>();
+        if (!doc->load_file(filename.c_str())) {
+            LogError("SVG definition file '%s' could not be loaded", filename.c_str());
+            doc->reset();
+        }
+        it = s_svgDefs.emplace(filename, std::move(doc)).first;
+    }
+    return *it->second;
 }
 
 bool Resources::LoadFont(const std::string &fontName)
+{
+    LoadedFontPtr font = Resources::GetRegisteredFont(this->GetPath(), fontName, false);
+    if (!font) return false;
+
+    Resources::PushFont(m_fonts, font);
+    return true;
+}
+
+bool Resources::InitTextFont(const std::string &fontName, const StyleAttributes &style)
+{
+    LoadedFontPtr font = Resources::GetRegisteredFont(this->GetPath(), fontName, true);
+    if (!font) return false;
+
+    Resources::PushFont(m_textFont[style], font);
+    return true;
+}
+
+void Resources::PushFont(FontStack &fontStack, const LoadedFontPtr &font)
+{
+    fontStack.erase(std::remove(fontStack.begin(), fontStack.end(), font), fontStack.end());
+    fontStack.push_back(font);
+}
+
+const Glyph *Resources::FindGlyph(const FontStack &fontStack, wchar_t code)
+{
+    for (auto it = fontStack.rbegin(); it != fontStack.rend(); ++it) {
+        auto entry = (*it)->m_glyphTable.find(code);
+        if (entry != (*it)->m_glyphTable.end()) return &entry->second;
+    }
+    return NULL;
+}
+
+Resources::LoadedFontPtr Resources::GetRegisteredFont(
+    const std::string &path, const std::string &fontName, bool isTextFont)
+{
+    const std::string key = (isTextFont) ? path + "/text/" + fontName : path + "/" + fontName;
+
+    const std::lock_guard<std::mutex> lock(s_fontRegistryMutex);
+
+    auto it = s_fontRegistry.find(key);
+    if (it != s_fontRegistry.end()) return it->second;
+
+    // Fonts that cannot be loaded are not registered and will be tried again the next time
+    auto font = std::make_shared<LoadedFont>();
+    // Use the binary metrics file when available and fall back to the XML file otherwise
+    bool success = Resources::ParseBinaryFont(path, fontName, isTextFont, *font);
+    if (!success) {
+        success = (isTextFont) ? Resources::ParseTextFont(path, fontName, *font)
+                               : Resources::ParseFont(path, fontName, *font);
+    }
+    if (!success) return NULL;
+
+    s_fontRegistry[key] = font;
+    return font;
+}
+
+bool Resources::ParseFont(const std::string &path, const std::string &fontName, LoadedFont &font)
 {
     pugi::xml_document doc;
-    const std::string filename = Resources::GetPath() + "/" + fontName + ".xml";
+    const std::string filename = path + "/" + fontName + ".xml";
     pugi::xml_parse_result parseResult = doc.load_file(filename.c_str());
     if (!parseResult) {
         // File not found, default bounding boxes will be used
@@ -157,7 +266,7 @@ bool Resources::LoadFont(const std::string &fontName)
         if (current.attribute("w")) width = current.attribute("w").as_float();
         if (current.attribute("h")) height = current.attribute("h").as_float();
         glyph.SetBoundingBox(x, y, width, height);
-        glyph.SetPath(Resources::GetPath() + "/" + fontName + "/" + c_attribute.value() + ".xml");
+        glyph.SetPath(path + "/" + fontName + "/" + c_attribute.value() + ".xml");
         if (current.attribute("h-a-x")) glyph.SetHorizAdvX(current.attribute("h-a-x").as_float());
 
         // load anchors
@@ -172,20 +281,20 @@ bool Resources::LoadFont(const std::string &fontName)
         }
 
         const wchar_t smuflCode = (wchar_t)strtol(c_attribute.value(), NULL, 16);
-        m_fontGlyphTable[smuflCode] = glyph;
-        m_glyphNameTable[n_attribute.value()] = smuflCode;
+        font.m_glyphTable[smuflCode] = glyph;
+        font.m_glyphNameTable[n_attribute.value()] = smuflCode;
     }
 
     return true;
 }
 
-bool Resources::InitTextFont(const std::string &fontName, const StyleAttributes &style)
+bool Resources::ParseTextFont(const std::string &path, const std::string &fontName, LoadedFont &font)
 {
     // For the text font, we load the bounding boxes only
     pugi::xml_document doc;
     // For now, we have only Times bounding boxes for ASCII chars
     // For any other char, we currently use 'o' bounding box
-    std::string filename = GetPath() + "/text/" + fontName + ".xml";
+    std::string filename = path + "/text/" + fontName + ".xml";
     pugi::xml_parse_result result = doc.load_file(filename.c_str());
     if (!result) {
         // File not found, default bounding boxes will be used
@@ -199,10 +308,7 @@ bool Resources::InitTextFont(const std::string &fontName, const StyleAttributes
     }
     const int unitsPerEm = root.attribute("units-per-em").as_int();
     pugi::xml_node current;
-    if (m_textFont.count(style) == 0) {
-        m_textFont[style] = {};
-    }
-    GlyphTable &currentTable = m_textFont.at(style);
+    GlyphTable &currentTable = font.m_glyphTable;
     for (current = root.child("g"); current; current = current.next_sibling("g")) {
         if (current.attribute("c")) {
             wchar_t code = (wchar_t)strtol(current.attribute("c").value(), NULL, 16);
@@ -218,13 +324,134 @@ bool Resources::InitTextFont(const std::string &fontName, const StyleAttributes
             glyph.SetBoundingBox(x, y, width, height);
 
             if (current.attribute("h-a-x")) glyph.SetHorizAdvX(current.attribute("h-a-x").as_float());
-            if (currentTable.count(code) > 0) {
-                LogDebug("Redefining %d with %s", code, fontName.c_str());
-            }
             currentTable[code] = glyph;
         }
     }
     return true;
 }
 
+bool Resources::ParseBinaryFont(const std::string &path, const std::string &fontName, bool isTextFont, LoadedFont &font)
+{
+    const std::string basename = (isTextFont) ? path + "/text/" + fontName : path + "/" + fontName;
+    const std::string filename = basename + ".bin";
+    MappedFile file;
+    if (!file.Open(filename)) return false;
+
+    // Values are stored as little-endian 32-bit integers and IEEE 754 floats, whatever the host byte order
+    const char *data = file.GetData();
+    auto readUInt = [data](size_t offset) {
+        const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data + offset);
+        return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16)
+            | ((uint32_t)bytes[3] << 24);
+    };
+    auto readFloat = [&readUInt](size_t offset) {
+        const uint32_t bits = readUInt(offset);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    };
+
+    const size_t headerSize = 32;
+    const size_t glyphSize = 40;
+    const size_t anchorSize = 12;
+    const uint32_t noString = 0xFFFFFFFF;
+
+    if ((file.GetSize() < headerSize) || std::memcmp(data, "VRVM", 4) || (readUInt(4) != 2)) {
+        LogWarning("Binary metrics file '%s' is not valid", filename.c_str());
+        return false;
+    }
+    // The binary file is used only when it was generated from the current XML file, if there is one.
+    // The size of the XML file is checked first, and its content is hashed only if it was modified after the binary
+    // file, for the XML file not to be read when it is unchanged.
+    size_t xmlSize = 0;
+    time_t xmlTime = 0;
+    if (GetFileInfo(basename + ".xml", xmlSize, xmlTime)) {
+        size_t binSize = 0;
+        time_t binTime = 0;
+        bool isMatching = (readUInt(24) == xmlSize);
+        if (isMatching && (!GetFileInfo(filename, binSize, binTime) || (xmlTime > binTime))) {
+            MappedFile xmlFile;
+            isMatching = xmlFile.Open(basename + ".xml")
+                && (readUInt(28) == Resources::HashMetrics(xmlFile.GetData(), xmlFile.GetSize()));
+        }
+        if (!isMatching) {
+            LogDebug("Binary metrics file '%s' does not match the XML file", filename.c_str());
+            return false;
+        }
+    }
+
+    const int unitsPerEm = (int)readUInt(8);
+    const size_t glyphCount = readUInt(12);
+    const size_t anchorCount = readUInt(16);
+    const size_t stringsSize = readUInt(20);
+    const size_t anchorsOffset = headerSize + glyphCount * glyphSize;
+    const size_t stringsOffset = anchorsOffset + anchorCount * anchorSize;
+    if ((stringsOffset + stringsSize != file.GetSize()) || (stringsSize && data[file.GetSize() - 1] != '\0')) {
+        LogWarning("Binary metrics file '%s' is not valid", filename.c_str());
+        return false;
+    }
+    auto readString = [data, stringsOffset, stringsSize](uint32_t offset) {
+        return (offset < stringsSize) ? data + stringsOffset + offset : NULL;
+    };
+
+    for (size_t i = 0; i < glyphCount; ++i) {
+        const size_t offset = headerSize + i * glyphSize;
+        const wchar_t code = (wchar_t)readUInt(offset);
+        const char *codeStr = readString(readUInt(offset + 4));
+        const uint32_t nameOffset = readUInt(offset + 8);
+        const char *name = readString(nameOffset);
+        if (!codeStr || (!name && nameOffset != noString)) {
+            LogWarning("Binary metrics file '%s' is not valid", filename.c_str());
+            font.m_glyphTable.clear();
+            font.m_glyphNameTable.clear();
+            return false;
+        }
+
+        if (isTextFont) {
+            Glyph glyph(unitsPerEm);
+            glyph.SetBoundingBox(
+                readFloat(offset + 12), readFloat(offset + 16), readFloat(offset + 20), readFloat(offset + 24));
+            glyph.SetHorizAdvX(readFloat(offset + 28));
+            font.m_glyphTable[code] = glyph;
+            continue;
+        }
+
+        // SMuFL glyphs without name are ignored, as when reading the XML file
+        if (!name) continue;
+
+        Glyph glyph;
+        glyph.SetUnitsPerEm(unitsPerEm * 10);
+        glyph.SetCodeStr(codeStr);
+        glyph.SetBoundingBox(
+            readFloat(offset + 12), readFloat(offset + 16), readFloat(offset + 20), readFloat(offset + 24));
+        glyph.SetPath(path + "/" + fontName + "/" + codeStr + ".xml");
+        glyph.SetHorizAdvX(readFloat(offset + 28));
+
+        const size_t firstAnchor = readUInt(offset + 32);
+        const size_t glyphAnchorCount = readUInt(offset + 36);
+        for (size_t j = firstAnchor; (j < firstAnchor + glyphAnchorCount) && (j < anchorCount); ++j) {
+            const size_t anchorOffset = anchorsOffset + j * anchorSize;
+            const char *anchorName = readString(readUInt(anchorOffset));
+            if (!anchorName) continue;
+            glyph.SetAnchor(anchorName, readFloat(anchorOffset + 4), readFloat(anchorOffset + 8));
+        }
+
+        font.m_glyphTable[code] = glyph;
+        font.m_glyphNameTable[name] = code;
+    }
+
+    return true;
+}
+
+uint32_t Resources::HashMetrics(const char *data, size_t size)
+{
+    // 32-bit FNV-1a, as in fonts/generate-binary-metrics.py
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= (unsigned char)data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
 } // namespace vrv
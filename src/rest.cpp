@@ -212,9 +212,11 @@ void Rest::AddChild(Object *child)
     // for the drawing order in the SVG output
     if (child->Is(DOTS)) {
         children.insert(children.begin(), child);
+        this->UpdateChildIndices();
     }
     else {
         children.push_back(child);
+        this->UpdateChildIndices((int)children.size() - 1);
     }
     Modify();
 }
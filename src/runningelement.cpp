@@ -91,9 +91,9 @@ bool RunningElement::IsSupportedChild(Object *child)
     return true;
 }
 
-void RunningElement::FilterList(ListOfConstObjects &childList) const
+void RunningElement::FilterList(ArrayOfConstObjects &childList) const
 {
-    ListOfConstObjects::iterator iter = childList.begin();
+    ArrayOfConstObjects::iterator iter = childList.begin();
 
     while (iter != childList.end()) {
         // remove nested rend elements
@@ -298,6 +298,32 @@ bool RunningElement::AdjustRunningElementYPos()
     return true;
 }
 
+std::vector<int> RunningElement::GetDrawingYRels() const
+{
+    std::vector<int> drawingYRels = { m_drawingYRel };
+    for (int i = 0; i < 9; ++i) {
+        for (const TextElement *element : m_cells[i]) {
+            drawingYRels.push_back(element->GetDrawingYRel());
+        }
+    }
+    return drawingYRels;
+}
+
+void RunningElement::SetDrawingYRels(const std::vector<int> &drawingYRels)
+{
+    if (drawingYRels.empty()) return;
+
+    this->SetDrawingYRel(drawingYRels.at(0));
+    int pos = 1;
+    for (int i = 0; i < 9; ++i) {
+        for (TextElement *element : m_cells[i]) {
+            // The content is not expected to change between the pages
+            if (pos >= (int)drawingYRels.size()) return;
+            element->SetDrawingYRel(drawingYRels.at(pos++));
+        }
+    }
+}
+
 int RunningElement::GetAlignmentPos(data_HORIZONTALALIGNMENT h, data_VERTICALALIGNMENT v)
 {
     int pos = 0;
@@ -388,8 +414,8 @@ int RunningElement::PrepareDataInitialization(FunctorParams *)
         m_drawingScalingPercent[i] = 100;
     }
 
-    const ListOfObjects &childList = this->GetList(this);
-    for (ListOfObjects::const_iterator iter = childList.begin(); iter != childList.end(); ++iter) {
+    const ArrayOfObjects &childList = this->GetList(this);
+    for (ArrayOfObjects::const_iterator iter = childList.begin(); iter != childList.end(); ++iter) {
         int pos = 0;
         AreaPosInterface *interface = dynamic_cast<AreaPosInterface *>(*iter);
         assert(interface);
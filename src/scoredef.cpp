@@ -449,10 +449,10 @@ void ScoreDef::ReplaceDrawingLabels(const StaffGrp *newStaffGrp)
     }
 }
 
-void ScoreDef::FilterList(ListOfConstObjects &childList) const
+void ScoreDef::FilterList(ArrayOfConstObjects &childList) const
 {
     // We want to keep only staffDef
-    ListOfConstObjects::iterator iter = childList.begin();
+    ArrayOfConstObjects::iterator iter = childList.begin();
 
     while (iter != childList.end()) {
         if (!(*iter)->Is(STAFFDEF)) {
@@ -466,7 +466,7 @@ void ScoreDef::FilterList(ListOfConstObjects &childList) const
 
 void ScoreDef::ResetFromDrawingValues()
 {
-    const ListOfObjects &childList = this->GetList(this);
+    const ArrayOfObjects &childList = this->GetList(this);
 
     StaffDef *staffDef = NULL;
     for (auto item : childList) {
@@ -501,8 +501,8 @@ StaffDef *ScoreDef::GetStaffDef(int n)
 
 const StaffDef *ScoreDef::GetStaffDef(int n) const
 {
-    const ListOfConstObjects &childList = this->GetList(this);
-    ListOfConstObjects::const_iterator iter;
+    const ArrayOfConstObjects &childList = this->GetList(this);
+    ArrayOfConstObjects::const_iterator iter;
 
     const StaffDef *staffDef = NULL;
     for (iter = childList.begin(); iter != childList.end(); ++iter) {
@@ -538,8 +538,8 @@ const StaffGrp *ScoreDef::GetStaffGrp(const std::string &n) const
 
 std::vector<int> ScoreDef::GetStaffNs() const
 {
-    const ListOfConstObjects &childList = this->GetList(this);
-    ListOfConstObjects::const_iterator iter;
+    const ArrayOfConstObjects &childList = this->GetList(this);
+    ArrayOfConstObjects::const_iterator iter;
 
     std::vector<int> ns;
     const StaffDef *staffDef = NULL;
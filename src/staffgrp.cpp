@@ -97,10 +97,10 @@ bool StaffGrp::IsSupportedChild(Object *child)
     return true;
 }
 
-void StaffGrp::FilterList(ListOfConstObjects &childList) const
+void StaffGrp::FilterList(ArrayOfConstObjects &childList) const
 {
     // We want to keep only staffDef
-    ListOfConstObjects::iterator iter = childList.begin();
+    ArrayOfConstObjects::iterator iter = childList.begin();
 
     while (iter != childList.end()) {
         if (!(*iter)->Is(STAFFDEF)) {
@@ -114,7 +114,7 @@ void StaffGrp::FilterList(ListOfConstObjects &childList) const
 
 int StaffGrp::GetMaxStaffSize() const
 {
-    const ListOfConstObjects &childList = this->GetList(this);
+    const ArrayOfConstObjects &childList = this->GetList(this);
 
     if (childList.empty()) return 100;
 
@@ -143,13 +143,13 @@ std::pair<StaffDef *, StaffDef *> StaffGrp::GetFirstLastStaffDef()
 
 std::pair<const StaffDef *, const StaffDef *> StaffGrp::GetFirstLastStaffDef() const
 {
-    const ListOfConstObjects &staffDefs = this->GetList(this);
+    const ArrayOfConstObjects &staffDefs = this->GetList(this);
     if (staffDefs.empty()) {
         return { NULL, NULL };
     }
 
     const StaffDef *firstDef = NULL;
-    ListOfConstObjects::const_iterator iter;
+    ArrayOfConstObjects::const_iterator iter;
     for (iter = staffDefs.begin(); iter != staffDefs.end(); ++iter) {
         const StaffDef *staffDef = vrv_cast<const StaffDef *>(*iter);
         assert(staffDef);
@@ -160,7 +160,7 @@ std::pair<const StaffDef *, const StaffDef *> StaffGrp::GetFirstLastStaffDef() c
     }
 
     const StaffDef *lastDef = NULL;
-    ListOfConstObjects::const_reverse_iterator riter;
+    ArrayOfConstObjects::const_reverse_iterator riter;
     for (riter = staffDefs.rbegin(); riter != staffDefs.rend(); ++riter) {
         const StaffDef *staffDef = vrv_cast<const StaffDef *>(*riter);
         assert(staffDef);
@@ -10,6 +10,7 @@
 //----------------------------------------------------------------------------
 
 #include <cassert>
+#include <cstring>
 
 //----------------------------------------------------------------------------
 
@@ -29,6 +30,23 @@ namespace vrv {
 #define space " "
 #define semicolon ";"
 
+//----------------------------------------------------------------------------
+// SvgStringWriter
+//----------------------------------------------------------------------------
+
+/**
+ * This class is a pugi::xml_writer that appends the output to a string.
+ */
+class SvgStringWriter : public pugi::xml_writer {
+public:
+    SvgStringWriter(std::string &output) : m_output(output) {}
+
+    void write(const void *data, size_t size) override { m_output.append(static_cast<const char *>(data), size); }
+
+private:
+    std::string &m_output;
+};
+
 //----------------------------------------------------------------------------
 // SvgDeviceContext
 //----------------------------------------------------------------------------
@@ -68,8 +86,6 @@ SvgDeviceContext::SvgDeviceContext() : DeviceContext(SVG_DEVICE_CONTEXT)
     m_svgNodeStack.push_back(m_svgNode);
     m_currentNode = m_svgNode;
 
-    m_outdata.clear();
-
     m_glyphPostfixId = Object::GenerateRandID();
 }
 
@@ -111,29 +127,24 @@ void SvgDeviceContext::Commit(bool xml_declaration)
     // add the woff VerovioText font if needed
     const Resources *resources = this->GetResources(true);
     if (m_vrvTextFont && resources) {
-        const std::string woffPath = resources->GetPath() + "/woff.xml";
-        pugi::xml_document woffDoc;
-        woffDoc.load_file(woffPath.c_str());
-        m_svgNode.prepend_copy(woffDoc.first_child());
+        m_svgNode.prepend_copy(resources->GetWoffSvgDef());
     }
 
     // header
     if (m_smuflGlyphs.size() > 0) {
 
         pugi::xml_node defs = m_svgNode.prepend_child("defs");
-        pugi::xml_document sourceDoc;
 
         // for each needed glyph
         for (auto it = m_smuflGlyphs.begin(); it != m_smuflGlyphs.end(); ++it) {
-            // load the XML file that contains it as a pugi::xml_document
-            std::ifstream source((*it)->GetPath());
-            sourceDoc.load(source);
+            // get the cached parsed XML file that contains it
+            pugi::xml_node sourceDoc = Resources::GetGlyphSvgDefs(*it);
 
             // copy all the nodes inside into the master document
             for (pugi::xml_node child = sourceDoc.first_child(); child; child = child.next_sibling()) {
+                pugi::xml_node copy = defs.append_copy(child);
                 std::string id = StringFormat("%s-%s", child.attribute("id").value(), m_glyphPostfixId.c_str());
-                child.attribute("id").set_value(id.c_str());
-                defs.append_copy(child);
+                copy.attribute("id").set_value(id.c_str());
             }
         }
     }
@@ -159,7 +170,8 @@ void SvgDeviceContext::Commit(bool xml_declaration)
 
     // save the glyph data to m_outdata
     std::string indent = (m_indent == -1) ? "\t" : std::string(m_indent, ' ');
-    m_svgDoc.save(m_outdata, indent.c_str(), output_flags);
+    SvgStringWriter writer(m_outdata);
+    m_svgDoc.save(writer, indent.c_str(), output_flags);
 
     m_committed = true;
 }
@@ -342,11 +354,18 @@ void SvgDeviceContext::StartTextGraphic(Object *object, std::string gClass, std:
 
 void SvgDeviceContext::ResumeGraphic(Object *object, std::string gId)
 {
-    std::string xpathPrefix = m_html5 ? "//g[@data-id=\"" : "//g[@id=\"";
-    std::string xpath = xpathPrefix + gId + "\"]";
-    pugi::xpath_node selection = m_currentNode.select_node(xpath.c_str());
-    if (selection) {
-        m_currentNode = selection.node();
+    auto selection = m_graphicNodes.find(gId);
+    if (selection != m_graphicNodes.end()) {
+        if (selection->second.size() == 1) {
+            m_currentNode = selection->second.front();
+        }
+        // With several groups for the id, the first one in document order has to be found in the document
+        else {
+            std::string xpathPrefix = m_html5 ? "//g[@data-id=\"" : "//g[@id=\"";
+            std::string xpath = xpathPrefix + gId + "\"]";
+            pugi::xpath_node node = m_currentNode.select_node(xpath.c_str());
+            if (node) m_currentNode = node.node();
+        }
     }
     m_svgNodeStack.push_back(m_currentNode);
 }
@@ -497,6 +516,22 @@ pugi::xml_node SvgDeviceContext::AppendChild(std::string name)
         return m_currentNode.append_child(name.c_str());
 }
 
+void SvgDeviceContext::RegisterGraphicNode(pugi::xml_node node, bool deep)
+{
+    if (node.type() != pugi::node_element) return;
+
+    if (!strcmp(node.name(), "g")) {
+        pugi::xml_attribute id = node.attribute(m_html5 ? "data-id" : "id");
+        if (id) m_graphicNodes[id.value()].push_back(node);
+    }
+
+    if (deep) {
+        for (pugi::xml_node child : node.children()) {
+            this->RegisterGraphicNode(child, true);
+        }
+    }
+}
+
 void SvgDeviceContext::AppendStrokeLineCap(pugi::xml_node node, const Pen &pen)
 {
     switch (pen.GetLineCap()) {
@@ -998,7 +1033,7 @@ void SvgDeviceContext::DrawSvgShape(int x, int y, int width, int height, pugi::x
         = StringFormat("translate(%d, %d) scale(%d, %d)", x, y, DEFINITION_FACTOR, DEFINITION_FACTOR).c_str();
 
     for (pugi::xml_node child : svg.children()) {
-        m_currentNode.append_copy(child);
+        this->RegisterGraphicNode(m_currentNode.append_copy(child), true);
     }
 }
 
@@ -1036,6 +1071,8 @@ void SvgDeviceContext::AppendIdAndClass(std::string gId, std::string baseClass,
         baseClass.append(" " + addedClasses);
     }
     m_currentNode.append_attribute("class") = baseClass.c_str();
+
+    this->RegisterGraphicNode(m_currentNode);
 }
 
 void SvgDeviceContext::AppendAdditionalAttributes(Object *object)
@@ -1081,7 +1118,7 @@ std::string SvgDeviceContext::GetStringSVG(bool xml_declaration)
 {
     if (!m_committed) Commit(xml_declaration);
 
-    return m_outdata.str();
+    return m_outdata;
 }
 
 void SvgDeviceContext::DrawSvgBoundingBoxRectangle(int x, int y, int width, int height)
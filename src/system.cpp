@@ -9,6 +9,7 @@
 
 //----------------------------------------------------------------------------
 
+#include <algorithm>
 #include <cassert>
 
 //----------------------------------------------------------------------------
@@ -40,6 +41,9 @@ namespace vrv {
 // System
 //----------------------------------------------------------------------------
 
+const std::vector<ClassId> System::s_spannedLayerElementClassIds
+    = { ACCID, ARTIC, CHORD, CLEF, FLAG, GLISS, NOTE, STEM, TUPLET_BRACKET, TUPLET_NUM };
+
 System::System() : Object(SYSTEM, "system-"), DrawingListInterface(), AttTyped()
 {
     this->RegisterAttClass(ATT_TYPED);
@@ -82,6 +86,8 @@ void System::Reset()
     m_castOffJustifiableWidth = 0;
     m_drawingAbbrLabelsWidth = 0;
     m_drawingIsOptimized = false;
+
+    this->ClearSpannedLayerElementIndex();
 }
 
 bool System::IsSupportedChild(Object *child)
@@ -108,7 +114,6 @@ int System::GetDrawingX() const
 {
     if (m_xAbs != VRV_UNSET) return m_xAbs;
 
-    m_cachedDrawingX = 0;
     return m_drawingXRel;
 }
 
@@ -116,7 +121,6 @@ int System::GetDrawingY() const
 {
     if (m_yAbs != VRV_UNSET) return m_yAbs;
 
-    m_cachedDrawingY = 0;
     return m_drawingYRel;
 }
 
@@ -278,8 +282,7 @@ curvature_CURVEDIR System::GetPreferredCurveDirection(
     const Layer *layerStart = vrv_cast<const Layer *>(start->GetFirstAncestor(LAYER));
     assert(layerStart);
 
-    Functor findSpannedLayerElements(&Object::FindSpannedLayerElements);
-    this->Process(&findSpannedLayerElements, &findSpannedLayerElementsParams);
+    this->FindSpannedLayerElements(&findSpannedLayerElementsParams);
 
     curvature_CURVEDIR preferredDirection = curvature_CURVEDIR_NONE;
     for (auto element : findSpannedLayerElementsParams.m_elements) {
@@ -306,6 +309,115 @@ curvature_CURVEDIR System::GetPreferredCurveDirection(
     return preferredDirection;
 }
 
+void System::IndexSpannedLayerElements()
+{
+    this->ClearSpannedLayerElementIndex();
+
+    for (const Object *object : this->FindAllDescendantsByType(MEASURE, false)) {
+        m_indexedMeasures.push_back(vrv_cast<const Measure *>(object));
+    }
+
+    // Collect the elements in the same order as the FindSpannedLayerElements functor
+    int order = 0;
+    ClassIdsComparison comparison(s_spannedLayerElementClassIds);
+    for (int measureIdx = 0; measureIdx < (int)m_indexedMeasures.size(); ++measureIdx) {
+        ListOfConstObjects elements;
+        m_indexedMeasures.at(measureIdx)->FindAllDescendantsByComparison(&elements, &comparison);
+        for (const Object *object : elements) {
+            if (!object->IsLayerElement()) continue;
+            const LayerElement *element = vrv_cast<const LayerElement *>(object);
+            assert(element);
+            if (element->IsScoreDefElement() || !element->HasContentBB() || element->HasEmptyBB()) continue;
+
+            const IndexedLayerElement entry
+                = { element->GetContentLeft(), element->GetContentRight(), order++, measureIdx, element };
+            // The element is indexed for its staff and its cross staff
+            std::set<int> staffNs = { element->GetAncestorStaff()->GetN() };
+            const Layer *layer = NULL;
+            const Staff *crossStaff = element->GetCrossStaff(layer);
+            if (crossStaff) staffNs.insert(crossStaff->GetN());
+            for (int staffN : staffNs) {
+                m_spannedLayerElementIndex[staffN].push_back(entry);
+                int &maxWidth = m_spannedLayerElementMaxWidths[staffN];
+                maxWidth = std::max(maxWidth, entry.m_right - entry.m_left);
+            }
+        }
+    }
+
+    for (auto &[staffN, entries] : m_spannedLayerElementIndex) {
+        std::stable_sort(entries.begin(), entries.end(),
+            [](const IndexedLayerElement &a, const IndexedLayerElement &b) { return (a.m_left < b.m_left); });
+    }
+
+    m_hasSpannedLayerElementIndex = true;
+}
+
+void System::ClearSpannedLayerElementIndex()
+{
+    m_hasSpannedLayerElementIndex = false;
+    m_spannedLayerElementIndex.clear();
+    m_spannedLayerElementMaxWidths.clear();
+    m_indexedMeasures.clear();
+}
+
+void System::FindSpannedLayerElements(FindSpannedLayerElementsParams *params, const Measure *measure) const
+{
+    assert(params);
+
+    const bool useIndex = m_hasSpannedLayerElementIndex
+        && std::all_of(params->m_classIds.cbegin(), params->m_classIds.cend(), [](ClassId classId) {
+               return (std::find(s_spannedLayerElementClassIds.cbegin(), s_spannedLayerElementClassIds.cend(), classId)
+                   != s_spannedLayerElementClassIds.cend());
+           });
+
+    if (!useIndex) {
+        const Object *container = (measure) ? static_cast<const Object *>(measure) : this;
+        Functor findSpannedLayerElements(&Object::FindSpannedLayerElements);
+        container->Process(&findSpannedLayerElements, params);
+        return;
+    }
+
+    // The measures to look at, as pruned by the functor when processing the container - only evaluated for candidates
+    std::map<int, bool> measureMatches;
+    auto matchesMeasure = [this, params, measure, &measureMatches](int measureIdx) {
+        auto [iter, inserted] = measureMatches.try_emplace(measureIdx, false);
+        if (inserted) {
+            const Measure *indexedMeasure = m_indexedMeasures.at(measureIdx);
+            iter->second = (!measure || (indexedMeasure == measure))
+                && (indexedMeasure->FindSpannedLayerElements(params) == FUNCTOR_CONTINUE);
+        }
+        return iter->second;
+    };
+
+    // Range query on the elements of each staff, the search starts at the maximal width before the minimal position
+    std::vector<const IndexedLayerElement *> candidates;
+    for (const auto &[staffN, entries] : m_spannedLayerElementIndex) {
+        if (!params->m_staffNs.empty() && (params->m_staffNs.find(staffN) == params->m_staffNs.end())) continue;
+        const int minLeft = params->m_minPos - m_spannedLayerElementMaxWidths.at(staffN);
+        auto iter = std::upper_bound(entries.cbegin(), entries.cend(), minLeft,
+            [](int left, const IndexedLayerElement &entry) { return (left < entry.m_left); });
+        for (; (iter != entries.cend()) && (iter->m_left < params->m_maxPos); ++iter) {
+            if ((iter->m_right > params->m_minPos) && matchesMeasure(iter->m_measureIdx)) {
+                candidates.push_back(&(*iter));
+            }
+        }
+    }
+
+    // Restore the order of the elements in the system - elements indexed for two staves appear twice
+    std::sort(candidates.begin(), candidates.end(),
+        [](const IndexedLayerElement *a, const IndexedLayerElement *b) { return (a->m_order < b->m_order); });
+    candidates.erase(std::unique(candidates.begin(), candidates.end(),
+                         [](const IndexedLayerElement *a, const IndexedLayerElement *b) {
+                             return (a->m_order == b->m_order);
+                         }),
+        candidates.end());
+
+    // The functor does the actual filtering with the current bounding boxes
+    for (const IndexedLayerElement *candidate : candidates) {
+        candidate->m_element->FindSpannedLayerElements(params);
+    }
+}
+
 void System::AddToDrawingListIfNecessary(Object *object)
 {
     assert(object);
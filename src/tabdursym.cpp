@@ -71,9 +71,11 @@ void TabDurSym::AddChild(Object *child)
     // for the drawing order in the SVG output
     if (child->Is(STEM)) {
         children.insert(children.begin(), child);
+        this->UpdateChildIndices();
     }
     else {
         children.push_back(child);
+        this->UpdateChildIndices((int)children.size() - 1);
     }
     Modify();
 }
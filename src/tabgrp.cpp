@@ -58,10 +58,10 @@ bool TabGrp::IsSupportedChild(Object *child)
     return true;
 }
 
-void TabGrp::FilterList(ListOfConstObjects &childList) const
+void TabGrp::FilterList(ArrayOfConstObjects &childList) const
 {
     // Retain only note children of chords
-    ListOfConstObjects::iterator iter = childList.begin();
+    ArrayOfConstObjects::iterator iter = childList.begin();
 
     while (iter != childList.end()) {
         if ((*iter)->Is(NOTE)) {
@@ -72,7 +72,7 @@ void TabGrp::FilterList(ListOfConstObjects &childList) const
         }
     }
 
-    childList.sort(TabCourseSort());
+    std::stable_sort(childList.begin(), childList.end(), TabCourseSort());
 }
 
 int TabGrp::GetYTop() const
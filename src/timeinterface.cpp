@@ -227,6 +227,11 @@ bool TimeSpanningInterface::SetStartAndEnd(LayerElement *element)
     return (m_start && m_end);
 }
 
+bool TimeSpanningInterface::IsWaitingFor(const std::string &id) const
+{
+    return ((!m_start && (m_startID == id)) || (!m_end && (m_endID == id)));
+}
+
 Measure *TimeSpanningInterface::GetEndMeasure()
 {
     return const_cast<Measure *>(std::as_const(*this).GetEndMeasure());
@@ -379,7 +384,9 @@ int TimePointInterface::InterfacePrepareTimePointing(FunctorParams *functorParam
     if (!this->HasStartid()) return FUNCTOR_CONTINUE;
 
     this->SetIDStr();
-    params->m_timePointingInterfaces.push_back({ this, object->GetClassId() });
+    if (m_startID.empty()) return FUNCTOR_CONTINUE;
+
+    params->m_timePointingInterfaces.insert({ m_startID, { this, object->GetClassId() } });
 
     return FUNCTOR_CONTINUE;
 }
@@ -398,7 +405,13 @@ int TimeSpanningInterface::InterfacePrepareTimeSpanning(FunctorParams *functorPa
     }
 
     this->SetIDStr();
-    params->m_timeSpanningInterfaces.push_back({ this, object });
+    // The interface is listed under each @xml:id it is waiting for, but only once if they are identical
+    if (!m_startID.empty()) {
+        params->m_timeSpanningInterfaces.insert({ m_startID, { this, object } });
+    }
+    if (!m_endID.empty() && (m_endID != m_startID)) {
+        params->m_timeSpanningInterfaces.insert({ m_endID, { this, object } });
+    }
 
     return FUNCTOR_CONTINUE;
 }
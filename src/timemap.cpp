@@ -10,9 +10,11 @@
 //----------------------------------------------------------------------------
 
 #include <cassert>
+#include <limits>
 
 //----------------------------------------------------------------------------
 
+#include "chord.h"
 #include "functorparams.h"
 #include "measure.h"
 #include "note.h"
@@ -117,13 +119,19 @@ void Timemap::AddEntry(Object *object, GenerateTimemapParams *params)
 }
 
 void Timemap::ToJson(std::string &output, bool includeRests, bool includeMeasures)
+{
+    Timemap::EntriesToJson(m_map, output, includeRests, includeMeasures);
+}
+
+void Timemap::EntriesToJson(
+    const std::map<double, TimemapEntry> &entries, std::string &output, bool includeRests, bool includeMeasures)
 {
     double currentTempo = -1000.0;
     double newTempo;
 
     jsonxx::Array timemap;
 
-    for (auto &[tstamp, entry] : m_map) {
+    for (auto &[tstamp, entry] : entries) {
         jsonxx::Object o;
         o << "tstamp" << tstamp;
         o << "qstamp" << entry.qstamp;
@@ -173,4 +181,208 @@ void Timemap::ToJson(std::string &output, bool includeRests, bool includeMeasure
     output = timemap.json();
 }
 
+//----------------------------------------------------------------------------
+// TimeIndex
+//----------------------------------------------------------------------------
+
+TimeIndex::TimeIndex()
+{
+    this->Reset();
+}
+
+TimeIndex::~TimeIndex() {}
+
+void TimeIndex::Reset()
+{
+    m_measures.clear();
+    m_elements.clear();
+    m_measureIntervals.clear();
+    m_elementIntervals.clear();
+}
+
+void TimeIndex::AddMeasure(const Measure *measure, const ListOfObjects &notesOrRests)
+{
+    assert(measure);
+
+    const int measureIdx = (int)m_measures.size();
+    TimeIndexMeasure indexMeasure;
+    indexMeasure.id = measure->GetID();
+
+    // The offset of the measure interval is calculated as in Measure::EnclosesTime
+    const double duration = measure->GetRealTimeDurationMilliseconds();
+    indexMeasure.tempo = measure->GetCurrentTempo();
+    for (int repeat = 1; repeat <= measure->GetRealTimeRepeatCount(); ++repeat) {
+        const double offset = measure->GetRealTimeOffsetMilliseconds(repeat);
+        indexMeasure.offsets.push_back(offset);
+        indexMeasure.scoreOffsets.push_back(measure->GetScoreTimeOffset(repeat));
+        m_measureIntervals.push_back({ offset, offset + duration, 0.0, measureIdx, repeat });
+    }
+    m_measures.push_back(indexMeasure);
+
+    for (const Object *object : notesOrRests) {
+        const DurationInterface *interface = object->GetDurationInterface();
+        assert(interface);
+
+        const int elementIdx = (int)m_elements.size();
+        TimeIndexElement element;
+        element.id = object->GetID();
+        element.isRest = object->Is(REST);
+        element.isGrace = false;
+        element.onset = interface->GetRealTimeOnsetMilliseconds();
+        element.offset = interface->GetRealTimeOffsetMilliseconds();
+        element.scoreOnset = interface->GetScoreTimeOnset();
+        element.scoreOffset = interface->GetScoreTimeOffset();
+        element.measure = measureIdx;
+        if (object->Is(NOTE)) {
+            const Note *note = vrv_cast<const Note *>(object);
+            assert(note);
+            const Chord *chord = note->IsChordTone();
+            if (chord) element.chordID = chord->GetID();
+            element.isGrace = note->HasGrace();
+        }
+        m_elements.push_back(element);
+
+        for (int repeat = 1; repeat <= (int)indexMeasure.offsets.size(); ++repeat) {
+            const double offset = indexMeasure.offsets.at(repeat - 1);
+            m_elementIntervals.push_back({ offset + element.onset, offset + element.offset, 0.0, elementIdx, repeat });
+        }
+    }
+}
+
+void TimeIndex::Build()
+{
+    auto comp = [](const TimeIndexInterval &interval1, const TimeIndexInterval &interval2) {
+        return (interval1.onset < interval2.onset);
+    };
+
+    std::stable_sort(m_measureIntervals.begin(), m_measureIntervals.end(), comp);
+    this->CalcMaxOffset(m_measureIntervals, 0, (int)m_measureIntervals.size());
+
+    std::stable_sort(m_elementIntervals.begin(), m_elementIntervals.end(), comp);
+    this->CalcMaxOffset(m_elementIntervals, 0, (int)m_elementIntervals.size());
+}
+
+bool TimeIndex::FindElementsAtTime(
+    int millisec, std::string &measureID, std::vector<const TimeIndexElement *> &elements) const
+{
+    std::vector<int> positions;
+    this->FindIntervals(m_measureIntervals, 0, (int)m_measureIntervals.size(), millisec, millisec, positions);
+    if (positions.empty()) return false;
+
+    // Several measures can enclose the time at their boundaries - take the first one and its first repeat
+    const TimeIndexInterval *measureInterval = NULL;
+    for (int position : positions) {
+        const TimeIndexInterval &interval = m_measureIntervals.at(position);
+        if (!measureInterval || (interval.index < measureInterval->index)
+            || ((interval.index == measureInterval->index) && (interval.repeat < measureInterval->repeat))) {
+            measureInterval = &interval;
+        }
+    }
+    const TimeIndexMeasure &measure = m_measures.at(measureInterval->index);
+    measureID = measure.id;
+
+    // Elements are matched with the time relative to the measure as an int, as in the timemap.
+    // The intervals are looked up at that time brought back to real time.
+    const double measureOffset = measure.offsets.at(measureInterval->repeat - 1);
+    const int time = millisec - (int)measureOffset;
+    positions.clear();
+    this->FindIntervals(
+        m_elementIntervals, 0, (int)m_elementIntervals.size(), measureOffset + time, measureOffset + time, positions);
+
+    std::vector<int> elementIndices;
+    for (int position : positions) {
+        const TimeIndexInterval &interval = m_elementIntervals.at(position);
+        if (interval.repeat != measureInterval->repeat) continue;
+        const TimeIndexElement &element = m_elements.at(interval.index);
+        if (element.measure != measureInterval->index) continue;
+        if ((time >= element.onset) && (time <= element.offset)) elementIndices.push_back(interval.index);
+    }
+    // Return the elements in document order
+    std::sort(elementIndices.begin(), elementIndices.end());
+    for (int elementIdx : elementIndices) {
+        elements.push_back(&m_elements.at(elementIdx));
+    }
+
+    return true;
+}
+
+void TimeIndex::FindEventsBetween(int fromMillisec, int toMillisec, std::map<double, TimemapEntry> &events) const
+{
+    std::vector<int> positions;
+    this->FindIntervals(m_measureIntervals, 0, (int)m_measureIntervals.size(), fromMillisec, toMillisec, positions);
+    for (int position : positions) {
+        const TimeIndexInterval &interval = m_measureIntervals.at(position);
+        if (interval.onset < fromMillisec) continue;
+        const TimeIndexMeasure &measure = m_measures.at(interval.index);
+        TimemapEntry &entry = events[interval.onset];
+        entry.qstamp = measure.scoreOffsets.at(interval.repeat - 1);
+        entry.measureOn = measure.id;
+    }
+
+    positions.clear();
+    this->FindIntervals(m_elementIntervals, 0, (int)m_elementIntervals.size(), fromMillisec, toMillisec, positions);
+    // Fill the events in document order
+    std::sort(positions.begin(), positions.end(), [this](int position1, int position2) {
+        return (m_elementIntervals.at(position1).index < m_elementIntervals.at(position2).index);
+    });
+    for (int position : positions) {
+        const TimeIndexInterval &interval = m_elementIntervals.at(position);
+        const TimeIndexElement &element = m_elements.at(interval.index);
+        // Grace notes are not in the timemap
+        if (element.isGrace) continue;
+        const TimeIndexMeasure &measure = m_measures.at(element.measure);
+        const double scoreOffset = measure.scoreOffsets.at(interval.repeat - 1);
+        if (interval.onset >= fromMillisec) {
+            TimemapEntry &entry = events[interval.onset];
+            entry.qstamp = scoreOffset + element.scoreOnset;
+            entry.tempo = measure.tempo;
+            if (element.isRest) {
+                entry.restsOn.push_back(element.id);
+            }
+            else {
+                entry.notesOn.push_back(element.id);
+            }
+        }
+        if (interval.offset <= toMillisec) {
+            TimemapEntry &entry = events[interval.offset];
+            entry.qstamp = scoreOffset + element.scoreOffset;
+            if (element.isRest) {
+                entry.restsOff.push_back(element.id);
+            }
+            else {
+                entry.notesOff.push_back(element.id);
+            }
+        }
+    }
+}
+
+double TimeIndex::CalcMaxOffset(std::vector<TimeIndexInterval> &intervals, int begin, int end)
+{
+    if (begin >= end) return -std::numeric_limits<double>::max();
+
+    const int middle = (begin + end) / 2;
+    TimeIndexInterval &interval = intervals.at(middle);
+    interval.maxOffset = std::max(interval.offset,
+        std::max(this->CalcMaxOffset(intervals, begin, middle), this->CalcMaxOffset(intervals, middle + 1, end)));
+    return interval.maxOffset;
+}
+
+void TimeIndex::FindIntervals(const std::vector<TimeIndexInterval> &intervals, int begin, int end, double from,
+    double to, std::vector<int> &positions) const
+{
+    if (begin >= end) return;
+
+    const int middle = (begin + end) / 2;
+    const TimeIndexInterval &interval = intervals.at(middle);
+    // Nothing in the subtree ends after from
+    if (interval.maxOffset < from) return;
+
+    this->FindIntervals(intervals, begin, middle, from, to, positions);
+    // Everything on the right starts after to
+    if (interval.onset > to) return;
+
+    if (interval.offset >= from) positions.push_back(middle);
+    this->FindIntervals(intervals, middle + 1, end, from, to, positions);
+}
+
 } // namespace vrv
@@ -9,9 +9,13 @@
 
 //----------------------------------------------------------------------------
 
+#include <atomic>
 #include <cassert>
 #include <codecvt>
+#include <cstdio>
 #include <locale>
+#include <memory>
+#include <mutex>
 #include <regex>
 
 //----------------------------------------------------------------------------
@@ -85,6 +89,7 @@ Toolkit::Toolkit(bool initFont)
     m_options = m_doc.GetOptions();
 
     m_skipLayoutOnLoad = false;
+    m_hasLayoutOptions = false;
 
     m_editorToolkit = NULL;
 
@@ -107,6 +112,8 @@ Toolkit::~Toolkit()
         delete m_editorToolkit;
         m_editorToolkit = NULL;
     }
+    for (Toolkit *toolkit : m_recordToolkits) delete toolkit;
+    m_recordToolkits.clear();
 #ifndef NO_RUNTIME
     if (m_runtimeClock) {
         delete m_runtimeClock;
@@ -304,14 +311,7 @@ FileFormat Toolkit::IdentifyInputFrom(const std::string &data)
 
 bool Toolkit::LoadFile(const std::string &filename)
 {
-    if (this->IsUTF16(filename)) {
-        return this->LoadUTF16File(filename);
-    }
-    if (this->IsZip(filename)) {
-        return this->LoadZipFile(filename);
-    }
-
-    std::ifstream in(filename.c_str());
+    std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary);
     if (!in.is_open()) {
         return false;
     }
@@ -324,107 +324,67 @@ bool Toolkit::LoadFile(const std::string &filename)
     // read the file into the std::string:
     std::string content(fileSize, 0);
     in.read(&content[0], fileSize);
+    in.close();
+
+    if (this->IsUTF16(content)) {
+        return this->LoadUTF16Data(content);
+    }
+    if (this->IsZip(content)) {
+        std::vector<unsigned char> bytes(content.begin(), content.end());
+        return this->LoadZipData(bytes);
+    }
+
+#ifdef _WIN32
+    // Read text files again in text mode for the line endings to be converted
+    in.open(filename.c_str());
+    if (!in.is_open()) {
+        return false;
+    }
+    in.read(&content[0], fileSize);
+    content.resize(in.gcount());
+    in.close();
+#endif
 
     m_doc.m_expansionMap.Reset();
 
-    return this->LoadData(content);
+    return this->LoadData(std::move(content));
 }
 
-bool Toolkit::IsUTF16(const std::string &filename)
+bool Toolkit::IsUTF16(const std::string &data)
 {
-    std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary);
-    if (!fin.is_open()) {
-        return false;
-    }
-
-    char data[2];
-    memset(data, 0, 2);
-    fin.read(data, 2);
-    fin.close();
+    if (data.size() < 2) return false;
 
-    if (memcmp(data, UTF_16_LE_BOM, 2) == 0) return true;
-    if (memcmp(data, UTF_16_BE_BOM, 2) == 0) return true;
+    if (memcmp(data.c_str(), UTF_16_LE_BOM, 2) == 0) return true;
+    if (memcmp(data.c_str(), UTF_16_BE_BOM, 2) == 0) return true;
 
     return false;
 }
 
-bool Toolkit::LoadUTF16File(const std::string &filename)
+bool Toolkit::LoadUTF16Data(const std::string &data)
 {
-    /// Loading a UTF-16 file with basic conversion ot UTF-8
-    /// This is called after checking if the file has a UTF-16 BOM
+    /// Loading UTF-16 data with basic conversion ot UTF-8
+    /// This is called after checking if the data has a UTF-16 BOM
 
     LogWarning("The file seems to be UTF-16 - trying to convert to UTF-8");
 
-    std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary);
-    if (!fin.is_open()) {
-        return false;
-    }
-
-    fin.seekg(0, std::ios::end);
-    std::streamsize wfileSize = (std::streamsize)fin.tellg();
-    fin.clear();
-    fin.seekg(0, std::wios::beg);
-
-    std::u16string u16data((wfileSize / 2) + 1, '\0');
-    fin.read((char *)&u16data[0], wfileSize);
-
-    // std::vector<char16_t> ;
-    // utf16line.reserve(wfileSize / 2 + 1);
-
-    // unsigned short buffer;
-    // while (fin.read((char *)&buffer, sizeof(char16_t))) {
-    //     utf16line.push_back(buffer);
-    // }
-
-    // std::u16string u16_str; //( reinterpret_cast<const char16_t*>(data2) );
-    //  LogDebug("%d %d", wfileSize, utf8line.size());
+    std::u16string u16data(data.size() / 2, '\0');
+    memcpy(&u16data[0], data.c_str(), u16data.size() * sizeof(char16_t));
 
     std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert;
     std::string utf8line = convert.to_bytes(u16data);
 
-    return this->LoadData(utf8line);
+    return this->LoadData(std::move(utf8line));
 }
 
-bool Toolkit::IsZip(const std::string &filename)
+bool Toolkit::IsZip(const std::string &data)
 {
-    std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary);
-    if (!fin.is_open()) {
-        return false;
-    }
-
-    char data[4];
-    memset(data, 0, 4);
-    fin.read(data, 4);
-    fin.close();
+    if (data.size() < 4) return false;
 
-    if (memcmp(data, ZIP_SIGNATURE, 4) == 0) return true;
+    if (memcmp(data.c_str(), ZIP_SIGNATURE, 4) == 0) return true;
 
     return false;
 }
 
-bool Toolkit::LoadZipFile(const std::string &filename)
-{
-    std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary);
-    if (!fin.is_open()) {
-        return false;
-    }
-
-    fin.seekg(0, std::ios::end);
-    std::streamsize fileSize = (std::streamsize)fin.tellg();
-    fin.clear();
-    fin.seekg(0, std::wios::beg);
-
-    std::vector<unsigned char> bytes;
-    bytes.reserve(fileSize + 1);
-
-    unsigned char buffer;
-    while (fin.read((char *)&buffer, sizeof(unsigned char))) {
-        bytes.push_back(buffer);
-    }
-
-    return this->LoadZipData(bytes);
-}
-
 bool Toolkit::LoadZipData(const std::vector<unsigned char> &bytes)
 {
 #ifndef NO_MXL_SUPPORT
@@ -472,12 +432,26 @@ bool Toolkit::LoadZipDataBuffer(const unsigned char *data, int length)
 }
 
 bool Toolkit::LoadData(const std::string &data)
+{
+    return this->LoadData(data, NULL);
+}
+
+bool Toolkit::LoadData(std::string &&data)
+{
+    std::string buffer = std::move(data);
+    return this->LoadData(buffer, &buffer);
+}
+
+bool Toolkit::LoadData(const std::string &data, std::string *buffer)
 {
     std::string newData;
     Input *input = NULL;
+    bool isImported = false;
 
     if (m_options->m_xmlIdChecksum.GetValue()) {
-        crcInit();
+        // The table is filled once for all the toolkits, which can load data concurrently in RenderRecordsToSVG
+        static std::once_flag crcInitFlag;
+        std::call_once(crcInitFlag, crcInit);
         unsigned int cr = crcFast((unsigned char *)data.c_str(), (int)data.size());
         Object::SeedID(cr);
     }
@@ -538,6 +512,7 @@ bool Toolkit::LoadData(const std::string &data)
 
         // Read embedded options from input Humdrum file:
         ((HumdrumInput *)input)->parseEmbeddedOptions(&m_doc);
+        isImported = true;
     }
     else if (inputFormat == HUMMEI) {
         // convert first to MEI and then load MEI data via MEIInput.  This
@@ -595,40 +570,26 @@ bool Toolkit::LoadData(const std::string &data)
         std::string buffer = conversion.str();
         this->SetHumdrumBuffer(buffer.c_str());
 
-        // Now convert Humdrum into MEI:
-        Doc tempdoc;
-        tempdoc.SetOptions(m_doc.GetOptions());
-        Input *tempinput = new HumdrumInput(&tempdoc);
-        if (!tempinput->Import(conversion.str())) {
+        // Now import the Humdrum data:
+        input = this->ImportConvertedHumdrum(buffer);
+        if (!input) {
             LogError("Error importing Humdrum data (2)");
-            delete tempinput;
             return false;
         }
-        MEIOutput meioutput(&tempdoc);
-        meioutput.SetScoreBasedMEI(true);
-        newData = meioutput.GetOutput();
-        delete tempinput;
-        input = new MEIInput(&m_doc);
+        isImported = true;
     }
 
     else if (inputFormat == MEIHUM) {
         ConvertMEIToHumdrum(data);
 
-        // Now convert Humdrum into MEI:
+        // Now import the Humdrum data:
         std::string conversion = this->GetHumdrumBuffer();
-        Doc tempdoc;
-        tempdoc.SetOptions(m_doc.GetOptions());
-        Input *tempinput = new HumdrumInput(&tempdoc);
-        if (!tempinput->Import(conversion)) {
+        input = this->ImportConvertedHumdrum(conversion);
+        if (!input) {
             LogError("Error importing Humdrum data (3)");
-            delete tempinput;
             return false;
         }
-        MEIOutput meioutput(&tempdoc);
-        meioutput.SetScoreBasedMEI(true);
-        newData = meioutput.GetOutput();
-        delete tempinput;
-        input = new MEIInput(&m_doc);
+        isImported = true;
     }
 
     else if (inputFormat == MUSEDATAHUM) {
@@ -643,20 +604,13 @@ bool Toolkit::LoadData(const std::string &data)
         std::string buffer = conversion.str();
         this->SetHumdrumBuffer(buffer.c_str());
 
-        // Now convert Humdrum into MEI:
-        Doc tempdoc;
-        tempdoc.SetOptions(m_doc.GetOptions());
-        Input *tempinput = new HumdrumInput(&tempdoc);
-        if (!tempinput->Import(conversion.str())) {
+        // Now import the Humdrum data:
+        input = this->ImportConvertedHumdrum(buffer);
+        if (!input) {
             LogError("Error importing Humdrum data (4)");
-            delete tempinput;
             return false;
         }
-        MEIOutput meioutput(&tempdoc);
-        meioutput.SetScoreBasedMEI(true);
-        newData = meioutput.GetOutput();
-        delete tempinput;
-        input = new MEIInput(&m_doc);
+        isImported = true;
     }
 
     else if (inputFormat == ESAC) {
@@ -671,20 +625,13 @@ bool Toolkit::LoadData(const std::string &data)
         std::string buffer = conversion.str();
         this->SetHumdrumBuffer(buffer.c_str());
 
-        // Now convert Humdrum into MEI:
-        Doc tempdoc;
-        tempdoc.SetOptions(m_doc.GetOptions());
-        Input *tempinput = new HumdrumInput(&tempdoc);
-        if (!tempinput->Import(conversion.str())) {
+        // Now import the Humdrum data:
+        input = this->ImportConvertedHumdrum(buffer);
+        if (!input) {
             LogError("Error importing Humdrum data (5)");
-            delete tempinput;
             return false;
         }
-        MEIOutput meioutput(&tempdoc);
-        meioutput.SetScoreBasedMEI(true);
-        newData = meioutput.GetOutput();
-        delete tempinput;
-        input = new MEIInput(&m_doc);
+        isImported = true;
     }
 #endif
     else {
@@ -699,8 +646,19 @@ bool Toolkit::LoadData(const std::string &data)
     }
 
     // load the file
-    if (inputFormat != HUMDRUM) {
-        if (!input->Import(newData.size() ? newData : data)) {
+    if (!isImported) {
+        // converted data and data owned by the toolkit are not used anymore and can be imported in place
+        bool success = false;
+        if (newData.size()) {
+            success = input->ImportInPlace(newData);
+        }
+        else if (buffer) {
+            success = input->ImportInPlace(*buffer);
+        }
+        else {
+            success = input->Import(data);
+        }
+        if (!success) {
             LogError("Error importing data");
             delete input;
             return false;
@@ -786,6 +744,8 @@ bool Toolkit::LoadData(const std::string &data)
             // LogElapsedTimeEnd("cast-off");
         }
     }
+    m_layoutOptions = *m_options;
+    m_hasLayoutOptions = true;
 
     delete input;
     m_view.SetDoc(&m_doc);
@@ -808,12 +768,60 @@ bool Toolkit::LoadData(const std::string &data)
     return true;
 }
 
+#ifndef NO_HUMDRUM_SUPPORT
+Input *Toolkit::ImportConvertedHumdrum(const std::string &humdrum)
+{
+    // The Humdrum data is imported directly unless XPath queries have to be applied to the MEI
+    const bool hasXPathQueries = !m_options->m_mdivXPathQuery.GetValue().empty()
+        || !m_options->m_appXPathQuery.GetValue().empty() || !m_options->m_choiceXPathQuery.GetValue().empty()
+        || !m_options->m_substXPathQuery.GetValue().empty();
+
+    if (!hasXPathQueries) {
+        Input *input = new HumdrumInput(&m_doc);
+        if (!input->Import(humdrum)) {
+            delete input;
+            return NULL;
+        }
+        return input;
+    }
+
+    // Otherwise convert Humdrum into MEI and load it with MEIInput
+    Doc tempdoc;
+    tempdoc.SetOptions(m_doc.GetOptions());
+    Input *tempinput = new HumdrumInput(&tempdoc);
+    if (!tempinput->Import(humdrum)) {
+        delete tempinput;
+        return NULL;
+    }
+    MEIOutput meioutput(&tempdoc);
+    meioutput.SetScoreBasedMEI(true);
+    std::string meiData = meioutput.GetOutput();
+    delete tempinput;
+
+    Input *input = new MEIInput(&m_doc);
+    if (!input->ImportInPlace(meiData)) {
+        delete input;
+        return NULL;
+    }
+    return input;
+}
+#endif
+
 void Toolkit::SkipLayoutOnLoad(bool value)
 {
     m_skipLayoutOnLoad = value;
 }
 
 std::string Toolkit::GetMEI(const std::string &jsonOptions)
+{
+    std::ostringstream output;
+    if (!this->WriteMEI(jsonOptions, [&output]() -> std::ostream * { return &output; })) {
+        return "";
+    }
+    return output.str();
+}
+
+bool Toolkit::WriteMEI(const std::string &jsonOptions, const std::function<std::ostream *()> &openOutput)
 {
     bool scoreBased = true;
     bool basic = false;
@@ -851,7 +859,7 @@ std::string Toolkit::GetMEI(const std::string &jsonOptions)
 
     if (this->GetPageCount() == 0) {
         LogWarning("No data loaded");
-        return "";
+        return false;
     }
 
     int initialPageNo = (m_doc.GetDrawingPage() == NULL) ? -1 : m_doc.GetDrawingPage()->GetIdx();
@@ -860,7 +868,7 @@ std::string Toolkit::GetMEI(const std::string &jsonOptions)
     if (m_doc.HasSelection()) {
         if (!scoreBased) {
             LogError("Page-based MEI output is not possible when a selection is set.");
-            return "";
+            return false;
         }
         hadSelection = true;
         m_doc.DeactiveateSelection();
@@ -881,12 +889,17 @@ std::string Toolkit::GetMEI(const std::string &jsonOptions)
     if (!lastMeasure.empty()) meioutput.SetLastMeasure(lastMeasure);
     if (!mdiv.empty()) meioutput.SetMdiv(mdiv);
 
-    std::string output = meioutput.GetOutput();
+    // The output is opened only once the options are checked, for a file not to be truncated when nothing is written
+    bool success = false;
+    if (meioutput.CanExport()) {
+        std::ostream *output = openOutput();
+        if (output) success = meioutput.Export(*output);
+    }
 
     if (hadSelection) m_doc.ReactivateSelection(false);
 
     if (initialPageNo >= 0) m_doc.SetDrawingPage(initialPageNo);
-    return output;
+    return success;
 }
 
 std::string Toolkit::ValidatePAEFile(const std::string &filename)
@@ -909,22 +922,23 @@ std::string Toolkit::ValidatePAE(const std::string &data)
 
 bool Toolkit::SaveFile(const std::string &filename, const std::string &jsonOptions)
 {
-    std::string output = this->GetMEI(jsonOptions);
-    if (output.empty()) {
-        return false;
-    }
-
     std::ofstream outfile;
-    outfile.open(filename.c_str());
+    bool success = this->WriteMEI(jsonOptions, [&outfile, &filename]() -> std::ostream * {
+        outfile.open(filename.c_str());
+        if (!outfile.is_open()) {
+            LogError("Unable to write MEI to %s", filename.c_str());
+            return NULL;
+        }
+        return &outfile;
+    });
+    if (!outfile.is_open()) return false;
 
-    if (!outfile.is_open()) {
+    outfile.close();
+    if (success && outfile.fail()) {
         LogError("Unable to write MEI to %s", filename.c_str());
         return false;
     }
-
-    outfile << output;
-    outfile.close();
-    return true;
+    return success;
 }
 
 std::string Toolkit::GetOptions(bool defaultValues) const
@@ -1238,6 +1252,9 @@ bool Toolkit::Edit(const std::string &editorAction)
 {
     this->ResetLogBuffer();
 
+    // The document is modified and the layout has to be redone entirely
+    m_hasLayoutOptions = false;
+
     return m_editorToolkit->ParseEditorAction(editorAction);
 }
 
@@ -1248,6 +1265,8 @@ std::string Toolkit::EditInfo()
 
 std::string Toolkit::GetLog()
 {
+    const std::lock_guard<std::mutex> lock(logMutex);
+
     std::string str;
     std::vector<std::string>::iterator iter;
     for (iter = logBuffer.begin(); iter != logBuffer.end(); ++iter) {
@@ -1269,12 +1288,15 @@ void Toolkit::ResetXmlIdSeed(int seed)
 
 void Toolkit::ResetLogBuffer()
 {
+    const std::lock_guard<std::mutex> lock(logMutex);
+
     logBuffer.clear();
 }
 
 void Toolkit::RedoLayout(const std::string &jsonOptions)
 {
     bool resetCache = true;
+    bool hasResetCache = false;
 
     jsonxx::Object json;
 
@@ -1284,7 +1306,10 @@ void Toolkit::RedoLayout(const std::string &jsonOptions)
             LogWarning("Cannot parse JSON std::string. Using default options.");
         }
         else {
-            if (json.has<jsonxx::Boolean>("resetCache")) resetCache = json.get<jsonxx::Boolean>("resetCache");
+            if (json.has<jsonxx::Boolean>("resetCache")) {
+                resetCache = json.get<jsonxx::Boolean>("resetCache");
+                hasResetCache = true;
+            }
         }
     }
 
@@ -1295,10 +1320,26 @@ void Toolkit::RedoLayout(const std::string &jsonOptions)
         return;
     }
 
+    // Look at the first stage invalidated by the options changed since the previous layout
+    OptionStage stage = OptionStage::DataPreparation;
+    if (!hasResetCache && m_hasLayoutOptions) {
+        stage = m_options->GetInvalidatedStage(m_layoutOptions);
+    }
+    m_layoutOptions = *m_options;
+    m_hasLayoutOptions = true;
+
     if (m_docSelection.m_isPending) {
         m_doc.InitSelectionDoc(m_docSelection, resetCache);
     }
+    else if (m_doc.IsCastOff() && (stage == OptionStage::Output)) {
+        return;
+    }
+    else if (m_doc.CanRedoPageCastOff() && (stage >= OptionStage::VerticalLayout)) {
+        m_doc.RedoPageCastOffDoc();
+        return;
+    }
     else {
+        if (stage == OptionStage::SystemCastOff) resetCache = false;
         m_doc.UnCastOffDoc(resetCache);
     }
 
@@ -1343,6 +1384,19 @@ bool Toolkit::RenderToDeviceContext(int pageNo, DeviceContext *deviceContext)
     // Get the current system for the SVG clipping size
     m_view.SetPage(pageNo);
 
+    this->SetDeviceContextSize(deviceContext, m_view.m_currentPage);
+
+    // render the page
+    m_view.DrawCurrentPage(deviceContext, false);
+
+    return true;
+}
+
+void Toolkit::SetDeviceContextSize(DeviceContext *deviceContext, const Page *page)
+{
+    assert(deviceContext);
+    assert(page);
+
     // Adjusting page width and height according to the options
     int width = m_options->m_pageWidth.GetUnfactoredValue();
     int height = m_options->m_pageHeight.GetUnfactoredValue();
@@ -1350,12 +1404,12 @@ bool Toolkit::RenderToDeviceContext(int pageNo, DeviceContext *deviceContext)
     bool adjustHeight = m_options->m_adjustPageHeight.GetValue();
     bool adjustWidth = m_options->m_adjustPageWidth.GetValue();
 
-    if (adjustWidth || (breaks == BREAKS_none)) width = m_doc.GetAdjustedDrawingPageWidth();
-    if (adjustHeight || (breaks == BREAKS_none)) height = m_doc.GetAdjustedDrawingPageHeight();
+    if (adjustWidth || (breaks == BREAKS_none)) width = m_doc.GetAdjustedDrawingPageWidth(page);
+    if (adjustHeight || (breaks == BREAKS_none)) height = m_doc.GetAdjustedDrawingPageHeight(page);
 
     if (m_doc.GetType() == Transcription) {
-        width = m_doc.GetAdjustedDrawingPageWidth();
-        height = m_doc.GetAdjustedDrawingPageHeight();
+        width = m_doc.GetAdjustedDrawingPageWidth(page);
+        height = m_doc.GetAdjustedDrawingPageHeight(page);
     }
 
     // set dimensions
@@ -1368,59 +1422,61 @@ bool Toolkit::RenderToDeviceContext(int pageNo, DeviceContext *deviceContext)
         deviceContext->SetHeight(height);
     }
 
-    double userScale = m_view.GetPPUFactor() * m_options->m_scale.GetValue() / 100;
+    double userScale = page->GetPPUFactor() * m_options->m_scale.GetValue() / 100;
     deviceContext->SetUserScale(userScale, userScale);
 
     if (m_doc.GetType() == Facs) {
         deviceContext->SetWidth(m_doc.GetFacsimile()->GetMaxX());
         deviceContext->SetHeight(m_doc.GetFacsimile()->GetMaxY());
     }
-
-    // render the page
-    m_view.DrawCurrentPage(deviceContext, false);
-
-    return true;
 }
 
-std::string Toolkit::RenderToSVG(int pageNo, bool xmlDeclaration)
+void Toolkit::InitSvgDeviceContext(SvgDeviceContext *svg) const
 {
-    this->ResetLogBuffer();
+    assert(svg);
 
-    int initialPageNo = (m_doc.GetDrawingPage() == NULL) ? -1 : m_doc.GetDrawingPage()->GetIdx();
-    // Create the SVG object, h & w come from the system
-    // We will need to set the size of the page after having drawn it depending on the options
-    SvgDeviceContext svg;
-    svg.SetResources(&m_doc.GetResources());
+    svg->SetResources(&m_doc.GetResources());
 
     int indent = (m_options->m_outputIndentTab.GetValue()) ? -1 : m_options->m_outputIndent.GetValue();
-    svg.SetIndent(indent);
+    svg->SetIndent(indent);
 
     if (m_options->m_mmOutput.GetValue()) {
-        svg.SetMMOutput(true);
+        svg->SetMMOutput(true);
     }
 
     if (m_doc.GetType() == Facs) {
-        svg.SetFacsimile(true);
+        svg->SetFacsimile(true);
     }
 
     // set the option to use viewbox on svg root
     if (m_options->m_svgBoundingBoxes.GetValue()) {
-        svg.SetSvgBoundingBoxes(true);
+        svg->SetSvgBoundingBoxes(true);
     }
 
     // set the additional CSS if any
     if (!m_options->m_svgCss.GetValue().empty()) {
-        svg.SetCss(m_options->m_svgCss.GetValue());
+        svg->SetCss(m_options->m_svgCss.GetValue());
     }
 
     if (m_options->m_svgViewBox.GetValue()) {
-        svg.SetSvgViewBox(true);
+        svg->SetSvgViewBox(true);
     }
 
-    svg.SetHtml5(m_options->m_svgHtml5.GetValue());
-    svg.SetFormatRaw(m_options->m_svgFormatRaw.GetValue());
-    svg.SetRemoveXlink(m_options->m_svgRemoveXlink.GetValue());
-    svg.SetAdditionalAttributes(m_options->m_svgAdditionalAttribute.GetValue());
+    svg->SetHtml5(m_options->m_svgHtml5.GetValue());
+    svg->SetFormatRaw(m_options->m_svgFormatRaw.GetValue());
+    svg->SetRemoveXlink(m_options->m_svgRemoveXlink.GetValue());
+    svg->SetAdditionalAttributes(m_options->m_svgAdditionalAttribute.GetValue());
+}
+
+std::string Toolkit::RenderToSVG(int pageNo, bool xmlDeclaration)
+{
+    this->ResetLogBuffer();
+
+    int initialPageNo = (m_doc.GetDrawingPage() == NULL) ? -1 : m_doc.GetDrawingPage()->GetIdx();
+    // Create the SVG object, h & w come from the system
+    // We will need to set the size of the page after having drawn it depending on the options
+    SvgDeviceContext svg;
+    this->InitSvgDeviceContext(&svg);
 
     // render the page
     this->RenderToDeviceContext(pageNo, &svg);
@@ -1430,6 +1486,128 @@ std::string Toolkit::RenderToSVG(int pageNo, bool xmlDeclaration)
     return out_str;
 }
 
+std::vector<std::string> Toolkit::RenderPagesToSVG(int firstPageNo, int lastPageNo, bool xmlDeclaration)
+{
+    this->ResetLogBuffer();
+
+    if (lastPageNo == 0) lastPageNo = this->GetPageCount();
+    if ((firstPageNo < 1) || (firstPageNo > lastPageNo) || (lastPageNo > this->GetPageCount())) {
+        LogWarning("Page range %d-%d does not exist", firstPageNo, lastPageNo);
+        return {};
+    }
+
+    int initialPageNo = (m_doc.GetDrawingPage() == NULL) ? -1 : m_doc.GetDrawingPage()->GetIdx();
+    std::vector<std::string> output(lastPageNo - firstPageNo + 1);
+
+    // Lay out the pages first since this cannot be done concurrently. We also check that they all have the same
+    // drawing dimensions because the drawing page of the doc is left unchanged when drawing concurrently
+    bool sameDimensions = true;
+    std::vector<int> dimensions;
+    for (int pageNo = firstPageNo; pageNo <= lastPageNo; ++pageNo) {
+        m_view.SetPage(pageNo - 1);
+        std::vector<int> pageDimensions = { m_doc.m_drawingPageWidth, m_doc.m_drawingPageHeight,
+            m_doc.m_drawingPageMarginLeft, m_doc.m_drawingPageMarginRight, m_doc.m_drawingPageMarginTop,
+            m_doc.m_drawingPageMarginBottom };
+        if (dimensions.empty()) {
+            dimensions = pageDimensions;
+        }
+        else if (pageDimensions != dimensions) {
+            sameDimensions = false;
+        }
+    }
+
+    const int threadCount = m_options->m_renderThreads.GetValue();
+    if ((threadCount > 1) && !sameDimensions) {
+        LogWarning("The pages do not have the same dimensions and cannot be rendered concurrently");
+    }
+
+    // Each page is rendered starting with the default text font and with its own seed for the IDs generated while
+    // drawing for the output not to depend on the thread. The generator of the calling thread is restored afterwards.
+    std::vector<unsigned int> seeds(output.size());
+    for (unsigned int &seed : seeds) seed = Object::GenerateRandSeed();
+    const std::mt19937 generator = Object::GetIDGenerator();
+    if ((threadCount > 1) && sameDimensions && (output.size() > 1)) {
+        // Pages drawn concurrently select text fonts in a copy of the resources, which shares the loaded fonts
+        std::mutex sharedDrawingMutex;
+        RunInParallel((int)output.size(), threadCount, [&](int i) {
+            Resources resources = m_doc.GetResources();
+            View view;
+            view.SetDoc(&m_doc);
+            view.SetConcurrentPage(firstPageNo - 1 + i, &sharedDrawingMutex);
+            Object::SeedID(seeds.at(i));
+            SvgDeviceContext svg;
+            this->InitSvgDeviceContext(&svg);
+            svg.SetResources(&resources);
+            this->SetDeviceContextSize(&svg, view.m_currentPage);
+            resources.SelectTextFont(FONTWEIGHT_NONE, FONTSTYLE_NONE);
+            view.DrawCurrentPage(&svg, false);
+            output.at(i) = svg.GetStringSVG(xmlDeclaration);
+        });
+    }
+    else {
+        const Resources &resources = m_doc.GetResources();
+        for (int i = 0; i < (int)output.size(); ++i) {
+            Object::SeedID(seeds.at(i));
+            SvgDeviceContext svg;
+            this->InitSvgDeviceContext(&svg);
+            resources.SelectTextFont(FONTWEIGHT_NONE, FONTSTYLE_NONE);
+            this->RenderToDeviceContext(firstPageNo + i, &svg);
+            output.at(i) = svg.GetStringSVG(xmlDeclaration);
+        }
+    }
+    Object::SetIDGenerator(generator);
+
+    if (initialPageNo >= 0) m_doc.SetDrawingPage(initialPageNo);
+    return output;
+}
+
+std::vector<std::string> Toolkit::RenderRecordsToSVG(const std::vector<std::string> &records, bool xmlDeclaration)
+{
+    this->ResetLogBuffer();
+
+    std::vector<std::string> output(records.size());
+    if (records.empty()) return output;
+
+    const int threadCount = std::min(m_options->m_renderThreads.GetValue(), (int)records.size());
+
+    // Each thread gets one of the record toolkits, with the same resources as the toolkit itself. They keep their
+    // document from one record to the next but not the options, which embedded Humdrum options can change.
+    while ((int)m_recordToolkits.size() < threadCount) m_recordToolkits.push_back(new Toolkit(false));
+    for (int i = 0; i < threadCount; ++i) {
+        Toolkit *toolkit = m_recordToolkits.at(i);
+        // The resources share the loaded fonts and copying them does not load the fonts again
+        toolkit->m_doc.GetResourcesForModification() = m_doc.GetResources();
+        toolkit->m_inputFrom = m_inputFrom;
+    }
+
+    // Each record is loaded with its own seed for the IDs not to depend on the thread rendering it, nor on the
+    // records being given in one call or in several
+    std::vector<unsigned int> seeds(records.size());
+    for (unsigned int &seed : seeds) seed = Object::GenerateRandSeed();
+
+    const std::mt19937 generator = Object::GetIDGenerator();
+    std::atomic<int> next(0);
+    RunInParallel(threadCount, threadCount, [&](int t) {
+        Toolkit *toolkit = m_recordToolkits.at(t);
+        for (int i = next++; i < (int)records.size(); i = next++) {
+            toolkit->m_doc.SetOptions(m_options);
+            Object::SeedID(seeds.at(i));
+            if (!toolkit->LoadData(records.at(i)) || (toolkit->GetPageCount() < 1)) {
+                LogWarning("Record %d could not be loaded", i + 1);
+                continue;
+            }
+            SvgDeviceContext svg;
+            toolkit->InitSvgDeviceContext(&svg);
+            toolkit->m_doc.GetResources().SelectTextFont(FONTWEIGHT_NONE, FONTSTYLE_NONE);
+            toolkit->RenderToDeviceContext(1, &svg);
+            output.at(i) = svg.GetStringSVG(xmlDeclaration);
+        }
+    });
+    Object::SetIDGenerator(generator);
+
+    return output;
+}
+
 bool Toolkit::RenderToSVGFile(const std::string &filename, int pageNo)
 {
     this->ResetLogBuffer();
@@ -1564,43 +1742,39 @@ std::string Toolkit::GetElementsAtTime(int millisec)
         m_doc.CalculateTimemap();
     }
 
-    MeasureOnsetOffsetComparison matchMeasureTime(millisec);
-    Measure *measure = dynamic_cast<Measure *>(m_doc.FindDescendantByComparison(&matchMeasureTime));
+    // Look for the measure and the elements in the time index built with the timemap
+    std::string measureID;
+    std::vector<const TimeIndexElement *> elements;
+    if (!m_doc.GetTimeIndex().FindElementsAtTime(millisec, measureID, elements)) {
+        return o.json();
+    }
+
+    Measure *measure = dynamic_cast<Measure *>(m_doc.FindDescendantByID(measureID));
 
     if (!measure) {
         return o.json();
     }
 
-    int repeat = measure->EnclosesTime(millisec);
-    int measureTimeOffset = measure->GetRealTimeOffsetMilliseconds(repeat);
-
     // Get the pageNo from the first note (if any)
     int pageNo = -1;
     Page *page = dynamic_cast<Page *>(measure->GetFirstAncestor(PAGE));
     if (page) pageNo = page->GetIdx() + 1;
 
-    NoteOrRestOnsetOffsetComparison matchTime(millisec - measureTimeOffset);
-    ListOfObjects notesOrRests;
-    ListOfObjects chords;
-
-    measure->FindAllDescendantsByComparison(&notesOrRests, &matchTime);
+    std::list<std::string> chords;
 
     // Fill the JSON object
-    for (auto const item : notesOrRests) {
-        if (item->Is(NOTE)) {
-            noteArray << item->GetID();
-            Note *note = vrv_cast<Note *>(item);
-            assert(note);
-            Chord *chord = note->IsChordTone();
-            if (chord) chords.push_back(chord);
+    for (auto const element : elements) {
+        if (element->isRest) {
+            restArray << element->id;
         }
-        else if (item->Is(REST)) {
-            restArray << item->GetID();
+        else {
+            noteArray << element->id;
+            if (!element->chordID.empty()) chords.push_back(element->chordID);
         }
     }
     chords.unique();
-    for (auto const item : chords) {
-        chordArray << item->GetID();
+    for (auto const &chord : chords) {
+        chordArray << chord;
     }
 
     o << "notes" << noteArray;
@@ -1612,6 +1786,24 @@ std::string Toolkit::GetElementsAtTime(int millisec)
     return o.json();
 }
 
+std::string Toolkit::GetTimeEventsBetween(int fromMillisec, int toMillisec)
+{
+    this->ResetLogBuffer();
+
+    // Here we need to check that the midi timemap is done
+    if (!m_doc.HasTimemap()) {
+        // generate MIDI timemap before progressing
+        m_doc.CalculateTimemap();
+    }
+
+    std::map<double, TimemapEntry> entries;
+    m_doc.GetTimeIndex().FindEventsBetween(fromMillisec, toMillisec, entries);
+
+    std::string output;
+    Timemap::EntriesToJson(entries, output, true, true);
+    return output;
+}
+
 bool Toolkit::RenderToMIDIFile(const std::string &filename)
 {
     this->ResetLogBuffer();
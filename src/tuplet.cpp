@@ -132,9 +132,11 @@ void Tuplet::AddChild(Object *child)
     // for the drawing order in the SVG output
     if (child->Is({ TUPLET_BRACKET, TUPLET_NUM })) {
         children.insert(children.begin(), child);
+        this->UpdateChildIndices();
     }
     else {
         children.push_back(child);
+        this->UpdateChildIndices((int)children.size() - 1);
     }
 
     Modify();
@@ -326,11 +328,11 @@ void Tuplet::AdjustTupletNumY(const Doc *doc, const Staff *staff)
     tupletNum->SetDrawingYRel(yRel);
 }
 
-void Tuplet::FilterList(ListOfConstObjects &childList) const
+void Tuplet::FilterList(ArrayOfConstObjects &childList) const
 {
     // We want to keep only notes and rests
     // Eventually, we also need to filter out grace notes properly (e.g., with sub-beams)
-    ListOfConstObjects::iterator iter = childList.begin();
+    ArrayOfConstObjects::iterator iter = childList.begin();
 
     while (iter != childList.end()) {
         if (!(*iter)->IsLayerElement() || !(*iter)->HasInterface(INTERFACE_DURATION)) {
@@ -424,7 +426,7 @@ void Tuplet::CalcDrawingBracketAndNumPos(bool tupletNumHead)
         return;
     }
 
-    const ListOfObjects &tupletChildren = this->GetList(this);
+    const ArrayOfObjects &tupletChildren = this->GetList(this);
 
     // There are unbeamed notes of two different beams
     // treat all the notes as unbeamed
@@ -432,7 +434,7 @@ void Tuplet::CalcDrawingBracketAndNumPos(bool tupletNumHead)
 
     // The first step is to calculate all the stem directions
     // cycle into the elements and count the up and down dirs
-    ListOfObjects::const_iterator iter = tupletChildren.begin();
+    ArrayOfObjects::const_iterator iter = tupletChildren.begin();
     while (iter != tupletChildren.end()) {
         if ((*iter)->Is(CHORD)) {
             Chord *currentChord = vrv_cast<Chord *>(*iter);
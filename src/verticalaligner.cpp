@@ -80,6 +80,7 @@ StaffAlignment *SystemAligner::GetStaffAlignment(int idx, Staff *staff, Doc *doc
     if (m_bottomAlignment) {
         children.push_back(m_bottomAlignment);
     }
+    this->UpdateChildIndices();
 
     return alignment;
 }
@@ -171,7 +172,7 @@ void SystemAligner::SetSpacing(const ScoreDef *scoreDef)
 
     m_spacingTypes.clear();
 
-    const ListOfConstObjects &childList = scoreDef->GetList(scoreDef);
+    const ArrayOfConstObjects &childList = scoreDef->GetList(scoreDef);
     for (auto iter = childList.begin(); iter != childList.end(); ++iter) {
         // It should be staffDef only, but double check.
         if (!(*iter)->Is(STAFFDEF)) continue;
@@ -736,9 +737,10 @@ int StaffAlignment::AdjustFloatingPositioners(FunctorParams *functorParams)
     const bool verseCollapse = params->m_doc->GetOptions()->m_lyricVerseCollapse.GetValue();
     if (params->m_classId == SYL) {
         if (this->GetVerseCount(verseCollapse) > 0) {
-            FontInfo *lyricFont = params->m_doc->GetDrawingLyricFont(m_staff->m_drawingStaffSize);
-            int descender = params->m_doc->GetTextGlyphDescender(L'q', lyricFont, false);
-            int height = params->m_doc->GetTextGlyphHeight(L'I', lyricFont, false);
+            FontInfo lyricFont;
+            params->m_doc->GetDrawingLyricFont(&lyricFont, m_staff->m_drawingStaffSize);
+            int descender = params->m_doc->GetTextGlyphDescender(L'q', &lyricFont, false);
+            int height = params->m_doc->GetTextGlyphHeight(L'I', &lyricFont, false);
             int margin = params->m_doc->GetBottomMargin(SYL) * drawingUnit;
             int minMargin = std::max((int)(params->m_doc->GetOptions()->m_lyricTopMinMargin.GetValue() * drawingUnit),
                 this->GetOverflowBelow());
@@ -1037,7 +1039,7 @@ int StaffAlignment::AdjustSlurs(FunctorParams *functorParams)
     }
 
     // Detection of inner slurs
-    std::map<FloatingCurvePositioner *, ArrayOfFloatingCurvePositioners> innerCurveMap;
+    std::vector<std::pair<FloatingCurvePositioner *, ArrayOfFloatingCurvePositioners>> innerCurveMap;
     for (size_t i = 0; i < positioners.size(); ++i) {
         Slur *firstSlur = vrv_cast<Slur *>(positioners[i]->GetObject());
         ArrayOfFloatingCurvePositioners innerCurves;
@@ -1076,7 +1078,7 @@ int StaffAlignment::AdjustSlurs(FunctorParams *functorParams)
             }
         }
         if (!innerCurves.empty()) {
-            innerCurveMap[positioners[i]] = innerCurves;
+            innerCurveMap.push_back({ positioners[i], innerCurves });
         }
     }
 
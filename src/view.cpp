@@ -16,6 +16,7 @@
 
 #include "doc.h"
 #include "page.h"
+#include "pages.h"
 #include "vrv.h"
 
 namespace vrv {
@@ -30,6 +31,7 @@ View::View()
     m_options = NULL;
     m_pageIdx = 0;
     m_slurHandling = SlurHandling::Initialize;
+    m_sharedDrawingMutex = NULL;
 
     m_currentColour = AxNONE;
     m_currentElement = NULL;
@@ -60,6 +62,7 @@ void View::SetDoc(Doc *doc)
     m_currentSystem = NULL;
     m_currentPage = NULL;
     m_pageIdx = 0;
+    m_sharedDrawingMutex = NULL;
 }
 
 void View::SetPage(int pageIdx, bool doLayout)
@@ -69,6 +72,7 @@ void View::SetPage(int pageIdx, bool doLayout)
 
     m_pageIdx = pageIdx;
     m_currentPage = m_doc->SetDrawingPage(pageIdx);
+    m_sharedDrawingMutex = NULL;
 
     if (doLayout) {
         m_doc->ScoreDefSetCurrentDoc();
@@ -90,6 +94,23 @@ void View::SetPage(int pageIdx, bool doLayout)
     DoRefresh();
 }
 
+void View::SetConcurrentPage(int pageIdx, std::mutex *sharedDrawingMutex)
+{
+    assert(m_doc);
+    assert(m_doc->HasPage(pageIdx));
+    assert(sharedDrawingMutex);
+
+    m_pageIdx = pageIdx;
+    m_currentPage = vrv_cast<Page *>(m_doc->GetPages()->GetChild(pageIdx));
+    m_sharedDrawingMutex = sharedDrawingMutex;
+
+    m_currentElement = NULL;
+    m_currentLayer = NULL;
+    m_currentMeasure = NULL;
+    m_currentStaff = NULL;
+    m_currentSystem = NULL;
+}
+
 bool View::HasNext(bool forward)
 {
     if (forward) return (m_doc && (m_doc->HasPage(m_pageIdx + 1)));
@@ -150,6 +171,27 @@ Point View::ToLogical(Point p)
     return Point(ToLogicalX(p.x), ToLogicalY(p.y));
 }
 
+FontInfo *View::GetDrawingSmuflFont(int staffSize, bool graceSize)
+{
+    assert(m_doc);
+
+    return m_doc->GetDrawingSmuflFont(&m_drawingSmuflFont, staffSize, graceSize);
+}
+
+FontInfo *View::GetDrawingLyricFont(int staffSize)
+{
+    assert(m_doc);
+
+    return m_doc->GetDrawingLyricFont(&m_drawingLyricFont, staffSize);
+}
+
+FontInfo *View::GetFingeringFont(int staffSize)
+{
+    assert(m_doc);
+
+    return m_doc->GetFingeringFont(&m_fingeringFont, staffSize);
+}
+
 std::wstring View::IntToTupletFigures(unsigned short number)
 {
     return IntToSmuflFigures(number, 0xE880);
@@ -69,6 +69,12 @@ void View::DrawControlElement(DeviceContext *dc, ControlElement *element, Measur
     assert(measure);
     assert(element);
 
+    // Elements with an extender can also be drawn concurrently from another page they span over
+    std::unique_lock<std::mutex> lock;
+    if (m_sharedDrawingMutex && element->HasInterface(INTERFACE_TIME_SPANNING)) {
+        lock = std::unique_lock<std::mutex>(*m_sharedDrawingMutex);
+    }
+
     // For dir, dynam, fermata, and harm, we do not consider the @tstamp2 for rendering
     if (element->Is(
             { BEAMSPAN, BRACKETSPAN, FIGURE, GLISS, HAIRPIN, LV, OCTAVE, PHRASE, PITCHINFLECTION, SLUR, TIE })) {
@@ -191,6 +197,10 @@ void View::DrawTimeSpanningElement(DeviceContext *dc, Object *element, System *s
     System *parentSystem1 = dynamic_cast<System *>(start->GetFirstAncestor(SYSTEM));
     System *parentSystem2 = dynamic_cast<System *>(end->GetFirstAncestor(SYSTEM));
 
+    // The element can also be drawn concurrently from another page the element spans over
+    std::unique_lock<std::mutex> lock;
+    if (m_sharedDrawingMutex) lock = std::unique_lock<std::mutex>(*m_sharedDrawingMutex);
+
     int x1, x2;
     Object *objectX = NULL;
     Measure *measure = NULL;
@@ -755,7 +765,7 @@ void View::DrawOctave(
     std::wstring str;
     str.push_back(code);
 
-    dc->SetFont(m_doc->GetDrawingSmuflFont(staff->m_drawingStaffSize, false));
+    dc->SetFont(this->GetDrawingSmuflFont(staff->m_drawingStaffSize, false));
     TextExtend extend;
     dc->GetSmuflTextExtent(str, &extend);
     const int yCode = (disPlace == STAFFREL_basic_above) ? y1 - extend.m_height : y1;
@@ -1179,7 +1189,7 @@ void View::DrawFConnector(DeviceContext *dc, F *f, int x1, int x2, Staff *staff,
     assert(f->GetStart() && f->GetEnd());
     if (!f->GetStart() || !f->GetEnd()) return;
 
-    const int y = this->GetFYRel(f, staff);
+    const int y = this->GetFYRel(dc, f, staff);
     TextExtend extend;
 
     // The both correspond to the current system, which means no system break in-between (simple case)
@@ -1230,7 +1240,7 @@ void View::DrawSylConnector(
     assert(syl->GetStart() && syl->GetEnd());
     if (!syl->GetStart() || !syl->GetEnd()) return;
 
-    const int y = staff->GetDrawingY() + this->GetSylYRel(syl->m_drawingVerse, staff);
+    const int y = staff->GetDrawingY() + this->GetSylYRel(dc, syl->m_drawingVerse, staff);
 
     // Invalid bounding boxes might occur for empty syllables without text child
     if (!syl->HasContentHorizontalBB()) return;
@@ -1501,7 +1511,7 @@ void View::DrawBreath(DeviceContext *dc, Breath *breath, Measure *measure, Syste
         }
         int y = breath->GetDrawingY();
 
-        dc->SetFont(m_doc->GetDrawingSmuflFont((*staffIter)->m_drawingStaffSize, false));
+        dc->SetFont(this->GetDrawingSmuflFont((*staffIter)->m_drawingStaffSize, false));
         this->DrawSmuflString(dc, x, y, str, alignment, (*staffIter)->m_drawingStaffSize);
         dc->ResetFont();
     }
@@ -1547,7 +1557,7 @@ void View::DrawDir(DeviceContext *dc, Dir *dir, Measure *measure, System *system
 
         params.m_enclosedRend.clear();
         params.m_y = dir->GetDrawingY();
-        params.m_pointSize = m_doc->GetDrawingLyricFont((*staffIter)->m_drawingStaffSize)->GetPointSize();
+        params.m_pointSize = this->GetDrawingLyricFont((*staffIter)->m_drawingStaffSize)->GetPointSize();
 
         int xAdjust = 0;
         const bool isBetweenStaves = (dir->GetPlace() == STAFFREL_between)
@@ -1564,9 +1574,9 @@ void View::DrawDir(DeviceContext *dc, Dir *dir, Measure *measure, System *system
 
         if ((dir->GetPlace() == STAFFREL_between) || (dir->GetPlace() == STAFFREL_within)) {
             if (lineCount > 1) {
-                params.m_y += (m_doc->GetTextLineHeight(&dirTxt, false) * (lineCount - 1) / 2);
+                params.m_y += (m_doc->GetTextLineHeight(&dirTxt, false, dc->GetResources()) * (lineCount - 1) / 2);
             }
-            params.m_y -= m_doc->GetTextXHeight(&dirTxt, false) / 2;
+            params.m_y -= m_doc->GetTextXHeight(&dirTxt, false, dc->GetResources()) / 2;
         }
 
         dc->SetBrush(m_currentColour, AxSOLID);
@@ -1632,7 +1642,7 @@ void View::DrawDynam(DeviceContext *dc, Dynam *dynam, Measure *measure, System *
 
         params.m_enclosedRend.clear();
         params.m_y = dynam->GetDrawingY();
-        params.m_pointSize = m_doc->GetDrawingLyricFont((*staffIter)->m_drawingStaffSize)->GetPointSize();
+        params.m_pointSize = this->GetDrawingLyricFont((*staffIter)->m_drawingStaffSize)->GetPointSize();
         if (dynam->HasEnclose()) {
             params.m_textEnclose = dynam->GetEnclose();
         }
@@ -1641,9 +1651,9 @@ void View::DrawDynam(DeviceContext *dc, Dynam *dynam, Measure *measure, System *
 
         if (dynam->GetPlace() == STAFFREL_between) {
             if (lineCount > 1) {
-                params.m_y += (m_doc->GetTextLineHeight(&dynamTxt, false) * (lineCount - 1) / 2);
+                params.m_y += (m_doc->GetTextLineHeight(&dynamTxt, false, dc->GetResources()) * (lineCount - 1) / 2);
             }
-            params.m_y -= m_doc->GetTextXHeight(&dynamTxt, false) / 2;
+            params.m_y -= m_doc->GetTextXHeight(&dynamTxt, false, dc->GetResources()) / 2;
         }
 
         // If the dynamic is a symbol (pp, mf, etc.) draw it as one SMuFL string. This will not take into account
@@ -1675,7 +1685,7 @@ void View::DrawDynamSymbolOnly(DeviceContext *dc, Staff *staff, Dynam *dynam, co
     assert(staff);
     assert(dynam);
 
-    dc->SetFont(m_doc->GetDrawingSmuflFont(staff->m_drawingStaffSize, false));
+    dc->SetFont(this->GetDrawingSmuflFont(staff->m_drawingStaffSize, false));
 
     wchar_t enclosingFront, enclosingBack;
     std::tie(enclosingFront, enclosingBack) = dynam->GetEnclosingGlyphs();
@@ -1725,11 +1735,11 @@ void View::DrawFb(DeviceContext *dc, Staff *staff, Fb *fb, TextDrawingParams &pa
 
     dc->StartGraphic(fb, "", fb->GetID());
 
-    FontInfo *fontDim = m_doc->GetDrawingLyricFont(staff->m_drawingStaffSize);
-    const int lineHeight = m_doc->GetTextLineHeight(fontDim, false);
+    FontInfo *fontDim = this->GetDrawingLyricFont(staff->m_drawingStaffSize);
+    const int lineHeight = m_doc->GetTextLineHeight(fontDim, false, dc->GetResources());
     const int startX = params.m_x;
 
-    fontDim->SetPointSize(m_doc->GetDrawingLyricFont((staff)->m_drawingStaffSize)->GetPointSize());
+    fontDim->SetPointSize(this->GetDrawingLyricFont((staff)->m_drawingStaffSize)->GetPointSize());
 
     dc->SetBrush(m_currentColour, AxSOLID);
     dc->SetFont(fontDim);
@@ -1810,7 +1820,7 @@ void View::DrawFermata(DeviceContext *dc, Fermata *fermata, Measure *measure, Sy
         }
 
         // Draw glyph including possible enclosing brackets
-        dc->SetFont(m_doc->GetDrawingSmuflFont(staff->m_drawingStaffSize, drawingCueSize));
+        dc->SetFont(this->GetDrawingSmuflFont(staff->m_drawingStaffSize, drawingCueSize));
 
         if (enclosingFront) {
             const int xCorrEncl = xCorr + m_doc->GetDrawingUnit(staff->m_drawingStaffSize) / 3
@@ -1864,7 +1874,7 @@ void View::DrawFing(DeviceContext *dc, Fing *fing, Measure *measure, System *sys
 
         params.m_enclosedRend.clear();
         params.m_y = fing->GetDrawingY();
-        params.m_pointSize = m_doc->GetFingeringFont((*staffIter)->m_drawingStaffSize)->GetPointSize();
+        params.m_pointSize = this->GetFingeringFont((*staffIter)->m_drawingStaffSize)->GetPointSize();
 
         fingTxt.SetPointSize(params.m_pointSize);
 
@@ -2052,7 +2062,7 @@ void View::DrawHarm(DeviceContext *dc, Harm *harm, Measure *measure, System *sys
             this->DrawFb(dc, *staffIter, dynamic_cast<Fb *>(harm->GetFirst()), params);
         }
         else {
-            params.m_pointSize = m_doc->GetDrawingLyricFont((*staffIter)->m_drawingStaffSize)->GetPointSize();
+            params.m_pointSize = this->GetDrawingLyricFont((*staffIter)->m_drawingStaffSize)->GetPointSize();
 
             harmTxt.SetPointSize(params.m_pointSize);
 
@@ -2106,7 +2116,7 @@ void View::DrawMordent(DeviceContext *dc, Mordent *mordent, Measure *measure, Sy
             wchar_t accid = Accid::GetAccidGlyph(mordent->GetAccidlower());
             std::wstring accidStr;
             accidStr.push_back(accid);
-            dc->SetFont(m_doc->GetDrawingSmuflFont((*staffIter)->m_drawingStaffSize, false));
+            dc->SetFont(this->GetDrawingSmuflFont((*staffIter)->m_drawingStaffSize, false));
             this->DrawSmuflString(
                 dc, x, y, accidStr, HORIZONTALALIGNMENT_center, (*staffIter)->m_drawingStaffSize / 2, false);
             // Adjust the y position
@@ -2138,7 +2148,7 @@ void View::DrawMordent(DeviceContext *dc, Mordent *mordent, Measure *measure, Sy
             wchar_t accid = Accid::GetAccidGlyph(mordent->GetAccidupper());
             std::wstring accidStr;
             accidStr.push_back(accid);
-            dc->SetFont(m_doc->GetDrawingSmuflFont((*staffIter)->m_drawingStaffSize, false));
+            dc->SetFont(this->GetDrawingSmuflFont((*staffIter)->m_drawingStaffSize, false));
             this->DrawSmuflString(
                 dc, x, y, accidStr, HORIZONTALALIGNMENT_center, (*staffIter)->m_drawingStaffSize / 2, false);
             // Adjust the y position
@@ -2169,7 +2179,7 @@ void View::DrawMordent(DeviceContext *dc, Mordent *mordent, Measure *measure, Sy
         // Adjust the x position
         int drawingX = x - (1 + xShift) * m_doc->GetGlyphWidth(code, (*staffIter)->m_drawingStaffSize, false) / 2;
 
-        dc->SetFont(m_doc->GetDrawingSmuflFont((*staffIter)->m_drawingStaffSize, false));
+        dc->SetFont(this->GetDrawingSmuflFont((*staffIter)->m_drawingStaffSize, false));
         this->DrawSmuflString(dc, drawingX, y, str, HORIZONTALALIGNMENT_left, (*staffIter)->m_drawingStaffSize);
         dc->ResetFont();
     }
@@ -2238,7 +2248,7 @@ void View::DrawPedal(DeviceContext *dc, Pedal *pedal, Measure *measure, System *
             // Basic method that use bounding box
             const int y = pedal->GetDrawingY();
 
-            dc->SetFont(m_doc->GetDrawingSmuflFont((*staffIter)->m_drawingStaffSize, false));
+            dc->SetFont(this->GetDrawingSmuflFont((*staffIter)->m_drawingStaffSize, false));
             this->DrawSmuflString(dc, x, y, str, alignment, (*staffIter)->m_drawingStaffSize);
             dc->ResetFont();
         }
@@ -2300,7 +2310,7 @@ void View::DrawReh(DeviceContext *dc, Reh *reh, Measure *measure, System *system
 
         params.m_enclosedRend.clear();
         params.m_y = reh->GetDrawingY() + 3 * m_doc->GetDrawingUnit((*staffIter)->m_drawingStaffSize);
-        params.m_pointSize = m_doc->GetDrawingLyricFont((*staffIter)->m_drawingStaffSize)->GetPointSize();
+        params.m_pointSize = this->GetDrawingLyricFont((*staffIter)->m_drawingStaffSize)->GetPointSize();
 
         rehTxt.SetPointSize(params.m_pointSize);
 
@@ -2355,15 +2365,15 @@ void View::DrawTempo(DeviceContext *dc, Tempo *tempo, Measure *measure, System *
         params.m_x = tempo->GetDrawingXRelativeToStaff((*staffIter)->GetN());
         params.m_enclosedRend.clear();
         params.m_y = tempo->GetDrawingY();
-        params.m_pointSize = m_doc->GetDrawingLyricFont((*staffIter)->m_drawingStaffSize)->GetPointSize();
+        params.m_pointSize = this->GetDrawingLyricFont((*staffIter)->m_drawingStaffSize)->GetPointSize();
 
         tempoTxt.SetPointSize(params.m_pointSize);
 
         if (tempo->GetPlace() == STAFFREL_between) {
             if (lineCount > 1) {
-                params.m_y += (m_doc->GetTextLineHeight(&tempoTxt, false) * (lineCount - 1) / 2);
+                params.m_y += (m_doc->GetTextLineHeight(&tempoTxt, false, dc->GetResources()) * (lineCount - 1) / 2);
             }
-            params.m_y -= m_doc->GetTextXHeight(&tempoTxt, false) / 2;
+            params.m_y -= m_doc->GetTextXHeight(&tempoTxt, false, dc->GetResources()) / 2;
         }
 
         dc->SetBrush(m_currentColour, AxSOLID);
@@ -2429,7 +2439,7 @@ void View::DrawTrill(DeviceContext *dc, Trill *trill, Measure *measure, System *
             wchar_t accid = Accid::GetAccidGlyph(trill->GetAccidlower());
             std::wstring accidStr;
             accidStr.push_back(accid);
-            dc->SetFont(m_doc->GetDrawingSmuflFont((*staffIter)->m_drawingStaffSize, false));
+            dc->SetFont(this->GetDrawingSmuflFont((*staffIter)->m_drawingStaffSize, false));
             int accidY = y - m_doc->GetGlyphHeight(accid, (*staffIter)->m_drawingStaffSize, true) / 2;
             this->DrawSmuflString(dc, x + accidXShift, accidY, accidStr, HORIZONTALALIGNMENT_center,
                 (*staffIter)->m_drawingStaffSize / 2, false);
@@ -2442,13 +2452,13 @@ void View::DrawTrill(DeviceContext *dc, Trill *trill, Measure *measure, System *
             wchar_t accid = Accid::GetAccidGlyph(trill->GetAccidupper());
             std::wstring accidStr;
             accidStr.push_back(accid);
-            dc->SetFont(m_doc->GetDrawingSmuflFont((*staffIter)->m_drawingStaffSize, false));
+            dc->SetFont(this->GetDrawingSmuflFont((*staffIter)->m_drawingStaffSize, false));
             int accidY = y + trillHeight * 1.5;
             this->DrawSmuflString(dc, x + accidXShift, accidY, accidStr, HORIZONTALALIGNMENT_center,
                 (*staffIter)->m_drawingStaffSize / 2, false);
         }
 
-        dc->SetFont(m_doc->GetDrawingSmuflFont((*staffIter)->m_drawingStaffSize, false));
+        dc->SetFont(this->GetDrawingSmuflFont((*staffIter)->m_drawingStaffSize, false));
         this->DrawSmuflString(dc, x, y, str, alignment, (*staffIter)->m_drawingStaffSize);
         dc->ResetFont();
     }
@@ -2501,7 +2511,7 @@ void View::DrawTurn(DeviceContext *dc, Turn *turn, Measure *measure, System *sys
         int y = turn->GetDrawingY();
 
         const int shift = m_doc->GetGlyphHeight(code, (*staffIter)->m_drawingStaffSize, false);
-        dc->SetFont(m_doc->GetDrawingSmuflFont((*staffIter)->m_drawingStaffSize, false));
+        dc->SetFont(this->GetDrawingSmuflFont((*staffIter)->m_drawingStaffSize, false));
         if (turn->HasAccidupper()) {
             int accidXShift = (alignment == HORIZONTALALIGNMENT_center)
                 ? 0
@@ -2602,6 +2612,10 @@ void View::DrawEnding(DeviceContext *dc, Ending *ending, System *system)
     // in non debug mode
     if (!parentSystem1 || !parentSystem2) return;
 
+    // The ending can also be drawn concurrently from another page the ending spans over
+    std::unique_lock<std::mutex> lock;
+    if (m_sharedDrawingMutex) lock = std::unique_lock<std::mutex>(*m_sharedDrawingMutex);
+
     int x1, x2;
     Object *objectX;
     Measure *measure = NULL;
@@ -2692,7 +2706,7 @@ void View::DrawEnding(DeviceContext *dc, Ending *ending, System *system)
 
         dc->StartCustomGraphic("voltaBracket");
 
-        FontInfo currentFont = *m_doc->GetDrawingLyricFont((*staffIter)->m_drawingStaffSize);
+        FontInfo currentFont = *this->GetDrawingLyricFont((*staffIter)->m_drawingStaffSize);
         // currentFont.SetWeight(FONTWEIGHT_bold);
         // currentFont.SetPointSize(currentFont.GetPointSize() * 2 / 3);
         dc->SetFont(&currentFont);
@@ -2709,7 +2723,7 @@ void View::DrawEnding(DeviceContext *dc, Ending *ending, System *system)
             if ((spanningType == SPANNING_END) || (spanningType == SPANNING_MIDDLE)) strStream << ")";
 
             Text text;
-            text.SetParent(ending);
+            text.SetTemporaryParent(ending);
             text.SetText(UTF8to16(strStream.str()));
 
             int textX = x1;
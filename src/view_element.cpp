@@ -287,7 +287,7 @@ void View::DrawAccid(DeviceContext *dc, LayerElement *element, Layer *layer, Sta
             x += note->GetDrawingRadius(m_doc);
         }
         TextExtend extend;
-        dc->SetFont(m_doc->GetDrawingSmuflFont(staff->m_drawingStaffSize, accid->GetDrawingCueSize()));
+        dc->SetFont(this->GetDrawingSmuflFont(staff->m_drawingStaffSize, accid->GetDrawingCueSize()));
         dc->GetSmuflTextExtent(accid->GetSymbolStr(notationType), &extend);
         dc->ResetFont();
         y = (accid->GetPlace() == STAFFREL_below) ? y - extend.m_ascent - unit : y + extend.m_descent + unit;
@@ -317,7 +317,7 @@ void View::DrawArtic(DeviceContext *dc, LayerElement *element, Layer *layer, Sta
 
     const bool drawingCueSize = artic->GetDrawingCueSize();
 
-    dc->SetFont(m_doc->GetDrawingSmuflFont(staff->m_drawingStaffSize, drawingCueSize));
+    dc->SetFont(this->GetDrawingSmuflFont(staff->m_drawingStaffSize, drawingCueSize));
 
     const data_ARTICULATION articValue = artic->GetArticFirst();
     const data_STAFFREL place = artic->GetDrawingPlace();
@@ -508,7 +508,7 @@ void View::DrawBTrem(DeviceContext *dc, LayerElement *element, Layer *layer, Sta
 
     // draw the (tuplet) number
     if (bTrem->HasNum() && (bTrem->GetNumVisible() != BOOLEAN_false)) {
-        dc->SetFont(m_doc->GetDrawingSmuflFont(staff->m_drawingStaffSize, false));
+        dc->SetFont(this->GetDrawingSmuflFont(staff->m_drawingStaffSize, false));
         // calculate the extend of the number
         TextExtend extend;
         const std::wstring figures = this->IntToTupletFigures(bTrem->GetNum());
@@ -949,9 +949,9 @@ void View::DrawKeySig(DeviceContext *dc, LayerElement *element, Layer *layer, St
         }
     }
 
-    dc->SetFont(m_doc->GetDrawingSmuflFont(staff->m_drawingStaffSize, false));
+    dc->SetFont(this->GetDrawingSmuflFont(staff->m_drawingStaffSize, false));
 
-    ListOfObjects childList = keySig->GetList(keySig);
+    ArrayOfObjects childList = keySig->GetList(keySig);
     for (Object *child : childList) {
         KeyAccid *keyAccid = vrv_cast<KeyAccid *>(child);
         assert(keyAccid);
@@ -1104,7 +1104,7 @@ void View::DrawMRpt(DeviceContext *dc, LayerElement *element, Layer *layer, Staf
     // draw the measure count
     const int mRptNum = mRpt->HasNum() ? mRpt->GetNum() : mRpt->m_drawingMeasureCount;
     if ((mRptNum > 0) && (mRpt->GetNumVisible() != BOOLEAN_false)) {
-        dc->SetFont(m_doc->GetDrawingSmuflFont(staff->m_drawingStaffSize, false));
+        dc->SetFont(this->GetDrawingSmuflFont(staff->m_drawingStaffSize, false));
         // calculate the extend of the number
         TextExtend extend;
         const std::wstring figures = this->IntToTupletFigures(mRptNum);
@@ -1262,7 +1262,7 @@ void View::DrawMultiRest(DeviceContext *dc, LayerElement *element, Layer *layer,
 
     // Draw the number
     if (multiRest->GetNumVisible() != BOOLEAN_false) {
-        dc->SetFont(m_doc->GetDrawingSmuflFont(staff->m_drawingStaffSize, false));
+        dc->SetFont(this->GetDrawingSmuflFont(staff->m_drawingStaffSize, false));
 
         const int staffHeight = (staff->m_drawingLines - 1) * m_doc->GetDrawingDoubleUnit(staff->m_drawingStaffSize);
         const int offset = 3 * m_doc->GetDrawingUnit(staff->m_drawingStaffSize);
@@ -1605,14 +1605,14 @@ void View::DrawSyl(DeviceContext *dc, LayerElement *element, Layer *layer, Staff
         return;
     }
 
-    syl->SetDrawingYRel(this->GetSylYRel(syl->m_drawingVerse, staff));
+    syl->SetDrawingYRel(this->GetSylYRel(dc, syl->m_drawingVerse, staff));
 
     dc->StartGraphic(syl, "", syl->GetID());
     dc->DeactivateGraphicY();
 
     dc->SetBrush(m_currentColour, AxSOLID);
 
-    FontInfo currentFont = *m_doc->GetDrawingLyricFont(staff->m_drawingStaffSize);
+    FontInfo currentFont = *this->GetDrawingLyricFont(staff->m_drawingStaffSize);
     if (syl->HasFontweight()) {
         currentFont.SetWeight(syl->GetFontweight());
     }
@@ -1700,7 +1700,7 @@ void View::DrawVerse(DeviceContext *dc, LayerElement *element, Layer *layer, Sta
         if (!dc->UseGlobalStyling()) {
             labelTxt.SetFaceName("Times");
         }
-        int pointSize = m_doc->GetDrawingLyricFont(staff->m_drawingStaffSize)->GetPointSize();
+        int pointSize = this->GetDrawingLyricFont(staff->m_drawingStaffSize)->GetPointSize();
         if (layerElement && layerElement->GetDrawingCueSize()) {
             pointSize = m_doc->GetCueSize(pointSize);
         }
@@ -1708,7 +1708,7 @@ void View::DrawVerse(DeviceContext *dc, LayerElement *element, Layer *layer, Sta
 
         TextDrawingParams params;
         params.m_x = verse->GetDrawingX() - m_doc->GetDrawingUnit(staff->m_drawingStaffSize);
-        params.m_y = staff->GetDrawingY() + this->GetSylYRel(std::max(1, verse->GetN()), staff);
+        params.m_y = staff->GetDrawingY() + this->GetSylYRel(dc, std::max(1, verse->GetN()), staff);
         params.m_pointSize = labelTxt.GetPointSize();
 
         dc->SetBrush(m_currentColour, AxSOLID);
@@ -1823,7 +1823,7 @@ int View::DrawMeterSigFigures(DeviceContext *dc, int x, int y, MeterSig *meterSi
 
     const int glyphSize = staff->GetDrawingStaffNotationSize();
 
-    dc->SetFont(m_doc->GetDrawingSmuflFont(glyphSize, false));
+    dc->SetFont(this->GetDrawingSmuflFont(glyphSize, false));
 
     std::wstring widthText = (timeSigCombNumerator.length() > timeSigCombDenominator.length()) ? timeSigCombNumerator
                                                                                                : timeSigCombDenominator;
@@ -1878,7 +1878,7 @@ void View::DrawMRptPart(DeviceContext *dc, int xCentered, wchar_t rptGlyph, int
     }
 
     if (num > 0) {
-        dc->SetFont(m_doc->GetDrawingSmuflFont(staffSize, false));
+        dc->SetFont(this->GetDrawingSmuflFont(staffSize, false));
         // calculate the width of the figures
         TextExtend extend;
         const std::wstring figures = this->IntToTimeSigFigures(num);
@@ -1896,8 +1896,9 @@ void View::DrawMRptPart(DeviceContext *dc, int xCentered, wchar_t rptGlyph, int
 // Calculation or preparation methods
 ///----------------------------------------------------------------------------
 
-int View::GetFYRel(F *f, Staff *staff)
+int View::GetFYRel(DeviceContext *dc, F *f, Staff *staff)
 {
+    assert(dc);
     assert(f && staff);
 
     int y = staff->GetDrawingY();
@@ -1919,25 +1920,26 @@ int View::GetFYRel(F *f, Staff *staff)
     int line = fb->GetDescendantIndex(f, FIGURE, UNLIMITED_DEPTH);
 
     if (line > 0) {
-        FontInfo *fFont = m_doc->GetDrawingLyricFont(staff->m_drawingStaffSize);
-        int lineHeight = m_doc->GetTextLineHeight(fFont, false);
+        FontInfo *fFont = this->GetDrawingLyricFont(staff->m_drawingStaffSize);
+        int lineHeight = m_doc->GetTextLineHeight(fFont, false, dc->GetResources());
         y -= (line * lineHeight);
     }
 
     return y;
 }
 
-int View::GetSylYRel(int verseN, Staff *staff)
+int View::GetSylYRel(DeviceContext *dc, int verseN, Staff *staff)
 {
+    assert(dc);
     assert(staff);
 
     const bool verseCollapse = m_options->m_lyricVerseCollapse.GetValue();
     int y = 0;
     StaffAlignment *alignment = staff->GetAlignment();
     if (alignment) {
-        FontInfo *lyricFont = m_doc->GetDrawingLyricFont(staff->m_drawingStaffSize);
-        int descender = -m_doc->GetTextGlyphDescender(L'q', lyricFont, false);
-        int height = m_doc->GetTextGlyphHeight(L'I', lyricFont, false);
+        FontInfo *lyricFont = this->GetDrawingLyricFont(staff->m_drawingStaffSize);
+        int descender = -m_doc->GetTextGlyphDescender(L'q', lyricFont, false, dc->GetResources());
+        int height = m_doc->GetTextGlyphHeight(L'I', lyricFont, false, dc->GetResources());
         int margin = m_doc->GetBottomMargin(SYL) * m_doc->GetDrawingUnit(staff->m_drawingStaffSize);
 
         y = -alignment->GetStaffHeight() - alignment->GetOverflowBelow()
@@ -295,7 +295,7 @@ void View::DrawSmuflCode(DeviceContext *dc, int x, int y, wchar_t code, int staf
     str.push_back(code);
 
     dc->SetBrush(m_currentColour, AxSOLID);
-    dc->SetFont(m_doc->GetDrawingSmuflFont(staffSize, dimin));
+    dc->SetFont(this->GetDrawingSmuflFont(staffSize, dimin));
 
     dc->DrawMusicText(str, ToDeviceContextX(x), ToDeviceContextY(y), setBBGlyph);
 
@@ -322,7 +322,7 @@ void View::DrawSmuflLine(
     const int count = (length + fillWidth / 2 - startWidth - endWidth) / fillWidth;
 
     dc->SetBrush(m_currentColour, AxSOLID);
-    dc->SetFont(m_doc->GetDrawingSmuflFont(staffSize, dimin));
+    dc->SetFont(this->GetDrawingSmuflFont(staffSize, dimin));
 
     std::wstring str;
 
@@ -352,7 +352,7 @@ void View::DrawSmuflString(DeviceContext *dc, int x, int y, std::wstring s, data
     int xDC = ToDeviceContextX(x);
 
     dc->SetBrush(m_currentColour, AxSOLID);
-    dc->SetFont(m_doc->GetDrawingSmuflFont(staffSize, dimin));
+    dc->SetFont(this->GetDrawingSmuflFont(staffSize, dimin));
 
     if (alignment == HORIZONTALALIGNMENT_center) {
         TextExtend extend;
@@ -330,7 +330,7 @@ void View::DrawLigature(DeviceContext *dc, LayerElement *element, Layer *layer,
 
     // Render a bracket for the ligature
     if (m_options->m_ligatureAsBracket.GetValue()) {
-        const ListOfObjects &notes = ligature->GetList(ligature);
+        const ArrayOfObjects &notes = ligature->GetList(ligature);
 
         if (notes.size() > 0) {
             int y = staff->GetDrawingY();
@@ -578,7 +578,7 @@ void View::DrawProportFigures(DeviceContext *dc, int x, int y, int num, int numB
         x += m_doc->GetDrawingUnit(textSize) * 2;
     }
 
-    dc->SetFont(m_doc->GetDrawingSmuflFont(textSize, false));
+    dc->SetFont(this->GetDrawingSmuflFont(textSize, false));
 
     wtext = IntToTimeSigFigures(num);
     this->DrawSmuflString(dc, x, ynum, wtext, HORIZONTALALIGNMENT_center, textSize); // true = center
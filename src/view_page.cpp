@@ -66,7 +66,11 @@ void View::DrawCurrentPage(DeviceContext *dc, bool background)
     const bool dcHasResources = dc->HasResources();
     if (!dcHasResources) dc->SetResources(&m_doc->GetResources());
 
-    m_currentPage = m_doc->SetDrawingPage(m_pageIdx);
+    // Start with the default text font, since the one selected last is kept by the resources
+    dc->GetResources()->SelectTextFont(FONTWEIGHT_NONE, FONTSTYLE_NONE);
+
+    // When drawing concurrently, the drawing page of the doc is not changed
+    if (!m_sharedDrawingMutex) m_currentPage = m_doc->SetDrawingPage(m_pageIdx);
 
     // Keep the width of the initial scoreDef
     SetScoreDefDrawingWidth(dc, &m_currentPage->m_drawingScoreDef);
@@ -76,7 +80,7 @@ void View::DrawCurrentPage(DeviceContext *dc, bool background)
     m_drawingScoreDef = m_currentPage->m_drawingScoreDef;
 
     if (m_options->m_shrinkToFit.GetValue()) {
-        dc->SetContentHeight(m_doc->GetAdjustedDrawingPageHeight());
+        dc->SetContentHeight(m_doc->GetAdjustedDrawingPageHeight(m_currentPage));
     }
     else {
         dc->SetContentHeight(dc->GetHeight());
@@ -133,8 +137,8 @@ void View::SetScoreDefDrawingWidth(DeviceContext *dc, ScoreDef *scoreDef)
     }
 
     // longest key signature of the staffDefs
-    const ListOfObjects &scoreDefList = scoreDef->GetList(scoreDef); // make sure it's initialized
-    for (ListOfObjects::const_iterator it = scoreDefList.begin(); it != scoreDefList.end(); ++it) {
+    const ArrayOfObjects &scoreDefList = scoreDef->GetList(scoreDef); // make sure it's initialized
+    for (ArrayOfObjects::const_iterator it = scoreDefList.begin(); it != scoreDefList.end(); ++it) {
         StaffDef *staffDef = vrv_cast<StaffDef *>(*it);
         assert(staffDef);
         if (!staffDef->HasKeySigInfo()) continue;
@@ -499,7 +503,7 @@ void View::DrawLayerDefLabels(
     const int yCenter
         = staff->GetDrawingY() - (staffDef->GetLines() * m_doc->GetDrawingDoubleUnit(staff->m_drawingStaffSize) / 2);
     const int staffSize = staff->GetDrawingStaffNotationSize();
-    const int pointSize = m_doc->GetDrawingLyricFont(staffSize)->GetPointSize();
+    const int pointSize = this->GetDrawingLyricFont(staffSize)->GetPointSize();
     const int layerDefCount = staffDef->GetChildCount(LAYERDEF);
     const int requiredSpace = pointSize * layerDefCount;
 
@@ -547,11 +551,11 @@ void View::DrawLabels(
     if (!dc->UseGlobalStyling()) {
         labelTxt.SetFaceName("Times");
     }
-    labelTxt.SetPointSize(m_doc->GetDrawingLyricFont(staffSize)->GetPointSize());
+    labelTxt.SetPointSize(this->GetDrawingLyricFont(staffSize)->GetPointSize());
 
     int lineCount = graphic->GetChildCount(LB) + 1;
     if (lineCount > 1) {
-        y += (m_doc->GetTextLineHeight(&labelTxt, false) * (lineCount - 1) / 2);
+        y += (m_doc->GetTextLineHeight(&labelTxt, false, dc->GetResources()) * (lineCount - 1) / 2);
     }
 
     TextDrawingParams params;
@@ -632,7 +636,7 @@ void View::DrawBrace(DeviceContext *dc, int x, int y1, int y2, int staffSize)
     x -= basicDist;
 
     if (m_doc->GetOptions()->m_useBraceGlyph.GetValue()) {
-        FontInfo *font = m_doc->GetDrawingSmuflFont(staffSize, false);
+        FontInfo *font = this->GetDrawingSmuflFont(staffSize, false);
         const int width = m_doc->GetGlyphWidth(SMUFL_E000_brace, staffSize, false);
         const int height = 8 * m_doc->GetDrawingUnit(staffSize);
         const float scale = static_cast<float>(y1 - y2) / height;
@@ -901,7 +905,7 @@ void View::DrawBarLine(DeviceContext *dc, int yTop, int yBottom, BarLine *barLin
                 maxX = x2 + barLineWidth / 2;
             }
             Object lines;
-            lines.SetParent(system);
+            lines.SetTemporaryParent(system);
             lines.UpdateContentBBoxX(minX, maxX);
             lines.UpdateContentBBoxY(yTop, yBottom);
             int margin = unit / 2;
@@ -1045,7 +1049,7 @@ void View::DrawMeasure(DeviceContext *dc, Measure *measure, System *system)
                         += m_doc->GetGlyphHeight(SMUFL_E003_bracketTop, 100, false) + m_doc->GetDrawingUnit(100) / 6;
                 }
                 // hardcoded offset for the mNum based on the lyric font size
-                const int yOffset = m_doc->GetDrawingLyricFont(60)->GetPointSize();
+                const int yOffset = this->GetDrawingLyricFont(60)->GetPointSize();
                 this->DrawMNum(dc, mnum, measure, std::max(symbolOffset, yOffset));
             }
         }
@@ -1083,7 +1087,7 @@ void View::DrawMeterSigGrp(DeviceContext *dc, Layer *layer, Staff *staff)
     assert(staff);
 
     MeterSigGrp *meterSigGrp = layer->GetStaffDefMeterSigGrp();
-    const ListOfObjects &childList = meterSigGrp->GetList(meterSigGrp);
+    const ArrayOfObjects &childList = meterSigGrp->GetList(meterSigGrp);
 
     const int glyphSize = staff->GetDrawingStaffNotationSize();
 
@@ -1150,14 +1154,14 @@ void View::DrawMNum(DeviceContext *dc, MNum *mnum, Measure *measure, int yOffset
             }
             else if (fs->GetType() == FONTSIZE_term) {
                 const int percent = fs->GetPercentForTerm();
-                mnumTxt.SetPointSize(m_doc->GetDrawingLyricFont(percent)->GetPointSize());
+                mnumTxt.SetPointSize(this->GetDrawingLyricFont(percent)->GetPointSize());
             }
             else if (fs->GetType() == FONTSIZE_percent) {
-                mnumTxt.SetPointSize(m_doc->GetDrawingLyricFont(fs->GetPercent())->GetPointSize());
+                mnumTxt.SetPointSize(this->GetDrawingLyricFont(fs->GetPercent())->GetPointSize());
             }
         }
         else {
-            mnumTxt.SetPointSize(m_doc->GetDrawingLyricFont(80)->GetPointSize());
+            mnumTxt.SetPointSize(this->GetDrawingLyricFont(80)->GetPointSize());
         }
 
         dc->SetBrush(m_currentColour, AxSOLID);
@@ -1269,7 +1273,7 @@ void View::DrawStaffLines(DeviceContext *dc, Staff *staff, Measure *measure, Sys
             // Italian tablature
             if (!dc->Is(BBOX_DEVICE_CONTEXT) && staff->IsTablature() && !isFrenchOrItalianTablature) {
                 Object fullLine;
-                fullLine.SetParent(system);
+                fullLine.SetTemporaryParent(system);
                 fullLine.UpdateContentBBoxY(y1 + (lineWidth / 2), y1 - (lineWidth / 2));
                 fullLine.UpdateContentBBoxX(x1, x2);
                 int margin = m_doc->GetDrawingUnit(100) / 2;
@@ -37,6 +37,12 @@ void View::DrawRunningElements(DeviceContext *dc, Page *page)
         if (!bBoxDC->UpdateVerticalValues()) return;
     }
 
+    // Running elements are shared between pages and need to be set to the page when drawing concurrently
+    std::unique_lock<std::mutex> lock;
+    if (m_sharedDrawingMutex) lock = std::unique_lock<std::mutex>(*m_sharedDrawingMutex);
+
+    if (m_sharedDrawingMutex) page->SetRunningElementsDrawingPage();
+
     RunningElement *header = page->GetHeader();
     if (header) {
         this->DrawPgHeader(dc, header);
@@ -64,7 +70,7 @@ void View::DrawPgHeader(DeviceContext *dc, RunningElement *pgHeader)
     params.m_width = pgHeader->GetWidth();
     params.m_alignment = HORIZONTALALIGNMENT_NONE;
     params.m_laidOut = true;
-    params.m_pointSize = m_doc->GetDrawingLyricFont(100)->GetPointSize();
+    params.m_pointSize = this->GetDrawingLyricFont(100)->GetPointSize();
 
     pgHeadTxt.SetPointSize(params.m_pointSize);
 
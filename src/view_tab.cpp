@@ -116,13 +116,13 @@ void View::DrawTabNote(DeviceContext *dc, LayerElement *element, Layer *layer, S
         TextDrawingParams params;
         params.m_x = x;
         params.m_y = y;
-        params.m_pointSize = m_doc->GetDrawingLyricFont(glyphSize)->GetPointSize() * 4 / 5;
+        params.m_pointSize = this->GetDrawingLyricFont(glyphSize)->GetPointSize() * 4 / 5;
         fretTxt.SetPointSize(params.m_pointSize);
 
         dc->SetBrush(m_currentColour, AxSOLID);
         dc->SetFont(&fretTxt);
 
-        params.m_y -= (m_doc->GetTextGlyphHeight(L'0', &fretTxt, drawingCueSize) / 2);
+        params.m_y -= (m_doc->GetTextGlyphHeight(L'0', &fretTxt, drawingCueSize, dc->GetResources()) / 2);
 
         dc->StartText(ToDeviceContextX(params.m_x), ToDeviceContextY(params.m_y), HORIZONTALALIGNMENT_center);
         this->DrawTextString(dc, fret, params);
@@ -143,7 +143,7 @@ void View::DrawTabNote(DeviceContext *dc, LayerElement *element, Layer *layer, S
                 - m_doc->GetDrawingStaffLineWidth(staff->m_drawingStaffSize);
         }
 
-        dc->SetFont(m_doc->GetDrawingSmuflFont(glyphSize, false));
+        dc->SetFont(this->GetDrawingSmuflFont(glyphSize, false));
         this->DrawSmuflString(dc, x, y, fret, HORIZONTALALIGNMENT_center, glyphSize);
         dc->ResetFont();
     }
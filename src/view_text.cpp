@@ -265,7 +265,7 @@ void View::DrawLb(DeviceContext *dc, Lb *lb, TextDrawingParams &params)
 
     FontInfo *currentFont = dc->GetFont();
 
-    params.m_y -= m_doc->GetTextLineHeight(currentFont, false);
+    params.m_y -= m_doc->GetTextLineHeight(currentFont, false, dc->GetResources());
     params.m_explicitPosition = true;
 
     dc->EndTextGraphic(lb, this);
@@ -349,9 +349,9 @@ void View::DrawRend(DeviceContext *dc, Rend *rend, TextDrawingParams &params)
     int yShift = 0;
     if ((rend->GetRend() == TEXTRENDITION_sup) || (rend->GetRend() == TEXTRENDITION_sub)) {
         assert(dc->GetFont());
-        int MHeight = m_doc->GetTextGlyphHeight('M', dc->GetFont(), false);
+        int MHeight = m_doc->GetTextGlyphHeight('M', dc->GetFont(), false, dc->GetResources());
         if (rend->GetRend() == TEXTRENDITION_sup) {
-            yShift += m_doc->GetTextGlyphHeight('o', dc->GetFont(), false);
+            yShift += m_doc->GetTextGlyphHeight('o', dc->GetFont(), false, dc->GetResources());
             yShift += (MHeight * SUPER_SCRIPT_POSITION);
         }
         else {
@@ -171,7 +171,7 @@ void View::DrawTupletNum(DeviceContext *dc, LayerElement *element, Layer *layer,
 
     const bool drawingCueSize = tuplet->GetDrawingCueSize();
     const int glyphSize = staff->GetDrawingStaffNotationSize();
-    dc->SetFont(m_doc->GetDrawingSmuflFont(glyphSize, drawingCueSize));
+    dc->SetFont(this->GetDrawingSmuflFont(glyphSize, drawingCueSize));
     notes = IntToTupletFigures((short int)tuplet->GetNum());
     if (tuplet->GetNumFormat() == tupletVis_NUMFORMAT_ratio) {
         notes.push_back(SMUFL_E88A_tupletColon);
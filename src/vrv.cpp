@@ -9,22 +9,32 @@
 
 //----------------------------------------------------------------------------
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <codecvt>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <locale>
+#include <mutex>
 #include <sstream>
 #include <stdarg.h>
 #include <stdio.h>
+#include <thread>
 #include <vector>
 
 #ifndef _WIN32
 #include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #else
 #include "win_dirent.h"
 #include "win_time.h"
+#include <sys/stat.h>
 #endif
 
 //----------------------------------------------------------------------------
@@ -72,6 +82,9 @@ bool loggingToBuffer = false;
 
 std::vector<std::string> logBuffer;
 
+/** For logging from several threads */
+std::mutex logMutex;
+
 void LogElapsedTimeStart()
 {
     gettimeofday(&start, NULL);
@@ -149,8 +162,10 @@ void EnableLogToBuffer(bool value)
 
 void LogString(std::string message, consoleLogLevel level)
 {
+    const std::lock_guard<std::mutex> lock(logMutex);
+
     if (loggingToBuffer) {
-        if (LogBufferContains(message)) return;
+        if (std::find(logBuffer.begin(), logBuffer.end(), message) != logBuffer.end()) return;
         logBuffer.push_back(message);
     }
     else {
@@ -178,6 +193,8 @@ void LogString(std::string message, consoleLogLevel level)
 
 bool LogBufferContains(const std::string &s)
 {
+    const std::lock_guard<std::mutex> lock(logMutex);
+
     std::vector<std::string>::iterator iter = logBuffer.begin();
     while (iter != logBuffer.end()) {
         if ((*iter) == s) return true;
@@ -192,6 +209,29 @@ bool Check(Object *object)
     return (object != NULL);
 }
 
+void RunInParallel(int count, int threadCount, const std::function<void(int)> &task)
+{
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    threadCount = 1;
+#endif
+    threadCount = std::min(threadCount, count);
+
+    if (threadCount <= 1) {
+        for (int i = 0; i < count; ++i) task(i);
+        return;
+    }
+
+    std::atomic<int> next(0);
+    auto worker = [&next, count, &task]() {
+        for (int i = next++; i < count; i = next++) task(i);
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < threadCount; ++i) threads.emplace_back(worker);
+    worker();
+    for (std::thread &thread : threads) thread.join();
+}
+
 //----------------------------------------------------------------------------
 // Various helpers
 //----------------------------------------------------------------------------
@@ -261,6 +301,16 @@ std::string GetFilename(std::string &fullpath)
     return name;
 }
 
+bool GetFileInfo(const std::string &filename, size_t &size, time_t &modificationTime)
+{
+    struct stat fileStat;
+    if (stat(filename.c_str(), &fileStat) != 0) return false;
+
+    size = fileStat.st_size;
+    modificationTime = fileStat.st_mtime;
+    return true;
+}
+
 std::string GetVersion()
 {
     std::string dev;
@@ -268,6 +318,75 @@ std::string GetVersion()
     return StringFormat("%d.%d.%d%s-%s", VERSION_MAJOR, VERSION_MINOR, VERSION_REVISION, dev.c_str(), GIT_COMMIT);
 }
 
+//----------------------------------------------------------------------------
+// MappedFile
+//----------------------------------------------------------------------------
+
+MappedFile::MappedFile()
+{
+    m_data = NULL;
+    m_size = 0;
+}
+
+MappedFile::~MappedFile()
+{
+    this->Close();
+}
+
+bool MappedFile::Open(const std::string &filename)
+{
+    this->Close();
+
+#ifndef _WIN32
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) return false;
+
+    struct stat fileStat;
+    if ((fstat(fd, &fileStat) == -1) || (fileStat.st_size <= 0)) {
+        close(fd);
+        return false;
+    }
+
+    void *data = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping remains valid after the file descriptor is closed
+    close(fd);
+    if (data == MAP_FAILED) return false;
+
+    m_data = static_cast<char *>(data);
+    m_size = fileStat.st_size;
+#else
+    std::ifstream file(filename.c_str(), std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return false;
+
+    const std::streamsize size = file.tellg();
+    if (size <= 0) return false;
+
+    m_buffer.resize(size);
+    file.seekg(0, std::ios::beg);
+    if (!file.read(m_buffer.data(), size)) {
+        m_buffer.clear();
+        return false;
+    }
+
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+#endif
+
+    return true;
+}
+
+void MappedFile::Close()
+{
+#ifndef _WIN32
+    if (m_data) munmap(m_data, m_size);
+#else
+    m_buffer.clear();
+#endif
+
+    m_data = NULL;
+    m_size = 0;
+}
+
 static const std::string base62Chars = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
 
 std::string BaseEncodeInt(unsigned int value, unsigned int base)
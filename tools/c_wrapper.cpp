@@ -84,6 +84,13 @@ const char *vrvToolkit_getElementsAtTime(void *tkPtr, int millisec)
     return tk->GetCString();
 }
 
+const char *vrvToolkit_getTimeEventsBetween(void *tkPtr, int fromMillisec, int toMillisec)
+{
+    Toolkit *tk = static_cast<Toolkit *>(tkPtr);
+    tk->SetCString(tk->GetTimeEventsBetween(fromMillisec, toMillisec));
+    return tk->GetCString();
+}
+
 const char *vrvToolkit_getExpansionIdsForElement(void *tkPtr, const char *xmlId)
 {
     Toolkit *tk = static_cast<Toolkit *>(tkPtr);
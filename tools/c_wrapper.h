@@ -22,6 +22,7 @@ const char *vrvToolkit_getAvailableOptions(void *tkPtr);
 const char *vrvToolkit_getDescriptiveFeatures(void *tkPtr, const char *options);
 const char *vrvToolkit_getElementAttr(void *tkPtr, const char *xmlId);
 const char *vrvToolkit_getElementsAtTime(void *tkPtr, int millisec);
+const char *vrvToolkit_getTimeEventsBetween(void *tkPtr, int fromMillisec, int toMillisec);
 const char *vrvToolkit_getExpansionIdsForElement(void *tkPtr, const char *xmlId);
 const char *vrvToolkit_getHumdrum(void *tkPtr);
 const char *vrvToolkit_convertHumdrumToHumdrum(void *tkPtr, const char *humdrumData);
@@ -5,6 +5,7 @@
 // Copyright (c) Authors and others. All rights reserved.
 /////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <cassert>
 #include <fstream>
 #include <iostream>
@@ -241,6 +242,7 @@ int main(int argc, char **argv)
     std::string svgdir;
     std::string outfile;
     std::string outformat = "svg";
+    std::string records;
     bool std_output = false;
 
     int all_pages = 0;
@@ -261,6 +263,7 @@ int main(int argc, char **argv)
         { "resources", required_argument, 0, 'r' }, //
         { "scale", required_argument, 0, 's' }, //
         { "output-to", required_argument, 0, 't' }, //
+        { "records", required_argument, 0, 'R' }, //
         { "version", no_argument, 0, 'v' }, //
         { "xml-id-seed", required_argument, 0, 'x' }, //
         // standard input - long options only or - as filename
@@ -367,6 +370,14 @@ int main(int argc, char **argv)
 
             case 'r': resourcePath = optarg; break;
 
+            case 'R':
+                records = std::string(optarg);
+                if ((records != "line") && (records != "block")) {
+                    std::cerr << "Records (" << records << ") can only be 'line' or 'block'." << std::endl;
+                    exit(1);
+                }
+                break;
+
             case 't':
                 outformat = std::string(optarg);
                 toolkit.SetOutputTo(std::string(optarg));
@@ -477,6 +488,68 @@ int main(int argc, char **argv)
         outfile = removeExtension(outfile);
     }
 
+    // Render each record of the input to its own SVG file
+    if (!records.empty()) {
+        if (outformat != "svg") {
+            std::cerr << "Records can only be rendered to SVG." << std::endl;
+            exit(1);
+        }
+        std::ifstream instream;
+        if (infile != "-") {
+            instream.open(infile.c_str());
+            if (!instream.is_open()) {
+                std::cerr << "The file '" << infile << "' could not be opened." << std::endl;
+                exit(1);
+            }
+        }
+        std::istream &input = (infile == "-") ? std::cin : instream;
+
+        // With blocks, consecutive non-empty lines make one record
+        std::vector<std::string> recordData;
+        std::string record;
+        for (std::string line; getline(input, line);) {
+            if (!line.empty() && (line.back() == '\r')) line.pop_back();
+            if (line.empty()) {
+                if (!record.empty()) recordData.push_back(record);
+                record.clear();
+            }
+            else if (records == "line") {
+                recordData.push_back(line);
+            }
+            else {
+                record += line + "\n";
+            }
+        }
+        if (!record.empty()) recordData.push_back(record);
+
+        std::vector<std::string> svgRecords = toolkit.RenderRecordsToSVG(recordData, !std_output);
+        for (int r = 0; r < (int)svgRecords.size(); ++r) {
+            if (svgRecords.at(r).empty()) continue;
+            if (std_output) {
+                std::cout << svgRecords.at(r);
+                continue;
+            }
+            std::string cur_outfile = outfile + vrv::StringFormat("_%03d", r + 1) + ".svg";
+            std::ofstream outstream(cur_outfile.c_str());
+            if (!outstream.is_open()) {
+                std::cerr << "Unable to write SVG to " << cur_outfile << "." << std::endl;
+                exit(1);
+            }
+            outstream << svgRecords.at(r);
+            outstream.close();
+        }
+        if (!std_output) {
+            std::cerr << "Output written to " << outfile << "_*.svg (" << svgRecords.size() << " records)." << std::endl;
+        }
+
+        if (options->m_showRuntime.GetValue()) {
+            toolkit.LogRuntime();
+        }
+
+        free(long_options);
+        return 0;
+    }
+
     // Skip the layout for MIDI and timemap output
     if ((outformat == "midi") || (outformat == "timemap")) {
         toolkit.SkipLayoutOnLoad(true);
@@ -522,22 +595,40 @@ int main(int argc, char **argv)
     }
 
     if (outformat == "svg") {
-        int p;
-        for (p = from; p < to; ++p) {
-            std::string cur_outfile = outfile;
-            if (all_pages) {
-                cur_outfile += vrv::StringFormat("_%03d", p);
-            }
-            cur_outfile += ".svg";
-            if (std_output) {
-                std::cout << toolkit.RenderToSVG(p);
-            }
-            else if (!toolkit.RenderToSVGFile(cur_outfile, p)) {
-                std::cerr << "Unable to write SVG to " << cur_outfile << "." << std::endl;
-                exit(1);
-            }
-            else {
-                std::cerr << "Output written to " << cur_outfile << "." << std::endl;
+        // With several render threads, the pages are rendered concurrently by batches of one page per thread and
+        // each batch is written before the next one is rendered. With one thread, the pages are rendered one by one.
+        const int batchSize = options->m_renderThreads.GetValue();
+        for (int first = from; first < to; first += batchSize) {
+            const int last = std::min(first + batchSize, to) - 1;
+            std::vector<std::string> svgPages;
+            if (batchSize > 1) svgPages = toolkit.RenderPagesToSVG(first, last, !std_output);
+            int p;
+            for (p = first; p <= last; ++p) {
+                std::string cur_outfile = outfile;
+                if (all_pages) {
+                    cur_outfile += vrv::StringFormat("_%03d", p);
+                }
+                cur_outfile += ".svg";
+                if (std_output) {
+                    std::cout << ((batchSize > 1) ? svgPages.at(p - first) : toolkit.RenderToSVG(p));
+                }
+                else if (batchSize > 1) {
+                    std::ofstream outstream(cur_outfile.c_str());
+                    if (!outstream.is_open()) {
+                        std::cerr << "Unable to write SVG to " << cur_outfile << "." << std::endl;
+                        exit(1);
+                    }
+                    outstream << svgPages.at(p - first);
+                    outstream.close();
+                    std::cerr << "Output written to " << cur_outfile << "." << std::endl;
+                }
+                else if (!toolkit.RenderToSVGFile(cur_outfile, p)) {
+                    std::cerr << "Unable to write SVG to " << cur_outfile << "." << std::endl;
+                    exit(1);
+                }
+                else {
+                    std::cerr << "Output written to " << cur_outfile << "." << std::endl;
+                }
             }
         }
     }